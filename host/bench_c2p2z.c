@@ -0,0 +1,274 @@
+/*
+ * File:   bench_c2p2z.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 10:05 AM
+ * 
+ * Throughput benchmark and regression vector generator of the host model of the 
+ * 2P2Z compensator (firmware src/c2p2z.c + host translation of src/c2p2z_asm.s)
+ * 
+ * Usage: bench_c2p2z [-n samples] [-b block_size] [-d vector_file.csv] [-c expected_checksum]
+ * 
+ *    -n  number of samples pushed through c2p2z_Update (default 10000000)
+ *    -b  additionally run c2p2z_UpdateBlock with the given block size, verify its outputs
+ *        against the sequential calls and report its throughput
+ *    -d  dump the first 65536 input/output vectors as CSV for comparison against 
+ *        MPLAB X simulator or on-target captures
+ *    -c  expected FNV-1a checksum over all outputs and status words; 
+ *        the program returns 1 if the computed checksum differs
+ * 
+ * The controller is configured like the voltage loop of the device (options of globals.h):
+ * transient boost enabled, clamped outputs hard-limited. bench_c2p2z_backcalc is built with
+ * -DUSE_SOFT_DESATURATION=true, which adds the back-calculation to the kernels and runs it 
+ * at a gain of 1.0. Each build has its own reference checksum (see readme.txt).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "globals.h"
+#include "c2p2z.h"
+#include "dsp_engine.h"
+
+#define BENCH_DEFAULT_SAMPLES   10000000UL
+#define BENCH_DUMP_SAMPLES      65536UL
+#define BENCH_MAX_BLOCK_SIZE    65535UL
+
+#define BENCH_REFERENCE         2755    // ADC ticks of 15 V at the output divider (see V_OUT_REF)
+#define BENCH_MIN_OUTPUT        806     // DAC ticks of 0.65 V (see DAC_MIN)
+#define BENCH_MAX_OUTPUT        3847    // DAC ticks of 3.10 V (see DAC_MAX)
+#define BENCH_TRIGGER_OFFSET    680     // ADC trigger offset (see VOUT_ADCTRIG)
+#define BENCH_BOOST_BAND        5       // transient boost band of 30 mV in ADC ticks (see BOOST_BAND)
+#define BENCH_BOOST_GAIN        131072UL // transient boost gain of 4 DAC ticks per ADC tick (see BOOST_GAIN)
+#define BENCH_BACK_CALC         0x7FFF  // back-calculation gain of 1.0 (see SOFT_DESAT_GAIN)
+
+volatile uint16_t bench_source = 0;     // stand-in of ADCBUF16
+volatile uint16_t bench_target = 0;     // stand-in of DAC1DATH
+volatile uint16_t bench_reference = BENCH_REFERENCE;
+volatile uint16_t bench_trigger = 0;    // stand-in of PG2TRIGA
+
+static uint32_t lcg_state = 0x12345678;
+
+/*!bench_stimulus
+ * *************************************************************************************************
+ * Deterministic feedback signal: a slowly moving square wave around the reference with 
+ * superimposed pseudo-random noise. Step amplitudes drive the compensator into both 
+ * saturation limits, noise exercises rounding of small results.
+ * *************************************************************************************************/
+static inline uint16_t bench_stimulus(uint32_t n)
+{
+    int32_t value;
+    
+    lcg_state = lcg_state * 1664525UL + 1013904223UL;
+    
+    switch ((n >> 12) & 0x03) {
+        case 0:  value = BENCH_REFERENCE - 800; break;
+        case 1:  value = BENCH_REFERENCE; break;
+        case 2:  value = BENCH_REFERENCE + 600; break;
+        default: value = BENCH_REFERENCE - 20; break;
+    }
+    value += (int32_t)((lcg_state >> 24) & 0x3F) - 32;
+    
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    
+    return((uint16_t)value);
+}
+
+static inline uint32_t fnv1a_16(uint32_t hash, uint16_t data)
+{
+    hash = (hash ^ (data & 0xFF)) * 16777619UL;
+    hash = (hash ^ (data >> 8)) * 16777619UL;
+    return(hash);
+}
+
+/*!bench_selftest
+ * *************************************************************************************************
+ * Known-answer checks of the DSP engine corner cases the compensator relies on
+ * *************************************************************************************************/
+static int bench_selftest(void)
+{
+    int fails = 0;
+    
+    CORCON = 0x00E4;
+    
+    // (-1.0) x (-1.0) saturates to 0x7FFFFFFF in normal saturation mode
+    if (dsp_mpy((int16_t)0x8000, (int16_t)0x8000) != 0x7FFFFFFFLL) fails++;
+    // convergent rounding: ties round to even
+    if (dsp_sac_r(0x00018000LL) != 0x0002) fails++;
+    if (dsp_sac_r(0x00028000LL) != 0x0002) fails++;
+    if (dsp_sac_r(0x00028001LL) != 0x0003) fails++;
+    // data space write saturation
+    if (dsp_sac_r(0x7FFFFFFFLL) != 0x7FFF) fails++;
+    if (dsp_sac_r(-0x80000000LL) != (int16_t)0x8000) fails++;
+    // accumulator saturation on MAC
+    if (dsp_mac(0x7FFF0000LL, 0x4000, 0x4000) != 0x7FFFFFFFLL) fails++;
+    // left shift saturates, right shift is arithmetic
+    if (dsp_sftac(0x40000000LL, -2) != 0x7FFFFFFFLL) fails++;
+    if (dsp_sftac(-0x40000000LL, 2) != -0x10000000LL) fails++;
+    
+    if (fails) 
+        fprintf(stderr, "DSP engine self-test: %d check(s) failed\n", fails);
+    
+    return(fails);
+}
+
+/*!bench_controller_init
+ * *************************************************************************************************
+ * Initializes the controller the same way init_pwr_control() does
+ * *************************************************************************************************/
+static void bench_controller_init(void)
+{
+    c2p2z_Init();
+    c2p2z.ptrSource = &bench_source;
+    c2p2z.ptrTarget = &bench_target;
+    c2p2z.ptrControlReference = &bench_reference;
+    c2p2z.ptrADCTriggerRegister = &bench_trigger;
+    c2p2z.ADCTriggerOffset = BENCH_TRIGGER_OFFSET;
+    c2p2z.InputOffset = 0;
+    c2p2z.MinOutput = BENCH_MIN_OUTPUT;
+    c2p2z.MaxOutput = BENCH_MAX_OUTPUT;
+    c2p2z.BoostBand = (BENCH_BOOST_BAND << c2p2z.normPreShift);
+    c2p2z.BoostGain = (fractional)(BENCH_BOOST_GAIN >> c2p2z.normPreShift);
+    #if (USE_SOFT_DESATURATION == true)
+    c2p2z.BackCalcGain = npnz16b_BackCalcGain(&c2p2z, BENCH_BACK_CALC);
+    #endif
+    c2p2z.status.bits.enable = 1;
+    
+    bench_target = 0;
+    bench_trigger = 0;
+}
+
+static double bench_elapsed(struct timespec* t0, struct timespec* t1)
+{
+    return((double)(t1->tv_sec - t0->tv_sec) + (double)(t1->tv_nsec - t0->tv_nsec) * 1.0e-9);
+}
+
+static void bench_report(const char* name, uint32_t samples, double elapsed)
+{
+    printf("%s: %u samples in %.3f s (%.2f Msamples/s, %.1f ns/sample)\n", 
+        name, samples, elapsed, (elapsed > 0.0) ? (samples / elapsed * 1.0e-6) : 0.0,
+        (samples > 0) ? (elapsed * 1.0e9 / samples) : 0.0);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t samples = BENCH_DEFAULT_SAMPLES;
+    uint32_t block_size = 0;
+    uint32_t expected = 0;
+    int check = 0;
+    const char* dump_file = NULL;
+    FILE* dump = NULL;
+    uint32_t n, chunk, hash = 2166136261UL;
+    uint16_t *input, *output, *block_output;
+    uint16_t seq_status, seq_target, seq_trigger;
+    struct timespec t0, t1;
+    int i, result = 0;
+    
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) 
+            samples = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc)) 
+            block_size = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc)) 
+            dump_file = argv[++i];
+        else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) 
+            { expected = strtoul(argv[++i], NULL, 0); check = 1; }
+        else {
+            fprintf(stderr, "usage: %s [-n samples] [-b block_size] [-d vector_file.csv] [-c expected_checksum]\n", argv[0]);
+            return(2);
+        }
+    }
+    
+    if (bench_selftest()) 
+        return(1);
+    
+    if (block_size > BENCH_MAX_BLOCK_SIZE) 
+        block_size = BENCH_MAX_BLOCK_SIZE;
+    
+    input = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    output = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    block_output = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    if ((input == NULL) || (output == NULL) || (block_output == NULL)) {
+        fprintf(stderr, "out of memory\n");
+        return(2);
+    }
+    
+    for (n = 0; n < samples; n++)
+        input[n] = bench_stimulus(n);
+    
+    // Sequential execution: one c2p2z_Update() call per sample
+    bench_controller_init();
+    
+    if (dump_file != NULL) {
+        dump = fopen(dump_file, "w");
+        if (dump == NULL) { perror(dump_file); return(2); }
+        fprintf(dump, "n,input,reference,output,status,trigger\n");
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    
+    for (n = 0; n < samples; n++) {
+        bench_source = input[n];
+        c2p2z_Update(&c2p2z);
+        output[n] = bench_target;
+        hash = fnv1a_16(hash, bench_target);
+        hash = fnv1a_16(hash, c2p2z.status.value);
+        
+        if ((dump != NULL) && (n < BENCH_DUMP_SAMPLES))
+            fprintf(dump, "%u,%u,%u,%u,0x%04X,%u\n", n, bench_source, bench_reference, 
+                bench_target, c2p2z.status.value, bench_trigger);
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    
+    if (dump != NULL) fclose(dump);
+    
+    bench_report("c2p2z_Update", samples, bench_elapsed(&t0, &t1));
+    printf("checksum: 0x%08X\n", hash);
+    
+    if (check && (hash != expected)) {
+        fprintf(stderr, "checksum mismatch (expected 0x%08X)\n", expected);
+        result = 1;
+    }
+    
+    // Block execution: c2p2z_UpdateBlock() over the same input data
+    if (block_size > 0) {
+        
+        seq_status = c2p2z.status.value;
+        seq_target = bench_target;
+        seq_trigger = bench_trigger;
+        
+        bench_controller_init();
+        
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        
+        for (n = 0; n < samples; n += chunk) {
+            chunk = ((samples - n) < block_size) ? (samples - n) : block_size;
+            c2p2z_UpdateBlock(&c2p2z, &input[n], &block_output[n], (uint16_t)chunk);
+        }
+        
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        
+        bench_report("c2p2z_UpdateBlock", samples, bench_elapsed(&t0, &t1));
+        
+        if ((samples > 0) && ((memcmp(output, block_output, samples * sizeof(uint16_t)) != 0) || 
+            (c2p2z.status.value != seq_status) || (bench_target != seq_target) || 
+            (bench_trigger != seq_trigger))) {
+            fprintf(stderr, "c2p2z_UpdateBlock results differ from sequential c2p2z_Update calls\n");
+            result = 1;
+        }
+        else {
+            printf("c2p2z_UpdateBlock (block size %u): outputs identical to sequential execution\n", block_size);
+        }
+    }
+    
+    free(input);
+    free(output);
+    free(block_output);
+    
+    return(result);
+}
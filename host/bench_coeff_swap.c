@@ -0,0 +1,228 @@
+/*
+ * File:   bench_coeff_swap.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 2:40 PM
+ *
+ * Stress test of the double-buffered coefficient hot-swap of the nPnZ controller template
+ * (c2p2z_SetCoefficients() / npnz16b_CommitCoefficients())
+ *
+ * A simulated control loop interrupt service routine runs in one thread, calling
+ * npnz16b_CommitCoefficients() and c2p2z_Update() for every sample, exactly as
+ * _VOUT_ADCInterrupt does on the device. A second thread takes the role of the main loop
+ * and publishes a new coefficient set as soon as the previous one has been committed. Both
+ * threads yield the processor while they have nothing to do (writer waiting for a free bank, 
+ * simulated ISR every BENCH_ISR_YIELD samples), so swaps also occur on single core hosts. 
+ * Every coefficient word carries the version number of its set, so each sample can be 
+ * checked for coefficients of different sets (mixed-bank sample).
+ *
+ * Usage: bench_coeff_swap [-n samples] [-u]
+ *
+ *    -n  number of samples computed by the simulated interrupt service routine (default 5000000)
+ *    -u  negative control: the writer overwrites the active coefficients in place the way
+ *        c2p2z_Init() did before the hot-swap was introduced. Mixed-bank samples are
+ *        expected to be detected in this mode.
+ *
+ * The program returns 1 if a mixed-bank sample was computed using the hot-swap or if the
+ * ISR observed fewer swaps than 1/BENCH_MIN_SWAPS of the samples (or if no mixed-bank sample 
+ * was detected in negative control mode).
+ *
+ * Please note:
+ * Both threads run truly parallel on the host while the device's interrupt service routine
+ * cannot be interrupted by the main loop. This makes the test stricter than the device
+ * use case. It relies on the store ordering of x86 hosts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "c2p2z.h"
+#include "dsp_engine.h"
+
+#define BENCH_DEFAULT_SAMPLES   5000000UL
+#define BENCH_WRITE_DELAY       16      // dummy loop iterations between two coefficient writes
+#define BENCH_ISR_YIELD         32      // samples after which the simulated ISR returns to the main loop
+#define BENCH_MIN_SWAPS         100     // minimum ratio of samples per observed swap
+
+#define BENCH_A_SIZE            2
+#define BENCH_B_SIZE            3
+#define BENCH_COEFF_COUNT       (BENCH_A_SIZE + BENCH_B_SIZE)
+
+volatile uint16_t bench_source = 2755;
+volatile uint16_t bench_target = 0;
+volatile uint16_t bench_reference = 2755;
+volatile uint16_t bench_trigger = 0;
+
+static volatile bool isr_done = false;
+static uint32_t isr_samples = BENCH_DEFAULT_SAMPLES;
+static uint32_t isr_mixed = 0;
+static uint32_t isr_swaps = 0;
+static uint32_t writer_swaps = 0;
+static uint32_t writer_busy = 0;
+static bool unsafe_mode = false;
+
+/*!Versioned coefficient word
+ * Upper byte: version of the coefficient set, lower byte: position within the bank */
+static inline fractional coeff_word(uint16_t version, uint16_t index)
+{
+    return((fractional)(((version & 0x7F) << 8) | index));
+}
+
+static inline void write_delay(void)
+{
+    volatile uint16_t i;
+    for (i = 0; i < BENCH_WRITE_DELAY; i++);
+}
+
+/*!bench_isr
+ * *************************************************************************************************
+ * Simulated _VOUT_ADCInterrupt: commit pending bank, take a snapshot of the coefficients the
+ * controller is going to use, run the controller and verify the snapshot after the update.
+ * *************************************************************************************************/
+static void* bench_isr(void* arg)
+{
+    uint32_t n;
+    uint16_t k, version, last_version = 0;
+    volatile fractional *pa, *pb;
+    fractional before[BENCH_COEFF_COUNT], after[BENCH_COEFF_COUNT];
+    bool mixed;
+
+    for (n = 0; n < isr_samples; n++) {
+
+        npnz16b_CommitCoefficients(&c2p2z);
+
+        pa = c2p2z.ptrACoefficients;
+        pb = c2p2z.ptrBCoefficients;
+        for (k = 0; k < BENCH_A_SIZE; k++) before[k] = pa[k];
+        for (k = 0; k < BENCH_B_SIZE; k++) before[BENCH_A_SIZE + k] = pb[k];
+
+        bench_source = (uint16_t)(2755 + (n & 0x3F) - 32);
+        c2p2z_Update(&c2p2z);
+
+        for (k = 0; k < BENCH_A_SIZE; k++) after[k] = pa[k];
+        for (k = 0; k < BENCH_B_SIZE; k++) after[BENCH_A_SIZE + k] = pb[k];
+
+        // All words need to belong to the same set and must not change during the update
+        mixed = (pb != (pa + BENCH_A_SIZE));
+        version = ((uint16_t)before[0] >> 8);
+        for (k = 0; k < BENCH_COEFF_COUNT; k++) {
+            if ((before[k] != coeff_word(version, k)) || (after[k] != before[k]))
+                mixed = true;
+        }
+
+        if (mixed) isr_mixed++;
+        else if (version != last_version) { isr_swaps++; last_version = version; }
+
+        // Leave the processor to the main loop between interrupts (single core hosts)
+        if ((n % BENCH_ISR_YIELD) == (BENCH_ISR_YIELD - 1)) sched_yield();
+    }
+
+    isr_done = true;
+    return(NULL);
+}
+
+/*!bench_writer
+ * *************************************************************************************************
+ * Simulated main loop publishing new coefficient sets as fast as possible
+ * *************************************************************************************************/
+static void* bench_writer(void* arg)
+{
+    uint16_t k, version = 1;
+    volatile c2p2z_CONTROL_LOOP_COEFFICIENTS_t* bank;
+    volatile fractional* active;
+
+    while (!isr_done) {
+
+        version = (version + 1) & 0x7F;
+
+        if (unsafe_mode) {
+            // Negative control: overwrite active coefficients in place
+            active = c2p2z.ptrACoefficients;
+            for (k = 0; k < BENCH_COEFF_COUNT; k++) {
+                active[k] = coeff_word(version, k);
+                write_delay();
+            }
+            writer_swaps++;
+        }
+        else {
+            // Hot-swap: fill inactive bank as soon as the previous swap has been committed
+            while (((bank = c2p2z_GetCoefficientBank()) == NULL) && (!isr_done)) {
+                writer_busy++;
+                sched_yield();
+            }
+            if (bank == NULL) break;
+
+            for (k = 0; k < BENCH_A_SIZE; k++) {
+                bank->ACoefficients[k] = coeff_word(version, k);
+                write_delay();
+            }
+            for (k = 0; k < BENCH_B_SIZE; k++) {
+                bank->BCoefficients[k] = coeff_word(version, BENCH_A_SIZE + k);
+                write_delay();
+            }
+            c2p2z_SwapCoefficientBank(bank);
+            writer_swaps++;
+        }
+    }
+
+    return(NULL);
+}
+
+int main(int argc, char** argv)
+{
+    pthread_t isr_thread, writer_thread;
+    fractional a[BENCH_A_SIZE], b[BENCH_B_SIZE];
+    uint16_t k;
+    int i, result;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+            isr_samples = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-u") == 0)
+            unsafe_mode = true;
+        else {
+            fprintf(stderr, "usage: %s [-n samples] [-u]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    // Initialize the controller the same way init_pwr_control() does
+    c2p2z_Init();
+    c2p2z.ptrSource = &bench_source;
+    c2p2z.ptrTarget = &bench_target;
+    c2p2z.ptrControlReference = &bench_reference;
+    c2p2z.ptrADCTriggerRegister = &bench_trigger;
+    c2p2z.MinOutput = 806;
+    c2p2z.MaxOutput = 3847;
+    c2p2z.status.bits.enable = 1;
+
+    // Start with a versioned coefficient set (version 1) in the active bank
+    for (k = 0; k < BENCH_A_SIZE; k++) a[k] = coeff_word(1, k);
+    for (k = 0; k < BENCH_B_SIZE; k++) b[k] = coeff_word(1, BENCH_A_SIZE + k);
+    c2p2z_SetCoefficients(a, b);
+    npnz16b_CommitCoefficients(&c2p2z);
+
+    pthread_create(&isr_thread, NULL, bench_isr, NULL);
+    pthread_create(&writer_thread, NULL, bench_writer, NULL);
+    pthread_join(isr_thread, NULL);
+    pthread_join(writer_thread, NULL);
+
+    printf("mode: %s\n", (unsafe_mode) ? "in-place overwrite (negative control)" : "double-buffered hot-swap");
+    printf("samples: %u, coefficient sets written: %u, swaps observed by ISR: %u, writer busy polls: %u\n",
+        isr_samples, writer_swaps, isr_swaps, writer_busy);
+    printf("mixed-bank samples: %u\n", isr_mixed);
+
+    if (unsafe_mode)
+        result = (isr_mixed == 0);  // the test has to be able to detect mixed samples
+    else
+        result = ((isr_mixed != 0) || (isr_swaps < (isr_samples / BENCH_MIN_SWAPS)));
+
+    printf("%s\n", (result) ? "FAILED" : "PASSED");
+
+    return(result);
+}
@@ -0,0 +1,193 @@
+/*
+ * File:   bench_ext_reference.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 6:10 PM
+ *
+ * Comparison of the external reference filter options of task_external_reference.c
+ * (EXT_REF_FILTER_HARDWARE, EXT_REF_FILTER_MOVING_AVERAGE and EXT_REF_FILTER_IIR).
+ *
+ * The firmware source is compiled unchanged once per filter option. Symbols of each build
+ * are renamed by the Makefile (ext_ref_<option>_update/ext_ref_<option>_init) so all options
+ * can be linked into this single tool. Samples are passed one by one to the filter update
+ * function, as done by the AN6 interrupt service routine. The averaging of the ADC digital 
+ * filter of EXT_REF_FILTER_HARDWARE is emulated by the tool, which passes each completed 
+ * average to the update function. For each option the tool reports
+ *
+ *    - host execution time per sample of the filter update
+ *    - number of samples between two updates of converter.data.v_ref
+ *    - step response latency (50% and 90% of a reference step) in samples and usec
+ *    - RMS noise of the published reference at constant input with +/-16 LSB of noise
+ *
+ * Usage: bench_ext_reference [-n samples]
+ *
+ *    -n  number of samples of the execution time measurement (default 1000000)
+ *
+ * Please note:
+ * Host execution times are meant to compare the filter options against each other, they
+ * do not reflect device cycles.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <xc.h>
+#include "globals.h"
+
+#define BENCH_DEFAULT_SAMPLES   1000000UL
+#define BENCH_SAMPLE_PERIOD     (1.0e6 / SWITCHING_FREQUENCY)   // sample period in [usec]
+#define BENCH_STEP_LOW          1024    // ADC value before the reference step
+#define BENCH_STEP_HIGH         3072    // ADC value after the reference step
+#define BENCH_STEP_TIMEOUT      4096    // maximum number of samples of the step response
+#define BENCH_NOISE_LEVEL       2048    // ADC value of the noise measurement
+#define BENCH_NOISE_AMPLITUDE   16      // peak noise amplitude in [ADC ticks]
+#define BENCH_NOISE_SAMPLES     65536   // number of samples of the noise measurement
+#define BENCH_NO_UPDATE         0xFFFF  // marker of samples not updating the reference
+
+volatile POWER_CONTROLLER_t converter;
+
+extern volatile uint16_t ext_ref_hw_init(void);
+extern volatile uint16_t ext_ref_hw_update(volatile uint16_t* samples, uint16_t count);
+extern volatile uint16_t ext_ref_ma_init(void);
+extern volatile uint16_t ext_ref_ma_update(volatile uint16_t* samples, uint16_t count);
+extern volatile uint16_t ext_ref_iir_init(void);
+extern volatile uint16_t ext_ref_iir_update(volatile uint16_t* samples, uint16_t count);
+
+typedef struct {
+    const char* name;
+    volatile uint16_t (*init)(void);
+    volatile uint16_t (*update)(volatile uint16_t* samples, uint16_t count);
+    uint16_t hw_avg_log2;   // averaging ratio of the emulated ADC digital filter (0 = none)
+} BENCH_FILTER_t;
+
+static const BENCH_FILTER_t filter[] = {
+    { "ADC filter (2^EXT_REF_HW_AVG_LOG2)",      &ext_ref_hw_init,  &ext_ref_hw_update,  EXT_REF_HW_AVG_LOG2 },
+    { "moving average (2^EXT_REF_MA_LENGTH_LOG2)", &ext_ref_ma_init,  &ext_ref_ma_update,  0 },
+    { "IIR (2^-EXT_REF_IIR_SHIFT)",              &ext_ref_iir_init, &ext_ref_iir_update, 0 }
+};
+
+static uint32_t hw_sum = 0;     // accumulator of the emulated ADC digital filter
+static uint16_t hw_count = 0;   // samples accumulated by the emulated ADC digital filter
+
+static uint32_t lcg_state = 0x12345678;
+
+static uint16_t bench_scale(uint16_t sample)
+{
+    return(V_REF_MIN + (uint16_t)(((uint32_t)(sample << 3) * V_REF_DIFF) >> 15));
+}
+
+static void bench_init(const BENCH_FILTER_t* f)
+{
+    hw_sum = 0;
+    hw_count = 0;
+    f->init();
+}
+
+static uint16_t bench_sample(const BENCH_FILTER_t* f, uint16_t sample)
+{
+    ADCBUF6 = sample;
+    
+    if (f->hw_avg_log2) {
+        hw_sum += ADCBUF6;
+        if (++hw_count < (1 << f->hw_avg_log2))
+            return(converter.data.v_ref);
+        REG_VREF_ADFLDAT = (uint16_t)(hw_sum >> f->hw_avg_log2);
+        hw_sum = 0;
+        hw_count = 0;
+        f->update(&REG_VREF_ADFLDAT, 1);
+    }
+    else {
+        f->update(&ADCBUF6, 1);
+    }
+    
+    return(converter.data.v_ref);
+}
+
+static uint16_t bench_noise(uint16_t level)
+{
+    lcg_state = lcg_state * 1664525UL + 1013904223UL;
+    return((uint16_t)(level - BENCH_NOISE_AMPLITUDE + ((lcg_state >> 16) % (2 * BENCH_NOISE_AMPLITUDE + 1))));
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t samples = BENCH_DEFAULT_SAMPLES;
+    uint32_t n, updates, t50, t90;
+    uint16_t k, v_low, v_high, v_50, v_90, v_noise;
+    struct timespec t_start, t_stop;
+    double ns, err, rms;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+            samples = strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n samples]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    v_low = bench_scale(BENCH_STEP_LOW);
+    v_high = bench_scale(BENCH_STEP_HIGH);
+    v_50 = v_low + ((v_high - v_low) / 2);
+    v_90 = v_low + (((uint32_t)(v_high - v_low) * 9) / 10);
+    v_noise = bench_scale(BENCH_NOISE_LEVEL);
+
+    printf("external reference filter (EXT_REF_MA_LENGTH_LOG2=%d, EXT_REF_IIR_SHIFT=%d), sample period %.2f usec\n",
+        EXT_REF_MA_LENGTH_LOG2, EXT_REF_IIR_SHIFT, BENCH_SAMPLE_PERIOD);
+    printf("%-42s %10s %8s %14s %14s %10s\n", "filter", "ns/sample", "update", "t50 [smp/us]", "t90 [smp/us]", "noise rms");
+
+    for (k = 0; k < (sizeof(filter) / sizeof(filter[0])); k++) {
+
+        const BENCH_FILTER_t* f = &filter[k];
+
+        // Execution time
+        bench_init(f);
+        clock_gettime(CLOCK_MONOTONIC, &t_start);
+        for (n = 0; n < samples; n++)
+            bench_sample(f, bench_noise(BENCH_NOISE_LEVEL));
+        clock_gettime(CLOCK_MONOTONIC, &t_stop);
+        ns = ((double)(t_stop.tv_sec - t_start.tv_sec) * 1.0e9 + (double)(t_stop.tv_nsec - t_start.tv_nsec)) / samples;
+
+        // Settle at the lower step level
+        bench_init(f);
+        for (n = 0; n < BENCH_STEP_TIMEOUT; n++)
+            bench_sample(f, BENCH_STEP_LOW);
+
+        // Step response and update interval
+        t50 = t90 = 0;
+        updates = 0;
+        for (n = 1; n <= BENCH_STEP_TIMEOUT; n++) {
+            converter.data.v_ref = BENCH_NO_UPDATE;
+            if (bench_sample(f, BENCH_STEP_HIGH) == BENCH_NO_UPDATE)
+                continue;
+            updates++;
+            if ((!t50) && (converter.data.v_ref >= v_50)) t50 = n;
+            if ((!t90) && (converter.data.v_ref >= v_90)) t90 = n;
+        }
+
+        // Output noise at constant input
+        bench_init(f);
+        for (n = 0; n < BENCH_STEP_TIMEOUT; n++)
+            bench_sample(f, bench_noise(BENCH_NOISE_LEVEL));
+        rms = 0.0;
+        for (n = 0; n < BENCH_NOISE_SAMPLES; n++) {
+            err = (double)bench_sample(f, bench_noise(BENCH_NOISE_LEVEL)) - (double)v_noise;
+            rms += (err * err);
+        }
+        rms = sqrt(rms / BENCH_NOISE_SAMPLES);
+
+        printf("%-42s %10.2f %8u %6u/%7.1f %6u/%7.1f %10.3f\n", f->name, ns,
+            (updates ? (unsigned)(BENCH_STEP_TIMEOUT / updates) : 0),
+            t50, t50 * BENCH_SAMPLE_PERIOD, t90, t90 * BENCH_SAMPLE_PERIOD, rms);
+    }
+
+    printf("update: samples between reference updates, noise rms in [DAC ticks] at +/-%d ADC ticks input noise\n",
+        BENCH_NOISE_AMPLITUDE);
+
+    return(0);
+}
@@ -0,0 +1,246 @@
+/*
+ * File:   bench_gain_scheduler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 9:40 PM
+ *
+ * Test of the gain scheduler of the voltage loop compensator (task_gain_scheduler.c) with
+ * distinct coefficient designs at every operating point of the table.
+ *
+ * The firmware source is compiled unchanged with GS_TABLE_EXTERNAL = true, the coefficient
+ * tables gs_ACoefficients/gs_BCoefficients are defined by this tool. As every table entry
+ * differs from its neighbors, each change of the operating point results in a new
+ * coefficient set. The tool checks
+ *
+ *    - gs_table_position() for every ADC value of the input voltage and load axes against
+ *      the exact table position, including the clamping at the table borders
+ *    - gs_interpolate() on a grid of 64 x 64 positions per table interval against the exact
+ *      bilinear interpolation of the table
+ *    - the coefficients activated by gain_scheduler_exec() at operating points below, inside
+ *      and above the table (table borders have to be hit exactly)
+ *    - the number of published coefficient sets: every published set has to be activated by
+ *      the simulated control loop interrupt, no set may be published at a constant operating
+ *      point or at the initial operating point (first table entry = coefficients of c2p2z.c)
+ *      and at least one at each change of the operating point
+ *
+ * Usage: bench_gain_scheduler
+ *
+ * The program returns 1 if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <xc.h>
+#include "globals.h"
+#include "task_gain_scheduler.h"
+
+#define BENCH_TOLERANCE         2       // maximum deviation of interpolated coefficients in [LSB]
+#define BENCH_SETTLE_CALLS      200     // scheduler calls to settle the operating point filters
+#define BENCH_HOLD_CALLS        100     // scheduler calls at a constant operating point
+#define BENCH_GRID              64      // interpolation grid intervals per table interval
+
+volatile POWER_CONTROLLER_t converter;
+volatile uint16_t bench_ctrl_out = 0;   // compensator output (load axis of the scheduler)
+
+/* Distinct designs: coefficients change along both axes and not linearly across the table */
+const fractional gs_ACoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][2] =
+{
+    { { 0x4629, 0xEFD1 }, { 0x4A10, 0xEC00 }, { 0x5200, 0xE800 } },	//  9.0 V: light, medium, full load
+    { { 0x3E00, 0xF400 }, { 0x4629, 0xEFD1 }, { 0x4900, 0xEA00 } },	// 13.5 V: light, medium, full load
+    { { 0x3000, 0xF800 }, { 0x3A00, 0xF200 }, { 0x4629, 0xEFD1 } }	// 18.0 V: light, medium, full load
+};
+
+const fractional gs_BCoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][3] =
+{
+    { { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7000, 0x0100, 0x9000 }, { 0x6000, 0x0300, 0xA000 } },	//  9.0 V: light, medium, full load
+    { { 0x7800, 0x0050, 0x8800 }, { 0x7FFF, 0x00B0, 0x80B1 }, { 0x5800, 0x0200, 0xA800 } },	// 13.5 V: light, medium, full load
+    { { 0x6800, 0xFF00, 0x9800 }, { 0x5000, 0x0400, 0xB000 }, { 0x7FFF, 0x00B0, 0x80B1 } }	// 18.0 V: light, medium, full load
+};
+
+static uint32_t failures = 0;
+static uint32_t commits = 0;
+
+static void check(bool condition, const char* message, int a, int b)
+{
+    if (condition) return;
+    if (failures < 10) printf("  FAIL: %s (%d, %d)\n", message, a, b);
+    failures++;
+}
+
+/*!Exact table position of 'value' (clamped) in table intervals */
+static double table_position(uint16_t value, uint16_t min, uint16_t max, uint16_t points)
+{
+    if (value <= min) return(0.0);
+    if (value >= max) return((double)(points - 1));
+    return((double)(value - min) * (double)(points - 1) / (double)(max - min));
+}
+
+/*!Exact bilinear interpolation of coefficient k (A1, A2, B0, B1, B2) at a table position */
+static double table_interpolate(uint16_t k, double p_vin, double p_load)
+{
+    int i_vin = (p_vin >= (GS_VIN_POINTS - 1)) ? (GS_VIN_POINTS - 2) : (int)p_vin;
+    int i_load = (p_load >= (GS_LOAD_POINTS - 1)) ? (GS_LOAD_POINTS - 2) : (int)p_load;
+    double f_vin = p_vin - i_vin, f_load = p_load - i_load, c[2][2];
+    int v, l;
+
+    for (v = 0; v < 2; v++)
+        for (l = 0; l < 2; l++)
+            c[v][l] = (k < 2) ? gs_ACoefficients[i_vin + v][i_load + l][k] :
+                                gs_BCoefficients[i_vin + v][i_load + l][k - 2];
+
+    return((1.0 - f_vin) * ((1.0 - f_load) * c[0][0] + f_load * c[0][1]) +
+           f_vin * ((1.0 - f_load) * c[1][0] + f_load * c[1][1]));
+}
+
+/*!Active coefficient k (A1, A2, B0, B1, B2) of the compensator */
+static fractional active_coefficient(uint16_t k)
+{
+    return((k < 2) ? c2p2z.ptrACoefficients[k] : c2p2z.ptrBCoefficients[k - 2]);
+}
+
+/*!Calls the scheduler at a constant operating point, each call followed by one sample */
+static void run_scheduler(uint16_t vin, uint16_t load, uint16_t calls)
+{
+    REG_VIN_ADCBUF = vin;
+    *c2p2z.ptrTarget = load;
+
+    while (calls--) {
+        gain_scheduler_exec();
+        if (c2p2z.ptrCoefficientsPending != NULL) commits++;
+        npnz16b_CommitCoefficients(&c2p2z);
+    }
+}
+
+static void test_table_position(const char* axis, uint16_t min, uint16_t max, uint16_t points)
+{
+    uint16_t value, index, fraction;
+    double pos, expected;
+
+    for (value = 0; value < 4096; value++) {
+        index = gs_table_position(value, min, max, points, &fraction);
+        pos = table_position(value, min, max, points);
+
+        check((index <= (points - 2)) && (fraction <= 0x8000), axis, value, index);
+        if (value <= min) check((index == 0) && (fraction == 0), "lower border not clamped", value, fraction);
+        if (value >= max) check((index == (points - 2)) && (fraction == 0x8000), "upper border not clamped", value, fraction);
+
+        expected = (pos - index) * 32768.0;
+        check(fabs((double)fraction - expected) <= 1.0, "table position", value, fraction);
+    }
+    printf("gs_table_position(%s): %u ... %u, %u points\n", axis, min, max, points);
+}
+
+static void test_interpolate(void)
+{
+    uint16_t i, j, k, i_vin, i_load, f_vin, f_load;
+    double p_vin, p_load, deviation, max_deviation = 0.0;
+    fractional c;
+
+    for (i = 0; i <= (GS_VIN_POINTS - 1) * BENCH_GRID; i++) {
+        for (j = 0; j <= (GS_LOAD_POINTS - 1) * BENCH_GRID; j++) {
+
+            p_vin = (double)i / BENCH_GRID;
+            p_load = (double)j / BENCH_GRID;
+            i_vin = (i >= (GS_VIN_POINTS - 1) * BENCH_GRID) ? (GS_VIN_POINTS - 2) : (i / BENCH_GRID);
+            i_load = (j >= (GS_LOAD_POINTS - 1) * BENCH_GRID) ? (GS_LOAD_POINTS - 2) : (j / BENCH_GRID);
+            f_vin = (uint16_t)((p_vin - i_vin) * 32768.0);
+            f_load = (uint16_t)((p_load - i_load) * 32768.0);
+
+            for (k = 0; k < 5; k++) {
+                if (k < 2)
+                    c = gs_interpolate(
+                        gs_ACoefficients[i_vin][i_load][k], gs_ACoefficients[i_vin][i_load + 1][k],
+                        gs_ACoefficients[i_vin + 1][i_load][k], gs_ACoefficients[i_vin + 1][i_load + 1][k],
+                        f_vin, f_load);
+                else
+                    c = gs_interpolate(
+                        gs_BCoefficients[i_vin][i_load][k - 2], gs_BCoefficients[i_vin][i_load + 1][k - 2],
+                        gs_BCoefficients[i_vin + 1][i_load][k - 2], gs_BCoefficients[i_vin + 1][i_load + 1][k - 2],
+                        f_vin, f_load);
+
+                deviation = fabs((double)c - table_interpolate(k, p_vin, p_load));
+                if (deviation > max_deviation) max_deviation = deviation;
+                check(deviation <= BENCH_TOLERANCE, "interpolation", i * 100 + j, k);
+            }
+        }
+    }
+    printf("gs_interpolate: %u x %u positions, max. deviation %.2f LSB\n",
+        (GS_VIN_POINTS - 1) * BENCH_GRID + 1, (GS_LOAD_POINTS - 1) * BENCH_GRID + 1, max_deviation);
+}
+
+static void test_scheduler(void)
+{
+    static const struct { uint16_t vin, load; int corner; } points[] = {
+        { 0,          0,           0 },     // below both axes: first table entry
+        { 4095,       4095,        8 },     // above both axes: last table entry
+        { 0,          4095,        2 },     // lowest input voltage, full load
+        { 4095,       0,           6 },     // highest input voltage, light load
+        { (GS_VIN_MIN + GS_VIN_MAX) / 2, (GS_LOAD_MIN + GS_LOAD_MAX) / 2, -1 },
+        { GS_VIN_MIN + (GS_VIN_MAX - GS_VIN_MIN) / 5, GS_LOAD_MAX - (GS_LOAD_MAX - GS_LOAD_MIN) / 7, -1 },
+        { GS_VIN_MAX - (GS_VIN_MAX - GS_VIN_MIN) / 3, GS_LOAD_MIN + (GS_LOAD_MAX - GS_LOAD_MIN) / 9, -1 },
+        { 0,          0,           0 }      // back to the first table entry
+    };
+    uint16_t n, k, swaps;
+    double p_vin, p_load, expected;
+
+    c2p2z_Init();
+    c2p2z.ptrTarget = &bench_ctrl_out;
+    npnz16b_CommitCoefficients(&c2p2z);
+    gain_scheduler_init();
+    converter.status.flags.op_status = STAT_ON;
+
+    for (n = 0; n < (sizeof(points) / sizeof(points[0])); n++) {
+
+        swaps = gain_scheduler.swaps;
+        run_scheduler(points[n].vin, points[n].load, BENCH_SETTLE_CALLS);
+        if (n == 0) // initial operating point and coefficients of c2p2z.c match the first table entry
+            check(gain_scheduler.swaps == 0, "coefficient set published without change", n, gain_scheduler.swaps);
+        else
+            check(gain_scheduler.swaps > swaps, "no coefficient set published at new operating point", n, swaps);
+        check((gain_scheduler.vin == points[n].vin) && (gain_scheduler.load == points[n].load),
+            "operating point filter not settled", gain_scheduler.vin, gain_scheduler.load);
+
+        p_vin = table_position(gain_scheduler.vin, GS_VIN_MIN, GS_VIN_MAX, GS_VIN_POINTS);
+        p_load = table_position(gain_scheduler.load, GS_LOAD_MIN, GS_LOAD_MAX, GS_LOAD_POINTS);
+        for (k = 0; k < 5; k++) {
+            if (points[n].corner >= 0) {
+                expected = (k < 2) ?
+                    gs_ACoefficients[points[n].corner / GS_LOAD_POINTS][points[n].corner % GS_LOAD_POINTS][k] :
+                    gs_BCoefficients[points[n].corner / GS_LOAD_POINTS][points[n].corner % GS_LOAD_POINTS][k - 2];
+                check(active_coefficient(k) == (fractional)expected, "table border", n, k);
+            }
+            else {
+                expected = table_interpolate(k, p_vin, p_load);
+                check(fabs((double)active_coefficient(k) - expected) <= BENCH_TOLERANCE, "active coefficient", n, k);
+            }
+        }
+
+        swaps = gain_scheduler.swaps;
+        run_scheduler(points[n].vin, points[n].load, BENCH_HOLD_CALLS);
+        check(gain_scheduler.swaps == swaps, "coefficient set published at constant operating point", n,
+            gain_scheduler.swaps - swaps);
+
+        printf("vin %4u, load %4u: A %6d %6d, B %6d %6d %6d, sets published %u\n",
+            points[n].vin, points[n].load, active_coefficient(0), active_coefficient(1),
+            active_coefficient(2), active_coefficient(3), active_coefficient(4), gain_scheduler.swaps);
+    }
+
+    check(gain_scheduler.swaps == commits, "published sets not activated", gain_scheduler.swaps, commits);
+    printf("sets published: %u, activated: %u\n", gain_scheduler.swaps, commits);
+}
+
+int main(int argc, char** argv)
+{
+    test_table_position("vin", GS_VIN_MIN, GS_VIN_MAX, GS_VIN_POINTS);
+    test_table_position("load", GS_LOAD_MIN, GS_LOAD_MAX, GS_LOAD_POINTS);
+    test_interpolate();
+    test_scheduler();
+
+    printf("failures: %u\n%s\n", failures, (failures) ? "FAILED" : "PASSED");
+
+    return(failures != 0);
+}
@@ -0,0 +1,253 @@
+/*
+ * File:   bench_npnz_circ.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 12:10 PM
+ *
+ * Equivalence check of the circular delay line nPnZ compensator (host translation of 
+ * src/npnz16b_circ_asm.s) against the shift-copy delay line for filter orders 2 through 6.
+ * The tool does not time the kernels: host execution times do not reflect device cycles 
+ * (see the estimate in the header of src/npnz16b_circ_asm.s).
+ *
+ * Order 2 is compared against c2p2z_Update() using the coefficients of c2p2z.c.
+ * Orders 3 to 6 are compared against shift-copy controllers generated from the host
+ * translation of the generic nPnZ template npnz16b.inc.
+ *
+ * Usage: bench_npnz_circ [-n samples]
+ *
+ *    -n  number of samples pushed through each controller (default 2000000)
+ *
+ * The transient boost is enabled on all controllers, so the stimulus exercises the linear
+ * error band, the boosted branches and both clamping limits. The back-calculation of clamped
+ * outputs is only part of the kernels when built with -DUSE_SOFT_DESATURATION=true (see the
+ * assemble-time options of npnz16b.inc); make run checks both builds.
+ *
+ * The program returns 1 if any output, status word or ADC trigger value differs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "globals.h"
+#include "c2p2z.h"
+#include "npnz16b_circ.h"
+#include "dsp_engine.h"
+#include "npnz16b_asm.h"
+
+#define BENCH_DEFAULT_SAMPLES   2000000UL
+#define BENCH_MIN_ORDER         2
+#define BENCH_MAX_ORDER         6
+
+#define BENCH_REFERENCE         2755    // ADC ticks of 15 V at the output divider (see V_OUT_REF)
+#define BENCH_MIN_OUTPUT        806     // DAC ticks of 0.65 V (see DAC_MIN)
+#define BENCH_MAX_OUTPUT        3847    // DAC ticks of 3.10 V (see DAC_MAX)
+#define BENCH_TRIGGER_OFFSET    680     // ADC trigger offset (see VOUT_ADCTRIG)
+#define BENCH_BOOST_BAND        (40 << 3)   // transient boost band of 40 ADC ticks (normalized error)
+#define BENCH_BOOST_GAIN        0x4000  // transient boost gain of 0.5 (Q15)
+#define BENCH_BACK_CALC         0x3000  // back-calculation gain of 0.375 per output tick (Q15)
+
+volatile uint16_t bench_source = 0;
+volatile uint16_t bench_reference = BENCH_REFERENCE;
+volatile uint16_t ref_target = 0, ref_trigger = 0;
+volatile uint16_t circ_target = 0, circ_trigger = 0;
+
+volatile fractional ref_ctrl_hist[BENCH_MAX_ORDER], ref_err_hist[BENCH_MAX_ORDER + 1];
+volatile fractional circ_ctrl_hist[NPNZ16B_CIRC_HISTORY_SIZE(BENCH_MAX_ORDER)];
+volatile fractional circ_err_hist[NPNZ16B_CIRC_HISTORY_SIZE(BENCH_MAX_ORDER)];
+
+/* Higher order test coefficients: 2P2Z coefficients of c2p2z.c extended by small
+ * additional poles and zeros. Stability is not required for the equivalence check,
+ * both saturation limits are exercised by the stimulus. */
+volatile fractional bench_ACoefficients[BENCH_MAX_ORDER] =
+    { 0x4629, (fractional)0xEFD1, 0x0400, (fractional)0xFE00, 0x0100, (fractional)0xFF80 };
+volatile fractional bench_BCoefficients[BENCH_MAX_ORDER + 1] =
+    { 0x7FFF, 0x00B0, (fractional)0x80B1, 0x0200, (fractional)0xFF00, 0x0080, (fractional)0xFFC0 };
+
+volatile cNPNZ16b_t ref, circ;
+static cNPNZ16b_t c2p2z_defaults;  // copy of c2p2z after c2p2z_Init()
+
+static uint32_t lcg_state = 0x12345678;
+
+/*!bench_stimulus
+ * *************************************************************************************************
+ * Same stimulus as bench_c2p2z: slowly moving square wave with superimposed noise
+ * *************************************************************************************************/
+static inline uint16_t bench_stimulus(uint32_t n)
+{
+    int32_t value;
+
+    lcg_state = lcg_state * 1664525UL + 1013904223UL;
+
+    switch ((n >> 12) & 0x03) {
+        case 0:  value = BENCH_REFERENCE - 800; break;
+        case 1:  value = BENCH_REFERENCE; break;
+        case 2:  value = BENCH_REFERENCE + 600; break;
+        default: value = BENCH_REFERENCE - 20; break;
+    }
+    value += (int32_t)((lcg_state >> 24) & 0x3F) - 32;
+
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+
+    return((uint16_t)value);
+}
+
+/*!Shift-copy references
+ * *************************************************************************************************
+ * Fully unrolled shift-copy controllers of orders 3 to 6 generated from the host translation
+ * of the generic nPnZ template npnz16b.inc
+ * *************************************************************************************************/
+NPNZ16B_HOST_KERNELS(npnz3p3z, 3, USE_TRANSIENT_BOOST, USE_SOFT_DESATURATION)
+NPNZ16B_HOST_KERNELS(npnz4p4z, 4, USE_TRANSIENT_BOOST, USE_SOFT_DESATURATION)
+NPNZ16B_HOST_KERNELS(npnz5p5z, 5, USE_TRANSIENT_BOOST, USE_SOFT_DESATURATION)
+NPNZ16B_HOST_KERNELS(npnz6p6z, 6, USE_TRANSIENT_BOOST, USE_SOFT_DESATURATION)
+
+typedef void (*NPNZ_UPDATE_t)(volatile cNPNZ16b_t* controller);
+
+static const NPNZ_UPDATE_t shiftcopy_Update[BENCH_MAX_ORDER + 1] = 
+    { NULL, NULL, &c2p2z_Update, &npnz3p3z_Update, &npnz4p4z_Update, &npnz5p5z_Update, &npnz6p6z_Update };
+
+/*!bench_controller_init
+ * *************************************************************************************************
+ * Sets up a controller data object of the given order with the 2P2Z scaling of c2p2z.c
+ * (captured in c2p2z_defaults)
+ * *************************************************************************************************/
+static void bench_controller_init(volatile cNPNZ16b_t* controller, uint16_t order,
+    volatile fractional* a_coeff, volatile fractional* b_coeff,
+    volatile fractional* ctrl_hist, volatile fractional* err_hist,
+    volatile uint16_t* target, volatile uint16_t* trigger)
+{
+    memset((void*)controller, 0, sizeof(cNPNZ16b_t));
+
+    controller->ptrSource = &bench_source;
+    controller->ptrTarget = target;
+    controller->ptrControlReference = &bench_reference;
+    controller->ptrACoefficients = a_coeff;
+    controller->ptrBCoefficients = b_coeff;
+    controller->ptrControlHistory = ctrl_hist;
+    controller->ptrErrorHistory = err_hist;
+    controller->ACoefficientsArraySize = order;
+    controller->BCoefficientsArraySize = order + 1;
+    controller->ControlHistoryArraySize = order;
+    controller->ErrorHistoryArraySize = order + 1;
+    controller->normPreShift = c2p2z_defaults.normPreShift;
+    controller->normPostShiftA = c2p2z_defaults.normPostShiftA;
+    controller->normPostShiftB = c2p2z_defaults.normPostShiftB;
+    controller->normPostScaler = c2p2z_defaults.normPostScaler;
+    controller->MinOutput = BENCH_MIN_OUTPUT;
+    controller->MaxOutput = BENCH_MAX_OUTPUT;
+    controller->ptrADCTriggerRegister = trigger;
+    controller->ADCTriggerOffset = BENCH_TRIGGER_OFFSET;
+    controller->BoostBand = BENCH_BOOST_BAND;
+    controller->BoostGain = BENCH_BOOST_GAIN;
+    controller->BackCalcGain = BENCH_BACK_CALC; // (no effect unless back-calculation is assembled)
+    controller->status.value = CONTROLLER_STATUS_ENABLE_ON;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t samples = BENCH_DEFAULT_SAMPLES;
+    uint32_t n, mismatch;
+    uint16_t order, *input, *ref_out, *circ_out;
+    int i, result = 0;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+            samples = strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n samples]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    input = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    ref_out = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    circ_out = (uint16_t*)malloc(samples * sizeof(uint16_t) + 1);
+    if ((input == NULL) || (ref_out == NULL) || (circ_out == NULL)) {
+        fprintf(stderr, "out of memory\n");
+        return(2);
+    }
+
+    for (n = 0; n < samples; n++)
+        input[n] = bench_stimulus(n);
+
+    c2p2z_Init();
+    memcpy(&c2p2z_defaults, (void*)&c2p2z, sizeof(cNPNZ16b_t));
+
+    printf("order   result\n");
+
+    for (order = BENCH_MIN_ORDER; order <= BENCH_MAX_ORDER; order++) {
+
+        // Shift-copy reference: c2p2z_Update() for order 2, template instances above
+        if (order == 2) {
+            bench_controller_init(&c2p2z, 2, c2p2z_defaults.ptrACoefficients, c2p2z_defaults.ptrBCoefficients,
+                c2p2z_defaults.ptrControlHistory, c2p2z_defaults.ptrErrorHistory, &ref_target, &ref_trigger);
+            c2p2z_Reset(&c2p2z);
+        }
+        else {
+            bench_controller_init(&ref, order, bench_ACoefficients, bench_BCoefficients,
+                ref_ctrl_hist, ref_err_hist, &ref_target, &ref_trigger);
+            memset((void*)ref_ctrl_hist, 0, sizeof(ref_ctrl_hist));
+            memset((void*)ref_err_hist, 0, sizeof(ref_err_hist));
+        }
+
+        for (n = 0; n < samples; n++) {
+            bench_source = input[n];
+            shiftcopy_Update[order]((order == 2) ? &c2p2z : &ref);
+            ref_out[n] = ref_target;
+        }
+
+        // Circular delay line
+        bench_controller_init(&circ, order,
+            ((order == 2) ? c2p2z_defaults.ptrACoefficients : bench_ACoefficients),
+            ((order == 2) ? c2p2z_defaults.ptrBCoefficients : bench_BCoefficients),
+            circ_ctrl_hist, circ_err_hist, &circ_target, &circ_trigger);
+        npnz16b_circ_Reset(&circ);
+
+        for (n = 0; n < samples; n++) {
+            bench_source = input[n];
+            npnz16b_circ_Update(&circ);
+            circ_out[n] = circ_target;
+        }
+
+        mismatch = 0;
+        for (n = 0; n < samples; n++)
+            if (ref_out[n] != circ_out[n]) mismatch++;
+        if ((ref_trigger != circ_trigger) ||
+            (((order == 2) ? c2p2z.status.value : ref.status.value) != circ.status.value))
+            mismatch++;
+
+        printf("%uP%uZ    %s\n", order, order, (mismatch == 0) ? "identical" : "MISMATCH");
+
+        if (mismatch) result = 1;
+    }
+
+    // Pre-charged delay line: the first output has to match the shift-copy reference
+    bench_controller_init(&ref, BENCH_MAX_ORDER, bench_ACoefficients, bench_BCoefficients,
+        ref_ctrl_hist, ref_err_hist, &ref_target, &ref_trigger);
+    bench_controller_init(&circ, BENCH_MAX_ORDER, bench_ACoefficients, bench_BCoefficients,
+        circ_ctrl_hist, circ_err_hist, &circ_target, &circ_trigger);
+    for (i = 0; i <= BENCH_MAX_ORDER; i++) {
+        ref_err_hist[i] = 0x0010;
+        if (i < BENCH_MAX_ORDER) ref_ctrl_hist[i] = 0x0800;
+    }
+    npnz16b_circ_Precharge(&circ, 0x0010, 0x0800);
+    for (n = 0; (n < samples) && (n < 1000); n++) {
+        bench_source = input[n];
+        shiftcopy_Update[BENCH_MAX_ORDER](&ref);
+        npnz16b_circ_Update(&circ);
+        if (ref_target != circ_target) {
+            fprintf(stderr, "npnz16b_circ_Precharge: output differs at sample %u\n", n);
+            result = 1;
+            break;
+        }
+    }
+
+    free(input);
+    free(ref_out);
+    free(circ_out);
+
+    return(result);
+}
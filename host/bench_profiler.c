@@ -0,0 +1,160 @@
+/*
+ * File:   bench_profiler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 4:40 PM
+ *
+ * Execution time profile of the simulated voltage loop interrupt service routine using the
+ * firmware profiler (profiler.h/profiler.c) compiled unchanged for the host.
+ *
+ * The simulated interrupt service routine executes the same controller calls as 
+ * _VOUT_ADCInterrupt (npnz16b_CommitCoefficients(), c2p2z_Update() and, with USE_DATA_RECORDER
+ * enabled, data_recorder_capture() in channel PROF_RECORDER, with USE_EVENT_LOG enabled, 
+ * event_log_saturation()) enclosed by 
+ * PROFILER_ENTER/PROFILER_EXIT(PROF_VOUT_ISR). The bench collects the execution time of every
+ * call from the profiler statistics and prints minimum, median and mean in host ticks together 
+ * with the median load relative to the switching period, which is the sampling period of the 
+ * voltage loop.
+ *
+ * Usage: bench_profiler [-n samples] [-l max_load]
+ *
+ *    -n  number of simulated interrupts (default 1000000)
+ *    -l  fail (exit code 1) if the median load of any channel exceeds max_load percent of 
+ *        the sampling period
+ *
+ * Please note:
+ * Host ticks measure host execution time scaled to 100 MHz, they are not device instruction 
+ * cycles. Results are only meant to track relative changes between builds on the same host.
+ * Maximum and mean values include operating system preemption, so neither the maximum nor a
+ * headroom is reported, and the gate uses the median. The headroom of the device has to be
+ * taken from the profiler maximum on the target.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "c2p2z.h"
+#include "globals.h"
+#include "profiler.h"
+#include "data_recorder.h"
+#include "event_log.h"
+
+#define BENCH_DEFAULT_SAMPLES   1000000UL
+#define BENCH_ISR_PERIOD        (uint16_t)(CPU_FREQUENCY / SWITCHING_FREQUENCY) // sampling period in [ticks]
+
+volatile uint16_t bench_source = 0;
+volatile uint16_t bench_target = 0;
+volatile uint16_t bench_reference = 2755;
+volatile uint16_t bench_trigger = 0;
+
+static const char* channel_name[PROF_CHANNEL_COUNT] = { "VOUT_ISR", "VREF_ISR", "PWR_CONTROL", "VOUT_LATENCY", "RECORDER" };
+
+static uint32_t lcg_state = 0x12345678;
+static uint32_t distribution[PROF_CHANNEL_COUNT][65536]; // number of calls per execution time in [ticks]
+
+/*!bench_vout_isr
+ * *************************************************************************************************
+ * Simulated _VOUT_ADCInterrupt
+ * *************************************************************************************************/
+static void bench_vout_isr(uint16_t sample)
+{
+    PROFILER_ENTER(PROF_VOUT_ISR);
+
+    bench_source = sample;
+    npnz16b_CommitCoefficients(&c2p2z);
+    c2p2z_Update(&c2p2z);
+
+    PROFILER_SPLIT(PROF_VOUT_ISR, PROF_VOUT_LATENCY);
+
+    #if (USE_DATA_RECORDER == true)
+    PROFILER_ENTER(PROF_RECORDER);
+    data_recorder_capture();
+    PROFILER_EXIT(PROF_RECORDER);
+    #endif
+
+    #if (USE_EVENT_LOG == true)
+    event_log_saturation();
+    #endif
+
+    PROFILER_EXIT(PROF_VOUT_ISR);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t samples = BENCH_DEFAULT_SAMPLES;
+    uint32_t n, calls[PROF_CHANNEL_COUNT], sum;
+    uint32_t median;
+    double max_load = 0.0, load;
+    uint16_t ch;
+    int i, result = 0;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+            samples = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+            max_load = strtod(argv[++i], NULL);
+        else {
+            fprintf(stderr, "usage: %s [-n samples] [-l max_load]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    c2p2z_Init();
+    c2p2z.ptrSource = &bench_source;
+    c2p2z.ptrTarget = &bench_target;
+    c2p2z.ptrControlReference = &bench_reference;
+    c2p2z.ptrADCTriggerRegister = &bench_trigger;
+    c2p2z.MinOutput = 806;
+    c2p2z.MaxOutput = 3847;
+    c2p2z.status.bits.enable = 1;
+
+    profiler_init();
+    data_recorder_init();
+    event_log_init();
+
+    for (ch = 0; ch < PROF_CHANNEL_COUNT; ch++)
+        calls[ch] = 0;
+
+    for (n = 0; n < samples; n++) {
+        lcg_state = lcg_state * 1664525UL + 1013904223UL;
+        bench_vout_isr((uint16_t)(2755 + ((lcg_state >> 24) & 0x3F) - 32));
+
+        // Collect the execution time of each channel recorded by this call
+        for (ch = 0; ch < PROF_CHANNEL_COUNT; ch++) {
+            if (profiler[ch].calls != calls[ch]) {
+                calls[ch] = profiler[ch].calls;
+                distribution[ch][profiler[ch].last]++;
+            }
+        }
+    }
+
+    printf("sampling period: %u ticks (host ticks are not device instruction cycles)\n\n", BENCH_ISR_PERIOD);
+    printf("channel       calls      min  median   mean   median load [%%]\n");
+
+    for (ch = 0; ch < PROF_CHANNEL_COUNT; ch++) {
+
+        if (calls[ch] == 0)
+            continue;
+
+        // Median of the collected execution times
+        sum = 0;
+        for (median = 0; median < 65535; median++) {
+            sum += distribution[ch][median];
+            if (sum >= ((calls[ch] + 1) / 2))
+                break;
+        }
+
+        load = 100.0 * (double)median / (double)BENCH_ISR_PERIOD;
+        printf("%-12s %7u   %5u   %5u  %5u   %14.1f\n", channel_name[ch], calls[ch],
+            profiler[ch].min, median, profiler[ch].mean, load);
+
+        if ((max_load > 0.0) && (load > max_load)) {
+            fprintf(stderr, "%s: median load of %.1f%% exceeds limit of %.1f%%\n", channel_name[ch], load, max_load);
+            result = 1;
+        }
+    }
+
+    return(result);
+}
@@ -0,0 +1,146 @@
+/*
+ * File:   decode_recorder.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 2:50 PM
+ *
+ * Decoder of the data recorder (data_recorder.h) memory image.
+ *
+ * The input file is the binary image of the data recorder object 'data_recorder' as read from
+ * the device memory by the debugger or written by sim_qr_flyback -r. The samples of the
+ * circular buffer are ordered from the oldest sample ('index') to the newest and converted
+ * into physical units:
+ *
+ *    time      time of the sample relative to the trigger sample, accumulated from the recorded
+ *              switching periods [usec]
+ *    vout      output voltage [V]
+ *    reference control reference converted into output voltage [V]
+ *    ctrl_out  compensator output converted into DAC output voltage [V]
+ *    dac       peak current reference (DAC output voltage) [V]
+ *    period    switching period [usec]
+ *
+ * A summary of the recording is printed to stdout, the samples are written into a CSV file.
+ *
+ * Usage: decode_recorder file [-o csv]
+ *
+ *    -o  write the decoded samples into a CSV file (default: stdout)
+ *
+ * The exit code is 1 if the recording has not been completed (no trigger event), 2 if the
+ * file is not a valid data recorder image of this firmware build.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "globals.h"
+#include "data_recorder.h"
+
+#define DECODE_VOUT_SCALE   ((double)ADC_GRAN / (double)VOUT_FB_GAIN)  // output voltage in [V/tick]
+
+static const char* state_name[] = { "IDLE", "COMPLETE", "ARM", "PRETRIGGER", "ARMED", "TRIGGERED" };
+static const char* source_name[] = { "FAULT", "SATURATION", "STATE", "VOUT_ABOVE", "VOUT_BELOW" };
+
+static DATA_RECORDER_t image;
+static double sample_time[DATA_RECORDER_DEPTH];
+
+int main(int argc, char** argv)
+{
+    const char *in_file = NULL, *csv_file = NULL;
+    volatile DATA_RECORDER_SAMPLE_t *sample;
+    FILE *f, *csv;
+    uint16_t k, pos, trig_pos;
+    double v_min, v_max, v_out;
+    int i, bit;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) csv_file = argv[++i];
+        else if ((argv[i][0] != '-') && (in_file == NULL)) in_file = argv[i];
+        else {
+            fprintf(stderr, "usage: %s file [-o csv]\n", argv[0]);
+            return(2);
+        }
+    }
+    if (in_file == NULL) {
+        fprintf(stderr, "usage: %s file [-o csv]\n", argv[0]);
+        return(2);
+    }
+
+    f = fopen(in_file, "rb");
+    if (f == NULL) { fprintf(stderr, "cannot open %s\n", in_file); return(2); }
+    if ((fread((void*)&image, sizeof(image), 1, f) != 1) || (fgetc(f) != EOF)) {
+        fprintf(stderr, "%s: size does not match the data recorder of this build (%u bytes)\n",
+            in_file, (unsigned)sizeof(image));
+        fclose(f);
+        return(2);
+    }
+    fclose(f);
+
+    if ((image.depth != DATA_RECORDER_DEPTH) || (image.pretrigger != DATA_RECORDER_PRETRIGGER) ||
+        (image.state > REC_TRIGGERED) || (image.index > DATA_RECORDER_MASK) ||
+        (image.trigger > DATA_RECORDER_MASK)) {
+        fprintf(stderr, "%s: not a valid data recorder image of this build\n", in_file);
+        return(2);
+    }
+
+    printf("state:      %s\n", state_name[image.state]);
+    printf("trigger:   ");
+    for (bit = 0; bit < 5; bit++)
+        if (image.source & (1 << bit)) printf(" %s", source_name[bit]);
+    printf("%s\n", (image.source == REC_TRIG_NONE) ? " none" : "");
+
+    if (image.state != REC_COMPLETE) {
+        fprintf(stderr, "%s: recording not completed\n", in_file);
+        return(1);
+    }
+
+    // Time axis: accumulated switching periods relative to the trigger sample
+    trig_pos = (uint16_t)((image.trigger - image.index) & DATA_RECORDER_MASK);
+    sample_time[trig_pos] = 0.0;
+    for (k = trig_pos + 1; k < DATA_RECORDER_DEPTH; k++) {
+        pos = (uint16_t)((image.index + k - 1) & DATA_RECORDER_MASK);
+        sample_time[k] = sample_time[k - 1] + (double)image.buffer[pos].period * PWM_RES;
+    }
+    for (k = trig_pos; k > 0; k--) {
+        pos = (uint16_t)((image.index + k - 1) & DATA_RECORDER_MASK);
+        sample_time[k - 1] = sample_time[k] - (double)image.buffer[pos].period * PWM_RES;
+    }
+
+    v_min = 1.0e9; v_max = -1.0e9;
+    for (k = trig_pos; k < DATA_RECORDER_DEPTH; k++) {
+        v_out = (double)image.buffer[(image.index + k) & DATA_RECORDER_MASK].v_out * DECODE_VOUT_SCALE;
+        if (v_out < v_min) v_min = v_out;
+        if (v_out > v_max) v_max = v_out;
+    }
+
+    sample = &image.buffer[image.trigger];
+    printf("samples:    %u (%u before trigger)\n", DATA_RECORDER_DEPTH, trig_pos);
+    printf("window:     %.1f ... %.1f usec\n", sample_time[0] * 1.0e6,
+        sample_time[DATA_RECORDER_DEPTH - 1] * 1.0e6);
+    printf("at trigger: vout %.3f V, reference %.3f V, dac %.3f V\n",
+        (double)sample->v_out * DECODE_VOUT_SCALE, (double)sample->reference * DECODE_VOUT_SCALE,
+        (double)sample->dac * DAC_GRAN);
+    printf("post-trig:  vout %.3f ... %.3f V\n", v_min, v_max);
+
+    if (csv_file != NULL) {
+        csv = fopen(csv_file, "w");
+        if (csv == NULL) { fprintf(stderr, "cannot open %s\n", csv_file); return(2); }
+    }
+    else
+        csv = stdout;
+
+    fprintf(csv, "sample,time_us,vout,reference,ctrl_out,dac,period_us\n");
+    for (k = 0; k < DATA_RECORDER_DEPTH; k++) {
+        sample = &image.buffer[(image.index + k) & DATA_RECORDER_MASK];
+        fprintf(csv, "%d,%.3f,%.4f,%.4f,%.4f,%.4f,%.3f\n", (int)k - (int)trig_pos,
+            sample_time[k] * 1.0e6, (double)sample->v_out * DECODE_VOUT_SCALE,
+            (double)sample->reference * DECODE_VOUT_SCALE, (double)sample->ctrl_out * DAC_GRAN,
+            (double)sample->dac * DAC_GRAN, (double)sample->period * PWM_RES * 1.0e6);
+    }
+
+    if (csv != stdout) fclose(csv);
+
+    return(0);
+}
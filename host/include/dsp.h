@@ -0,0 +1,18 @@
+/* 
+ * File:   dsp.h
+ * Author: M91406
+ * Comments: host stand-in for the XC16 DSP library header
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This header replaces <dsp.h> of the XC16 tool chain when firmware sources are 
+// compiled on the host. Only the type definitions used by the firmware are provided.
+#ifndef HOST_DSP_LIBRARY_HEADER_H
+#define	HOST_DSP_LIBRARY_HEADER_H
+
+#include <stdint.h>
+
+typedef int16_t fractional;     // Q15 fractional number (1.15 format)
+
+#endif	/* HOST_DSP_LIBRARY_HEADER_H */
@@ -0,0 +1,201 @@
+/* 
+ * File:   xc.h
+ * Author: M91406
+ * Comments: host stand-in for the XC16 device header
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This header replaces <xc.h> of the XC16 tool chain when firmware sources are 
+// compiled on the host (x86/ARM Linux). Special Function Registers (SFRs) accessed 
+// by the firmware are declared as plain RAM variables defined in src/sfr_host.c. 
+// XC16-specific attributes are mapped onto GCC attributes without side effects.
+#ifndef HOST_XC_DEVICE_HEADER_H
+#define	HOST_XC_DEVICE_HEADER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!XC16 Attribute Stand-Ins
+ * *************************************************************************************************
+ * Memory space qualifiers and interrupt attributes are meaningless on the host. They are 
+ * replaced by neutral GCC attributes so firmware declarations compile unchanged.
+ * *************************************************************************************************/
+    
+#define space(x)        __unused__
+#define near            __unused__
+#define far             __unused__
+#define auto_psv        __unused__
+#define no_auto_psv     __unused__
+#define context         __unused__
+#define __interrupt__   __used__
+
+#define Nop()           { __asm__ volatile ("nop"); }
+
+/*!XC16 Built-In Function Stand-Ins
+ * *************************************************************************************************
+ * Arithmetic built-ins of XC16 are implemented in plain C with identical results.
+ * *************************************************************************************************/
+
+static inline uint32_t __builtin_muluu(uint16_t a, uint16_t b) { return((uint32_t)a * (uint32_t)b); }
+static inline uint16_t __builtin_divud(uint32_t n, uint16_t d) { return((uint16_t)(n / d)); }
+
+/*!Interrupt Control Stand-Ins
+ * *************************************************************************************************
+ * Interrupts of the host build are called sequentially by the simulator and cannot preempt each
+ * other. The DISI instruction is reduced to writing its count into the DISICNT stand-in.
+ * *************************************************************************************************/
+
+extern volatile uint16_t DISICNT;       // DISI instruction count
+#define __builtin_disi(count)   { DISICNT = (count); }
+
+/*!DSP Engine Registers
+ * *************************************************************************************************
+ * CORCON is evaluated by the DSP engine emulation (see src/dsp_engine.h) to select 
+ * accumulator saturation, data space write saturation and rounding modes.
+ * *************************************************************************************************/
+
+extern volatile uint16_t CORCON;
+
+/*!Power Converter Peripheral Registers
+ * *************************************************************************************************
+ * Registers of PWM, DAC/comparator and ADC accessed by the power controller sources. They are
+ * written by the firmware and by the host replacements of the peripheral initialization 
+ * routines (src/periph_host.c) and evaluated by the plant model of the closed-loop simulator.
+ * *************************************************************************************************/
+
+typedef struct {
+    uint16_t OVRDAT :2;     // Data for PWMxH/PWMxL pins if override is enabled
+    uint16_t        :8;
+    uint16_t OVRENL :1;     // User Override Enable for PWMxL pin
+    uint16_t OVRENH :1;     // User Override Enable for PWMxH pin
+    uint16_t        :4;
+} PGxIOCONLBITS;
+
+typedef struct {
+    uint16_t TRIG   :1;
+    uint16_t CAHALF :1;
+    uint16_t STEER  :1;
+    uint16_t UPDREQ :1;     // Update Request (buffered registers are transferred at the next update point)
+    uint16_t UPDATE :1;     // PWM data register update pending
+    uint16_t        :11;
+} PGxSTATBITS;
+
+typedef struct {
+    uint16_t        :7;
+    uint16_t SWPCI  :1;     // Software PCI control bit (drives the PCI acceptance logic)
+    uint16_t        :8;
+} PGxyPCIHBITS;
+
+typedef struct {
+    uint16_t        :7;
+    uint16_t SWTERM :1;     // PCI Software Termination (write '1' to terminate a latched PCI, reads '0')
+    uint16_t        :8;
+} PGxyPCILBITS;
+
+extern volatile uint16_t MPER;          // PWM master period
+extern volatile uint16_t PG1PER;        // PWM generator 1 period
+extern volatile uint16_t PG1DC;         // PWM generator 1 duty cycle
+extern volatile PGxIOCONLBITS PG1IOCONLbits; // PWM generator 1 I/O control
+extern volatile PGxSTATBITS PG1STATbits; // PWM generator 1 status
+extern volatile PGxSTATBITS PG2STATbits; // PWM generator 2 status
+extern volatile PGxyPCIHBITS PG1FPCIHbits; // PWM generator 1 fault PCI high
+extern volatile PGxyPCILBITS PG1FPCILbits; // PWM generator 1 fault PCI low
+extern volatile uint16_t PG2TRIGA;      // PWM generator 2 trigger A (ADC trigger)
+
+extern volatile uint16_t DAC1DATH;      // DAC1 data (comparator reference)
+extern volatile uint16_t DAC1DATL;      // DAC1 low data
+extern volatile uint16_t SLP1DAT;       // DAC1 slope compensation rate
+
+extern volatile uint16_t ADCBUF6;       // ADC result of AN6 (external reference)
+extern volatile uint16_t ADCBUF12;      // ADC result of AN12 (input voltage)
+extern volatile uint16_t ADCBUF16;      // ADC result of AN16 (output voltage)
+
+extern volatile uint16_t ADFL0DAT;      // ADC digital filter 0 result
+extern volatile uint16_t ADFL1DAT;      // ADC digital filter 1 result
+extern volatile uint16_t ADFL2DAT;      // ADC digital filter 2 result
+extern volatile uint16_t ADFL3DAT;      // ADC digital filter 3 result
+
+extern volatile uint16_t _ADCAN6IF;     // AN6 interrupt flag bit
+extern volatile uint16_t _ADCAN6IE;     // AN6 interrupt enable bit
+extern volatile uint16_t _ADCAN16IF;    // AN16 interrupt flag bit
+
+/*!ADC Digital Comparator Registers
+ * *************************************************************************************************
+ * Control and threshold registers and interrupt bits of the ADC digital comparators ADCMP0...3.
+ * The comparators are emulated by host_adc_comparator_trigger() (src/periph_host.c).
+ * *************************************************************************************************/
+
+typedef struct {
+    uint16_t LOLO   :1;     // Low/Low comparator event (result < ADCMPxLO)
+    uint16_t LOHI   :1;     // Low/High comparator event (result >= ADCMPxLO)
+    uint16_t HILO   :1;     // High/Low comparator event (result < ADCMPxHI)
+    uint16_t HIHI   :1;     // High/High comparator event (result >= ADCMPxHI)
+    uint16_t BTWN   :1;     // Between low/high comparator event (ADCMPxLO <= result < ADCMPxHI)
+    uint16_t STAT   :1;     // Comparator event status
+    uint16_t IE     :1;     // Common ADC interrupt enable
+    uint16_t CMPEN  :1;     // Comparator enable
+    uint16_t CHNL   :5;     // Input channel number of the last event
+    uint16_t        :3;
+} ADCMPxCONBITS;
+
+extern volatile ADCMPxCONBITS ADCMP0CONbits; // ADC digital comparator 0 control
+extern volatile ADCMPxCONBITS ADCMP1CONbits; // ADC digital comparator 1 control
+extern volatile ADCMPxCONBITS ADCMP2CONbits; // ADC digital comparator 2 control
+extern volatile ADCMPxCONBITS ADCMP3CONbits; // ADC digital comparator 3 control
+extern volatile uint16_t ADCMP0LO;      // ADC digital comparator 0 lower threshold
+extern volatile uint16_t ADCMP0HI;      // ADC digital comparator 0 upper threshold
+extern volatile uint16_t ADCMP1LO;      // ADC digital comparator 1 lower threshold
+extern volatile uint16_t ADCMP1HI;      // ADC digital comparator 1 upper threshold
+extern volatile uint16_t ADCMP2LO;      // ADC digital comparator 2 lower threshold
+extern volatile uint16_t ADCMP2HI;      // ADC digital comparator 2 upper threshold
+extern volatile uint16_t ADCMP3LO;      // ADC digital comparator 3 lower threshold
+extern volatile uint16_t ADCMP3HI;      // ADC digital comparator 3 upper threshold
+
+extern volatile uint16_t _ADCMP0IF;     // ADC digital comparator 0 interrupt flag bit
+extern volatile uint16_t _ADCMP0IE;     // ADC digital comparator 0 interrupt enable bit
+extern volatile uint16_t _ADCMP1IF;     // ADC digital comparator 1 interrupt flag bit
+extern volatile uint16_t _ADCMP1IE;     // ADC digital comparator 1 interrupt enable bit
+extern volatile uint16_t _ADCMP2IF;     // ADC digital comparator 2 interrupt flag bit
+extern volatile uint16_t _ADCMP2IE;     // ADC digital comparator 2 interrupt enable bit
+extern volatile uint16_t _ADCMP3IF;     // ADC digital comparator 3 interrupt flag bit
+extern volatile uint16_t _ADCMP3IE;     // ADC digital comparator 3 interrupt enable bit
+
+/*!DMA Controller Registers
+ * *************************************************************************************************
+ * Destination address registers of the DMA channels capturing the monitoring ADC inputs (see 
+ * init_dma.c). The DMA transfers are emulated by host_dma_trigger() (src/periph_host.c), which 
+ * writes the lower 16 bits of the host address of the next destination location.
+ * *************************************************************************************************/
+
+extern volatile uint16_t DMADST0;       // DMA channel 0 destination address (input voltage)
+extern volatile uint16_t DMADST1;       // DMA channel 1 destination address (external reference)
+
+/*!Scheduler Time Base
+ * *************************************************************************************************
+ * Timer1 counter and interrupt flag bit read by scheduler_timestamp() (see scheduler.h). The 
+ * closed-loop simulator advances the tick count and writes the cycle position within the tick.
+ * *************************************************************************************************/
+
+extern volatile uint16_t TMR1;          // Timer1 counter
+extern volatile uint16_t _T1IF;         // Timer1 interrupt flag bit
+
+/*!Profiler Time Base
+ * *************************************************************************************************
+ * The free-running SCCP1 timer used by the execution time profiler (see profiler.h) is replaced 
+ * by the host monotonic clock, scaled to ticks of the device instruction clock (100 MHz). Host 
+ * ticks therefore measure host execution time in device time units, not device cycles.
+ * *************************************************************************************************/
+
+extern uint16_t host_timer_ticks(void);
+#define CCP1TMRL        host_timer_ticks()
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* HOST_XC_DEVICE_HEADER_H */
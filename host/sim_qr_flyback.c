@@ -0,0 +1,677 @@
+/*
+ * File:   sim_qr_flyback.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 6:40 PM
+ *
+ * Closed-loop simulator of the QR-mode flyback converter driven by the unchanged firmware 
+ * sources pwr_control.c, task_external_reference.c, task_monitor.c, task_gain_scheduler.c, 
+ * task_valley_control.c, task_slope_control.c, task_line_feedforward.c, fault_handler.c, 
+ * data_recorder.c, event_log.c, c2p2z.c and profiler.c.
+ *
+ * The plant (src/flyback_model.c) is computed once per switching cycle using the registers 
+ * written by the firmware (MPER, PG1DC, PG1IOCONL, DAC1DATH, SLP1DAT). At the end of every 
+ * cycle the ADC results of AN16 (output voltage), AN12 (input voltage) and AN6 (external
+ * reference) are updated, the emulated ADC digital filters and digital comparators are 
+ * triggered and the ADC interrupt service routines are called. The fault interrupts of the
+ * digital comparators are called before the voltage loop interrupt, as on the device (higher 
+ * priority). The PWM output does not switch while the emulated fault PCI is latched. When USE_DMA_MONITORING is enabled, AN12 and AN6 are captured 
+ * by the emulated DMA channels (see periph_host.h) instead of the AN6 interrupt service routine. 
+ * The tasks of the scheduler task table (exec_pwr_control(), monitor_exec(), 
+ * ext_reference_exec(), gain_scheduler_exec(), valley_control_exec(), slope_control_exec(), 
+ * line_feedforward_exec()) are called every MAIN_EXECUTION_PERIOD of simulated time. The 
+ * switching period follows MPER cycle by cycle.
+ *
+ * Each scenario of the scenario table is simulated from power-up (SS_INIT), its times are 
+ * counted from the end of the power-on delay (POWER_ON_DELAY). It is reported by:
+ *
+ *    startup   time from PWM output enable until the output reaches 90% of its final value [ms]
+ *    overshoot maximum output voltage above the final value after startup [%]
+ *    settling  time from PWM output enable until the output remains within +/-2% of its 
+ *              final value [ms]
+ *    vout      final output voltage (average over the last 20 ms before a load or line step or
+ *              the end of the run) [V]
+ *    ripple    peak-to-peak variation of the output voltage sampled once per switching cycle
+ *              within the same window [mV] (ripple within a switching cycle is not modeled)
+ *    step_dv   maximum output voltage deviation after the load or line step [%] (step scenarios)
+ *    recovery  time from the step until the output remains within +/-2% of its new final
+ *              value [ms] (step scenarios)
+ *    valley    average number of the drain voltage valley closest to turn-on
+ *    vds_on    average drain voltage at turn-on [V]
+ *    ccm       share of continuous conduction mode cycles [%]
+ *    fsw       average switching frequency, counting cycles with the PWM output switching [kHz]
+ *    psw       average capacitive turn-on loss 1/2 x Coss x vds_on^2 x fsw [mW]
+ *    pin       average input power including gate drive (Qg x Vdrv x fsw) and capacitive 
+ *              turn-on loss [mW]
+ *    trip      fault reaction time from the first out-of-range ADC sample (digital comparator 
+ *              event) until the first switching cycle without PWM output [switching cycles]
+ *    faults    number of fault shutdowns
+ *    dip       maximum output voltage drop below its value at PWM output enable until the 
+ *              startup time has been reached [%] (pre-biased output)
+ *
+ * Metrics which could not be determined are reported as -1.
+ *
+ * Option -l runs a light-load sweep instead of the scenario table: the converter is simulated at
+ * the output power levels of the sweep table and output voltage, ripple, switching frequency 
+ * and input power are reported per load. Running the sweep with the burst mode enabled and 
+ * disabled (build/sim_qr_flyback_noburst, compiled with -DUSE_BURST_MODE=false) compares 
+ * standby power versus output ripple.
+ *
+ * Option -r writes the data recorder object (data_recorder.h) into a binary file after the last
+ * simulated scenario. The file is the memory image of DATA_RECORDER_t as read from the device by
+ * the debugger and is decoded by decode_recorder.
+ *
+ * Option -e lists the event log of the firmware (event_log.h) after each scenario. Time stamps
+ * are taken from the scheduler tick count and the Timer1 counter, both emulated by the
+ * simulator from the simulated time.
+ *
+ * Usage: sim_qr_flyback [-s scenario] [-d file] [-k decimation] [-b baseline] [-w baseline] [-r file] [-e] [-l]
+ *
+ *    -s  run only the given scenario
+ *    -d  write the waveforms of the simulated scenario(s) into a CSV file
+ *    -k  write every k-th switching cycle into the CSV file (default 10)
+ *    -b  compare the results against a baseline file (exit code 1 on any deviation)
+ *    -w  write the results into a baseline file
+ *    -r  write the data recorder image into a binary file
+ *    -e  list the event log after each scenario
+ *    -l  run the light-load sweep
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "globals.h"
+#include "profiler.h"
+#include "task_monitor.h"
+#include "task_valley_control.h"
+#include "task_slope_control.h"
+#include "task_line_feedforward.h"
+#include "fault_handler.h"
+#include "data_recorder.h"
+#include "event_log.h"
+#include "scheduler.h"
+#include "periph_host.h"
+#include "flyback_model.h"
+
+#define SIM_WINDOW              20.0e-3 // averaging window of final values in [sec]
+#define SIM_BAND                0.02    // settling band (+/-2%)
+#define SIM_MAX_RESULTS         16      // maximum number of scenarios in a baseline file
+#define SIM_TOLERANCE_REL       0.02    // relative tolerance of the baseline comparison
+#define SIM_TOLERANCE_ABS       0.05    // absolute tolerance of the baseline comparison
+#define SIM_T_START             POWER_ON_DELAY  // scenario times are counted from the end of the power-on delay in [sec]
+
+/* Interrupt service routines of the firmware */
+extern void _VOUT_ADCInterrupt(void);
+extern void _ADCAN6Interrupt(void);
+extern void _VIN_FAULTInterrupt(void);
+extern void _VOUT_FAULTInterrupt(void);
+
+typedef struct {
+    const char* name;       // scenario name
+    double vin;             // input voltage in [V]
+    double r_load;          // load resistance in [Ohm]
+    double v_set;           // output voltage set by the external reference input in [V]
+    double duration;        // simulated time after the power-on delay in [sec]
+    double t_step;          // time of the load or line step after the power-on delay in [sec] (0 = no step)
+    double r_step;          // load resistance after the step in [Ohm] (0 = unchanged)
+    double vin_step;        // input voltage after the step in [V] (0 = unchanged)
+    double t_revert;        // time after the power-on delay at which load and input voltage return to their initial values in [sec] (0 = never)
+    double v_init;          // output voltage held until the PWM output starts (pre-biased output) in [V]
+}SIM_SCENARIO_t;
+
+static const SIM_SCENARIO_t scenarios[] = {
+    //  name            vin     r_load  v_set           duration    t_step  r_step  vin_step  t_revert  v_init
+    { "nominal",        12.0,   30.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "low_line",        9.0,   30.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "high_line",      18.0,   30.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "light_load",     12.0,  150.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "load_step",      12.0,   60.0,   VOUT_NOMINAL,   1.0,        0.6,   30.0,    0.0,      0.0,    0.0  },
+    { "load_jump",      12.0,  100.0,   VOUT_NOMINAL,   1.0,        0.6,   30.0,    0.0,      0.0,    0.0  },
+    { "sat_recovery",    9.0,   12.0,   VOUT_NOMINAL,   1.0,        0.6,   30.0,    0.0,      0.0,    0.0  },
+    { "standby",        12.0, 1500.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "max_load",        9.0,   25.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,    0.0  },
+    { "line_step_up",    9.0,   30.0,   VOUT_NOMINAL,   1.0,        0.6,    0.0,   18.0,      0.0,    0.0  },
+    { "line_step_dn",   18.0,   30.0,   VOUT_NOMINAL,   1.0,        0.6,    0.0,    9.0,      0.0,    0.0  },
+    { "brown_out",      12.0,   30.0,   VOUT_NOMINAL,   1.2,        0.4,    0.0,    7.0,      0.45,   0.0  },
+    { "short_circ",     12.0,   30.0,   VOUT_NOMINAL,   1.2,        0.4,    1.0,    0.0,      0.55,   0.0  },
+    { "prebias",        12.0,   30.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,   10.0  },
+    { "prebias_light",  12.0,  150.0,   VOUT_NOMINAL,   1.0,        0.0,    0.0,    0.0,      0.0,   10.0  },
+    { "prebias_zero",   12.0,   30.0,   0.0,            1.0,        0.0,    0.0,    0.0,      0.0,   10.0  }
+};
+
+#define SIM_SCENARIO_COUNT  (sizeof(scenarios)/sizeof(scenarios[0]))
+#define SIM_METRIC_COUNT    16
+
+static const char* metric_names[SIM_METRIC_COUNT] = 
+    { "startup", "overshoot", "settling", "vout", "ripple", "step_dv", "recovery", "valley", "vds_on", "ccm", 
+      "fsw", "psw", "pin", "trip", "faults", "dip" };
+
+/* Output power levels of the light-load sweep at nominal output voltage in [W] */
+static const double sweep_power[] = { 3.0, 1.5, 0.75, 0.30, 0.15, 0.05 };
+
+#define SIM_SWEEP_COUNT     (sizeof(sweep_power)/sizeof(sweep_power[0]))
+#define SIM_SWEEP_VIN       12.0    // input voltage of the light-load sweep in [V]
+#define SIM_SWEEP_DURATION  1.0     // simulated time per load level in [sec]
+
+typedef struct {
+    char name[32];
+    double metric[SIM_METRIC_COUNT];
+}SIM_RESULT_t;
+
+/*!sim_adc_ticks
+ * *************************************************************************************************
+ * Converts a voltage at an ADC input into ADC ticks
+ * *************************************************************************************************/
+static uint16_t sim_adc_ticks(double v_pin)
+{
+    double ticks = floor(v_pin / ADC_GRAN);
+
+    if (ticks < 0.0) ticks = 0.0;
+    if (ticks > 4095.0) ticks = 4095.0;
+
+    return((uint16_t)ticks);
+}
+
+/*!sim_firmware_reset
+ * *************************************************************************************************
+ * Brings the firmware data objects into their power-up state (see main())
+ * *************************************************************************************************/
+static void sim_firmware_reset(void)
+{
+    memset((void*)&converter, 0, sizeof(converter));
+    memset((void*)&c2p2z, 0, sizeof(c2p2z));
+
+    host_peripherals_reset();
+    profiler_init();
+    init_vin_adc();
+    ext_reference_init();
+    #if (USE_DMA_MONITORING == true)
+    monitor_init();
+    #endif
+    gain_scheduler_init();
+    valley_control_init();
+    slope_control_init();
+    line_feedforward_init();
+    fault_handler_init();
+    data_recorder_init();
+    event_log_init();
+
+    converter.soft_start.phase = SS_INIT;
+    converter.status.flags.auto_start = true;
+}
+
+/*!sim_window_start
+ * *************************************************************************************************
+ * Index of the first cycle of the averaging window ending at cycle 'last'
+ * *************************************************************************************************/
+static uint32_t sim_window_start(const double* t, uint32_t first, uint32_t last)
+{
+    uint32_t i = last;
+
+    while ((i > first) && ((t[last - 1] - t[i - 1]) < SIM_WINDOW))
+        i--;
+
+    return(i);
+}
+
+/*!sim_window_stats
+ * *************************************************************************************************
+ * Average and peak-to-peak value of the output voltage trace within [first, last)
+ * *************************************************************************************************/
+static void sim_window_stats(const float* v, uint32_t first, uint32_t last, double* mean, double* ptp)
+{
+    uint32_t i;
+    double sum = 0.0, vmin = 1e9, vmax = -1e9;
+
+    for (i = first; i < last; i++) {
+        sum += v[i];
+        if (v[i] < vmin) vmin = v[i];
+        if (v[i] > vmax) vmax = v[i];
+    }
+
+    *mean = (last > first) ? (sum / (double)(last - first)) : 0.0;
+    *ptp = (last > first) ? (vmax - vmin) : 0.0;
+}
+
+/* Time after 'first' until the trace remains within the settling band around 'v_final' */
+static double sim_settling(const float* v, const double* t, uint32_t first, uint32_t last, double v_final)
+{
+    uint32_t i, settled = first;
+
+    for (i = first; i < last; i++)
+        if (fabs(v[i] - v_final) > (SIM_BAND * v_final)) settled = i + 1;
+
+    return((settled < last) ? ((t[settled] - t[first]) * 1.0e3) : -1.0);
+}
+
+/*!sim_run
+ * *************************************************************************************************
+ * Simulates one scenario and evaluates its metrics
+ * *************************************************************************************************/
+static int sim_run(const SIM_SCENARIO_t* sc, FILE* dump, uint32_t decimation, SIM_RESULT_t* result)
+{
+    FLYBACK_PARAMETERS_t par;
+    FLYBACK_STATE_t plant;
+    FLYBACK_DRIVE_t drive;
+    float* vout;
+    double* time;
+    uint32_t n, cycles, cycles_max, n_enable = 0, n_step = 0, n_end, n_valley = 0, n_ccm = 0, n_switch = 0;
+    uint32_t n_detect = 0, n_trip = 0;
+    double t = 0.0, t_task = 0.0, period, v_final, v_post, ptp, v_peak, dv, sum_valley = 0.0, sum_vds = 0.0;
+    double sum_period = 0.0, sum_esw = 0.0, sum_ein = 0.0, e_sw, duration;
+    bool enabled = false, reverted = false;
+
+    flyback_default_parameters(&par);
+    flyback_reset(&plant, sc->vin, sc->r_load);
+    plant.vout = sc->v_init;
+    sim_firmware_reset();
+
+    period = (double)((PWM_PERIOD < VALLEY_PERIOD_MIN) ? PWM_PERIOD : VALLEY_PERIOD_MIN) * PWM_RES;
+    duration = sc->duration + SIM_T_START;
+    cycles_max = (uint32_t)(duration / period) + 1;
+    vout = (float*)malloc(cycles_max * sizeof(float) + 1);
+    time = (double*)malloc(cycles_max * sizeof(double) + 1);
+    if ((vout == NULL) || (time == NULL)) { free(vout); free(time); return(-1); }
+
+    for (n = 0; (n < cycles_max) && (t < duration); n++) {
+
+        // Load or line step
+        if ((sc->t_step > 0.0) && (t >= (sc->t_step + SIM_T_START)) && (n_step == 0)) {
+            if (sc->r_step > 0.0) plant.r_load = sc->r_step;
+            if (sc->vin_step > 0.0) plant.vin = sc->vin_step;
+            n_step = n;
+        }
+        if ((sc->t_revert > 0.0) && (t >= (sc->t_revert + SIM_T_START)) && (!reverted)) {
+            plant.r_load = sc->r_load;
+            plant.vin = sc->vin;
+            reverted = true;
+        }
+
+        // Power stage: registers of PWM and comparator/DAC applied to one switching cycle
+        period = ((MPER > 0) ? (double)MPER : (double)PWM_PERIOD) * PWM_RES;
+        drive.period = period;
+        drive.t_on_max = (double)PG1DC * PWM_RES;
+        drive.t_leb = LEB_PERIOD;
+        drive.v_dac = (double)(DAC1DATH & 0x0FFF) * DAC_GRAN;
+        drive.slope = ((double)SLP1DAT / 16.0) * DAC_GRAN / DACCLK;
+        drive.t_slope = SLOPE_START_DELAY;
+        drive.enabled = (host_peripherals.pwm_running && host_peripherals.acmp_running && (!PG1IOCONLbits.OVRENH) &&
+                         (!host_pwm_fault_update()));
+        if ((n_detect > 0) && (n_trip == 0) && (!drive.enabled)) n_trip = n;
+
+        if ((drive.enabled) && (!enabled)) n_enable = n;
+        enabled |= drive.enabled;
+        if ((!enabled) && (sc->v_init > 0.0)) plant.vout = sc->v_init; // Output held until the PWM output starts
+
+        flyback_cycle(&plant, &par, &drive);
+        t += period;
+        vout[n] = (float)plant.vout;
+        time[n] = t;
+
+        // Scheduler time base: Timer1 counts the cycles since the last tick, a period match is
+        // pending until the tasks of the tick are called
+        _T1IF = (t >= t_task);
+        TMR1 = (uint16_t)((t - ((_T1IF) ? t_task : (t_task - MAIN_EXECUTION_PERIOD))) * CPU_FREQUENCY);
+
+        // ADC conversions triggered by the PWM and ADC interrupt service routines
+        if (host_peripherals.adc_running) {
+            ADCBUF16 = sim_adc_ticks(plant.vout * VOUT_FB_GAIN);
+            ADCBUF12 = sim_adc_ticks(plant.vin * VIN_FB_GAIN);
+            ADCBUF6 = sim_adc_ticks(sc->v_set * VOUT_FB_GAIN);
+            host_adc_filter_trigger();
+            host_adc_comparator_trigger();
+            if ((n_detect == 0) && ((ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) && ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR)) ||
+                                    (ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) && ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR))))
+                n_detect = n;
+            #if (USE_FAULT_ENGINE == true)
+            if (ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) && ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR))
+                _VIN_FAULTInterrupt();
+            if (ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) && ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR))
+                _VOUT_FAULTInterrupt();
+            #endif
+            _ADCAN16IF = 1;
+            _VOUT_ADCInterrupt();
+            #if (USE_DMA_MONITORING == true)
+            host_dma_trigger(0);
+            host_dma_trigger(1);
+            #elif (EXT_REF_FILTER != EXT_REF_FILTER_HARDWARE)
+            _ADCAN6IF = 1;
+            _ADCAN6Interrupt();
+            #endif
+        }
+
+        // Scheduler tasks
+        if (t >= t_task) {
+            scheduler.ticks++;
+            _T1IF = 0;
+            TMR1 = (uint16_t)((t - t_task) * CPU_FREQUENCY);
+            t_task += MAIN_EXECUTION_PERIOD;
+            exec_pwr_control();
+            #if (USE_DMA_MONITORING == true)
+            monitor_exec();
+            #endif
+            #if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
+            ext_reference_exec();
+            #endif
+            #if (USE_GAIN_SCHEDULING == true)
+            gain_scheduler_exec();
+            #endif
+            #if (USE_VALLEY_SWITCHING == true)
+            valley_control_exec();
+            #endif
+            #if (USE_ADAPTIVE_SLOPE == true)
+            slope_control_exec();
+            #endif
+            #if (USE_LINE_FEEDFORWARD == true)
+            line_feedforward_exec();
+            #endif
+        }
+
+        if ((dump != NULL) && ((n % decimation) == 0))
+            fprintf(dump, "%s,%.7f,%.4f,%.3f,%u,%.4f,%.4f,%.4f,%u,%.2f,%u,%u\n", sc->name, t, plant.vout, plant.vin,
+                DAC1DATH, plant.t_on * 1.0e6, period * 1.0e6, plant.i_peak, plant.valley, plant.v_ds_on, plant.ccm,
+                converter.soft_start.phase);
+
+        // Valley and switching loss statistics within the final window
+        if ((duration - t) < SIM_WINDOW) {
+            sum_period += period;
+            sum_ein += plant.e_in;
+            if (plant.t_on > 0.0) {
+                e_sw = 0.5 * par.Coss * plant.v_ds_on * plant.v_ds_on;
+                sum_valley += plant.valley;
+                sum_vds += plant.v_ds_on;
+                sum_esw += e_sw;
+                sum_ein += e_sw + par.Qg * par.Vdrv;
+                if (plant.ccm) n_ccm++;
+                n_switch++;
+            }
+            n_valley++;
+        }
+    }
+    cycles = n;
+
+    // Evaluate metrics
+    for (n = 0; n < SIM_METRIC_COUNT; n++)
+        result->metric[n] = -1.0;
+    snprintf(result->name, sizeof(result->name), "%s", sc->name);
+
+    n_end = (n_step > 0) ? n_step : cycles;
+
+    if ((enabled) && (n_end > n_enable) && ((time[n_end - 1] - time[n_enable]) > SIM_WINDOW)) {
+
+        sim_window_stats(vout, sim_window_start(time, n_enable, n_end), n_end, &v_final, &ptp);
+        result->metric[3] = v_final;
+        result->metric[4] = ptp * 1.0e3;
+
+        if (v_final > 0.0) {
+            v_peak = 0.0;
+            dv = 0.0;
+            for (n = n_enable; n < n_end; n++) {
+                if ((result->metric[0] < 0.0) && (vout[n] >= 0.9 * v_final))
+                    result->metric[0] = (time[n] - time[n_enable]) * 1.0e3;
+                if ((result->metric[0] < 0.0) && ((vout[n_enable] - vout[n]) > dv)) dv = vout[n_enable] - vout[n];
+                if (vout[n] > v_peak) v_peak = vout[n];
+            }
+            result->metric[15] = 100.0 * dv / v_final;
+            result->metric[1] = (v_peak > v_final) ? (100.0 * (v_peak - v_final) / v_final) : 0.0;
+            result->metric[2] = sim_settling(vout, time, n_enable, n_end, v_final);
+
+            if ((n_step > 0) && ((time[cycles - 1] - time[n_step]) > SIM_WINDOW)) {
+                sim_window_stats(vout, sim_window_start(time, n_step, cycles), cycles, &v_post, &ptp);
+                dv = 0.0;
+                for (n = n_step; n < cycles; n++)
+                    if (fabs(vout[n] - v_final) > dv) dv = fabs(vout[n] - v_final);
+                result->metric[5] = 100.0 * dv / v_final;
+                result->metric[6] = sim_settling(vout, time, n_step, cycles, v_post);
+            }
+        }
+    }
+
+    if (n_switch > 0) {
+        result->metric[7] = sum_valley / n_switch;
+        result->metric[8] = sum_vds / n_switch;
+        result->metric[9] = 100.0 * (double)n_ccm / n_switch;
+    }
+    if (n_valley > 0) {
+        result->metric[10] = 1.0e-3 * (double)n_switch / sum_period;
+        result->metric[11] = 1.0e3 * sum_esw / sum_period;
+        result->metric[12] = 1.0e3 * sum_ein / sum_period;
+    }
+    if (n_trip > n_detect)
+        result->metric[13] = (double)(n_trip - n_detect);
+    #if (USE_FAULT_ENGINE == true)
+    result->metric[14] = (double)fault_handler.events;
+    #endif
+
+    free(vout);
+    free(time);
+    return(0);
+}
+
+static void sim_print(FILE* f, const SIM_RESULT_t* r, bool header)
+{
+    uint16_t i;
+
+    if (header) {
+        fprintf(f, "%-12s", "# scenario");
+        for (i = 0; i < SIM_METRIC_COUNT; i++) fprintf(f, " %10s", metric_names[i]);
+        fprintf(f, "\n");
+    }
+    fprintf(f, "%-12s", r->name);
+    for (i = 0; i < SIM_METRIC_COUNT; i++) fprintf(f, " %10.3f", r->metric[i]);
+    fprintf(f, "\n");
+}
+
+/*!sim_print_events
+ * *************************************************************************************************
+ * Lists the entries of the firmware event log from the oldest to the newest
+ * *************************************************************************************************/
+static void sim_print_events(FILE* f, const char* name)
+{
+    static const char* code_name[] = { "NONE", "PHASE", "STATUS", "FAULT", "STATE_ERROR", "SAT_BEGIN", 
+                                       "SAT_END", "RESTART" };
+    static const char* phase_name[] = { "INIT", "LAUNCH_PER", "STANDBY", "PWR_ON_DELAY", "RAMP_UP", 
+                                        "PWR_GOOD_DELAY", "COMPLETE", "FAULT" };
+    static const char* status_name[] = { "OFF", "STANDBY", "START", "ON", "FAULT" };
+    volatile EVENT_LOG_ENTRY_t* entry;
+    uint16_t head = event_log.head, first, i, prev, next;
+
+    first = (head > EVENT_LOG_DEPTH) ? (uint16_t)(head - EVENT_LOG_DEPTH) : 0;
+    fprintf(f, "# event log of %s: %u events\n", name, head);
+    fprintf(f, "# %10s  %-12s %s\n", "time [ms]", "event", "data");
+
+    for (i = first; i != head; i++) {
+        entry = &event_log.buffer[i & EVENT_LOG_MASK];
+        fprintf(f, "  %10.4f  %-12s ", ((double)entry->ticks * MAIN_EXECUTION_PERIOD + 
+            (double)entry->timer / CPU_FREQUENCY) * 1.0e3, code_name[(entry->code <= EVT_RESTART) ? entry->code : 0]);
+        prev = (entry->data >> 8);
+        next = (entry->data & 0x00FF);
+        switch (entry->code) {
+            case EVT_PHASE:
+                fprintf(f, "%s -> %s\n", (prev <= SS_FAULT) ? phase_name[prev] : "?", (next <= SS_FAULT) ? phase_name[next] : "?");
+                break;
+            case EVT_STATUS:
+                fprintf(f, "%s -> %s\n", (prev <= STAT_FAULT) ? status_name[prev] : "?", (next <= STAT_FAULT) ? status_name[next] : "?");
+                break;
+            case EVT_FAULT:
+                fprintf(f, "source 0x%04X\n", entry->data);
+                break;
+            case EVT_SAT_BEGIN:
+                fprintf(f, "reference %.3f V\n", (double)entry->data * ADC_GRAN / VOUT_FB_GAIN);
+                break;
+            case EVT_SAT_END:
+                fprintf(f, "%u cycles\n", entry->data);
+                break;
+            default:
+                fprintf(f, "%u\n", entry->data);
+                break;
+        }
+    }
+}
+
+/*!sim_sweep
+ * *************************************************************************************************
+ * Light-load sweep: output voltage, ripple, switching frequency and input power per load level
+ * *************************************************************************************************/
+static int sim_sweep(void)
+{
+    SIM_SCENARIO_t sc = { "sweep", SIM_SWEEP_VIN, 0.0, VOUT_NOMINAL, SIM_SWEEP_DURATION, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    SIM_RESULT_t r;
+    uint16_t i;
+
+    printf("light-load sweep at %.1f V input, burst mode %s\n", SIM_SWEEP_VIN, 
+        (USE_BURST_MODE == true) ? "enabled" : "disabled");
+    printf("%10s %10s %10s %10s %10s %10s %10s\n", 
+        "pout [mW]", "vout [V]", "ripple[mV]", "fsw [kHz]", "pin [mW]", "eff [%]", "packets");
+
+    for (i = 0; i < SIM_SWEEP_COUNT; i++) {
+        sc.r_load = (VOUT_NOMINAL * VOUT_NOMINAL) / sweep_power[i];
+        if (sim_run(&sc, NULL, 1, &r) != 0) return(-1);
+        printf("%10.1f %10.3f %10.1f %10.1f %10.1f %10.1f %10u\n", 1.0e3 * sweep_power[i], r.metric[3], 
+            r.metric[4], r.metric[10], r.metric[12], 
+            (r.metric[12] > 0.0) ? (100.0e3 * r.metric[3] * r.metric[3] / sc.r_load / r.metric[12]) : -1.0,
+            converter.burst.packets);
+    }
+
+    return(0);
+}
+
+/*!sim_read_baseline
+ * *************************************************************************************************
+ * Reads a baseline file written by option -w
+ * *************************************************************************************************/
+static int sim_read_baseline(const char* filename, SIM_RESULT_t* base, int max)
+{
+    FILE* f;
+    char line[512];
+    int count = 0, k, pos;
+    char* p;
+
+    f = fopen(filename, "r");
+    if (f == NULL) return(-1);
+
+    while ((count < max) && (fgets(line, sizeof(line), f) != NULL)) {
+        if ((line[0] == '#') || (line[0] == '\n')) continue;
+        if (sscanf(line, "%31s%n", base[count].name, &pos) != 1) continue;
+        p = line + pos;
+        for (k = 0; k < SIM_METRIC_COUNT; k++) {
+            base[count].metric[k] = strtod(p, &p);
+        }
+        count++;
+    }
+
+    fclose(f);
+    return(count);
+}
+
+static int sim_compare(const SIM_RESULT_t* r, const SIM_RESULT_t* base, int count)
+{
+    int i, k, deviations = 0;
+    double tol;
+
+    for (i = 0; i < count; i++) {
+        if (strcmp(r->name, base[i].name) != 0) continue;
+        for (k = 0; k < SIM_METRIC_COUNT; k++) {
+            tol = SIM_TOLERANCE_REL * fabs(base[i].metric[k]);
+            if (tol < SIM_TOLERANCE_ABS) tol = SIM_TOLERANCE_ABS;
+            if (fabs(r->metric[k] - base[i].metric[k]) > tol) {
+                fprintf(stderr, "%s: %s = %.3f deviates from baseline %.3f\n", 
+                    r->name, metric_names[k], r->metric[k], base[i].metric[k]);
+                deviations++;
+            }
+        }
+        return(deviations);
+    }
+
+    fprintf(stderr, "%s: scenario not found in baseline\n", r->name);
+    return(1);
+}
+
+int main(int argc, char** argv)
+{
+    const char *only = NULL, *dump_file = NULL, *base_file = NULL, *write_file = NULL, *rec_file = NULL;
+    uint32_t decimation = 10;
+    SIM_RESULT_t result, base[SIM_MAX_RESULTS];
+    FILE *dump = NULL, *out = NULL, *rec;
+    int i, base_count = 0, result_code = 0;
+    bool header = true, sweep = false, events = false;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) only = argv[++i];
+        else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc)) dump_file = argv[++i];
+        else if ((strcmp(argv[i], "-k") == 0) && (i + 1 < argc)) decimation = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc)) base_file = argv[++i];
+        else if ((strcmp(argv[i], "-w") == 0) && (i + 1 < argc)) write_file = argv[++i];
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)) rec_file = argv[++i];
+        else if (strcmp(argv[i], "-e") == 0) events = true;
+        else if (strcmp(argv[i], "-l") == 0) sweep = true;
+        else {
+            fprintf(stderr, "usage: %s [-s scenario] [-d file] [-k decimation] [-b baseline] [-w baseline] [-r file] [-e] [-l]\n", argv[0]);
+            return(2);
+        }
+    }
+    if (decimation == 0) decimation = 1;
+
+    if (sweep) {
+        if (sim_sweep() != 0) {
+            fprintf(stderr, "sweep: out of memory\n");
+            return(2);
+        }
+        return(0);
+    }
+
+    if (base_file != NULL) {
+        base_count = sim_read_baseline(base_file, base, SIM_MAX_RESULTS);
+        if (base_count < 0) {
+            fprintf(stderr, "cannot read baseline file %s\n", base_file);
+            return(2);
+        }
+    }
+    if (dump_file != NULL) {
+        dump = fopen(dump_file, "w");
+        if (dump == NULL) { fprintf(stderr, "cannot open %s\n", dump_file); return(2); }
+        fprintf(dump, "scenario,time,vout,vin,dac,t_on_us,period_us,i_peak,valley,vds_on,ccm,phase\n");
+    }
+    if (write_file != NULL) {
+        out = fopen(write_file, "w");
+        if (out == NULL) { fprintf(stderr, "cannot open %s\n", write_file); return(2); }
+    }
+
+    for (i = 0; i < (int)SIM_SCENARIO_COUNT; i++) {
+
+        if ((only != NULL) && (strcmp(only, scenarios[i].name) != 0))
+            continue;
+
+        if (sim_run(&scenarios[i], dump, decimation, &result) != 0) {
+            fprintf(stderr, "%s: out of memory\n", scenarios[i].name);
+            return(2);
+        }
+
+        sim_print(stdout, &result, header);
+        if (out != NULL) sim_print(out, &result, header);
+        header = false;
+
+        if ((base_file != NULL) && (sim_compare(&result, base, base_count) != 0))
+            result_code = 1;
+
+        if (events) sim_print_events(stdout, scenarios[i].name);
+    }
+
+    if (dump != NULL) fclose(dump);
+    if (out != NULL) fclose(out);
+
+    if (rec_file != NULL) {
+        rec = fopen(rec_file, "wb");
+        if (rec == NULL) { fprintf(stderr, "cannot open %s\n", rec_file); return(2); }
+        fwrite((const void*)&data_recorder, sizeof(data_recorder), 1, rec);
+        fclose(rec);
+    }
+
+    if (base_file != NULL)
+        printf("%s\n", (result_code) ? "FAILED" : "PASSED");
+
+    return(result_code);
+}
@@ -0,0 +1,19 @@
+/*
+ * File:   c2p2z_asm.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 9:40 AM
+ * 
+ * Host translation of qr-mode_setup.X/src/c2p2z_asm.s
+ * 
+ * The assembly file instantiates the generic nPnZ template npnz16b.inc as 2P2Z controller
+ * 'c2p2z'. The host model is generated the same way from the host translation of the 
+ * template (see npnz16b_asm.h), with the options of globals.h in place of the assemble-time
+ * options of npnz16b.inc.
+ */
+
+#include "globals.h"
+#include "c2p2z.h"
+#include "npnz16b_asm.h"
+
+NPNZ16B_HOST_KERNELS(c2p2z, 2, USE_TRANSIENT_BOOST, USE_SOFT_DESATURATION)
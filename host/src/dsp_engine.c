@@ -0,0 +1,125 @@
+/*
+ * File:   dsp_engine.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 9:12 AM
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsp_engine.h"
+
+#define ACC_40BIT_MAX   ((dsp_acc_t)0x7FFFFFFFFFLL)     // largest 9.31 accumulator value
+#define ACC_40BIT_MIN   (-(dsp_acc_t)0x8000000000LL)    // smallest 9.31 accumulator value
+#define ACC_32BIT_MAX   ((dsp_acc_t)0x7FFFFFFFLL)       // largest 1.31 accumulator value
+#define ACC_32BIT_MIN   (-(dsp_acc_t)0x80000000LL)      // smallest 1.31 accumulator value
+
+/*!dsp_acc_wrap40
+ * *************************************************************************************************
+ * Truncates a result to the physical 40-bit width of the accumulator (used when saturation 
+ * is disabled and the accumulator overflows)
+ * *************************************************************************************************/
+static inline dsp_acc_t dsp_acc_wrap40(dsp_acc_t acc)
+{
+    uint64_t raw = ((uint64_t)acc & 0xFFFFFFFFFFULL);
+    
+    if (raw & 0x8000000000ULL) 
+        raw |= 0xFFFFFF0000000000ULL; // sign-extend bit 39
+    
+    return((dsp_acc_t)raw);
+}
+
+dsp_acc_t dsp_acc_saturate(dsp_acc_t acc)
+{
+    if (!(CORCON & DSP_CORCON_SATA))
+        return(dsp_acc_wrap40(acc));
+    
+    if (CORCON & DSP_CORCON_ACCSAT)
+    { // super saturation: clamp to 9.31 range
+        if (acc > ACC_40BIT_MAX) return(ACC_40BIT_MAX);
+        if (acc < ACC_40BIT_MIN) return(ACC_40BIT_MIN);
+    }
+    else 
+    { // normal saturation: clamp to 1.31 range
+        if (acc > ACC_32BIT_MAX) return(ACC_32BIT_MAX);
+        if (acc < ACC_32BIT_MIN) return(ACC_32BIT_MIN);
+    }
+    
+    return(acc);
+}
+
+/*!dsp_product
+ * *************************************************************************************************
+ * Signed 17x17-bit multiplier output. In fractional mode the product is shifted left by one 
+ * bit to produce a 1.31 result, so 0x8000 x 0x8000 yields +1.0 (0x0080000000), which 
+ * is only representable before the saturation logic is applied.
+ * *************************************************************************************************/
+static inline dsp_acc_t dsp_product(int16_t w4, int16_t w6)
+{
+    dsp_acc_t product = (dsp_acc_t)((int32_t)w4 * (int32_t)w6);
+    
+    if (!(CORCON & DSP_CORCON_IF))
+        product *= 2; // fractional mode: align binary point to Q31
+    
+    return(product);
+}
+
+dsp_acc_t dsp_mpy(int16_t w4, int16_t w6)
+{
+    return(dsp_acc_saturate(dsp_product(w4, w6)));
+}
+
+dsp_acc_t dsp_mac(dsp_acc_t acc, int16_t w4, int16_t w6)
+{
+    return(dsp_acc_saturate(acc + dsp_product(w4, w6)));
+}
+
+dsp_acc_t dsp_msc(dsp_acc_t acc, int16_t w4, int16_t w6)
+{
+    return(dsp_acc_saturate(acc - dsp_product(w4, w6)));
+}
+
+dsp_acc_t dsp_add(dsp_acc_t acc, int16_t ws)
+{
+    // ADD Ws, Acc: the sign-extended word is added to ACCxU:ACCxH, ACCxL remains unchanged
+    return(dsp_acc_saturate(acc + ((dsp_acc_t)ws * 65536)));
+}
+
+dsp_acc_t dsp_sftac(dsp_acc_t acc, int16_t shift)
+{
+    // SFTAC uses a 6-bit signed shift value (-16 ... +16); 
+    // positive values shift right (arithmetic), negative values shift left
+    if (shift > 16) shift = 16;
+    if (shift < -16) shift = -16;
+    
+    if (shift >= 0)
+        acc >>= shift;
+    else
+        acc *= ((dsp_acc_t)1 << (-shift));
+    
+    return(dsp_acc_saturate(acc));
+}
+
+int16_t dsp_sac_r(dsp_acc_t acc)
+{
+    dsp_acc_t high = (acc >> 16);           // ACCxU:ACCxH
+    uint16_t low = (uint16_t)(acc & 0xFFFF); // ACCxL
+    
+    if (CORCON & DSP_CORCON_RND)
+    { // conventional (biased) rounding
+        if (low >= 0x8000) high++;
+    }
+    else
+    { // convergent (unbiased) rounding
+        if ((low > 0x8000) || ((low == 0x8000) && (high & 0x0001))) high++;
+    }
+    
+    if (CORCON & DSP_CORCON_SATDW)
+    { // data space write saturation to 1.15 range
+        if (high > INT16_MAX) return(INT16_MAX);
+        if (high < INT16_MIN) return(INT16_MIN);
+    }
+    
+    return((int16_t)(uint16_t)(high & 0xFFFF));
+}
@@ -0,0 +1,65 @@
+/* 
+ * File:   dsp_engine.h
+ * Author: M91406
+ * Comments: bit-exact emulation of the dsPIC33 DSP engine operations used by the
+ *           z-domain control library
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef HOST_DSP_ENGINE_EMULATION_H
+#define	HOST_DSP_ENGINE_EMULATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <xc.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!DSP Engine Emulation
+ * *************************************************************************************************
+ * Summary:
+ * Host implementation of the 40-bit accumulator instructions MAC, MSC, MPY, ADD, SFTAC and SAC.R
+ * 
+ * Description:
+ * The accumulator is held in a signed 64-bit integer carrying the sign-extended 40-bit value 
+ * of ACCx (ACCxU:ACCxH:ACCxL). Each instruction evaluates the CORCON register stand-in 
+ * the same way the device does:
+ * 
+ *    - IF     (bit 0):  0 = fractional multiplication (product shifted left by one bit)
+ *    - RND    (bit 1):  0 = convergent (unbiased) rounding, 1 = conventional (biased) rounding
+ *    - ACCSAT (bit 4):  0 = normal saturation (1.31), 1 = super saturation (9.31)
+ *    - SATDW  (bit 5):  1 = data space write saturation of SAC/SAC.R
+ *    - SATA   (bit 7):  1 = accumulator A saturation enabled
+ * 
+ * The firmware writes CORCON = 0x00E4 (SATA, SATB, SATDW, SFA, fractional mode, convergent
+ * rounding, normal saturation) before each control loop computation.
+ * 
+ * *************************************************************************************************/
+
+#define DSP_CORCON_IF       0x0001  // Integer/Fractional mode select bit
+#define DSP_CORCON_RND      0x0002  // Rounding mode select bit
+#define DSP_CORCON_ACCSAT   0x0010  // Accumulator saturation mode select bit
+#define DSP_CORCON_SATDW    0x0020  // Data space write from DSP engine saturation enable bit
+#define DSP_CORCON_SATA     0x0080  // Accumulator A saturation enable bit
+
+typedef int64_t dsp_acc_t;          // sign-extended 40-bit accumulator value
+
+extern dsp_acc_t dsp_acc_saturate(dsp_acc_t acc);
+extern dsp_acc_t dsp_mpy(int16_t w4, int16_t w6);
+extern dsp_acc_t dsp_mac(dsp_acc_t acc, int16_t w4, int16_t w6);
+extern dsp_acc_t dsp_msc(dsp_acc_t acc, int16_t w4, int16_t w6);
+extern dsp_acc_t dsp_add(dsp_acc_t acc, int16_t ws);
+extern dsp_acc_t dsp_sftac(dsp_acc_t acc, int16_t shift);
+extern int16_t dsp_sac_r(dsp_acc_t acc);
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* HOST_DSP_ENGINE_EMULATION_H */
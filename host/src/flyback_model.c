@@ -0,0 +1,112 @@
+/*
+ * File:   flyback_model.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 6:00 PM
+ * 
+ * Cycle-by-cycle model of a peak current controlled flyback converter (see flyback_model.h)
+ */
+
+#include <math.h>
+#include "flyback_model.h"
+
+void flyback_default_parameters(FLYBACK_PARAMETERS_t* par)
+{
+    par->Lp = 3.3e-6;
+    par->n = 1.0;
+    par->Rcs = 0.65;
+    par->Vf = 0.5;
+    par->Cout = 220e-6;
+    par->Coss = 200e-12;
+    par->tau_ring = 1.0e-6;
+    par->Vf_body = 0.7;
+    par->eta = 0.90;
+    par->Qg = 10e-9;
+    par->Vdrv = 10.0;
+}
+
+void flyback_reset(FLYBACK_STATE_t* state, double vin, double r_load)
+{
+    state->vin = vin;
+    state->vout = 0.0;
+    state->r_load = r_load;
+    state->i_mag = 0.0;
+    state->t_on = 0.0;
+    state->i_peak = 0.0;
+    state->t_demag = 0.0;
+    state->v_ds_on = vin;
+    state->e_in = 0.0;
+    state->valley = 0;
+    state->ccm = false;
+}
+
+/* On-time until the magnetizing current crosses the compensated comparator threshold */
+static double flyback_on_time(const FLYBACK_STATE_t* state, const FLYBACK_PARAMETERS_t* par, const FLYBACK_DRIVE_t* drive)
+{
+    double k, t;
+
+    if ((!drive->enabled) || (state->vin <= 0.0))
+        return(0.0);
+
+    k = state->vin / par->Lp; // current slope in [A/sec]
+
+    // Threshold constant until the slope compensation ramp starts
+    t = ((drive->v_dac / par->Rcs) - state->i_mag) / k;
+    if ((drive->slope > 0.0) && (t > drive->t_slope))
+        t = ((drive->v_dac + (drive->slope * drive->t_slope)) / par->Rcs - state->i_mag) / 
+            (k + (drive->slope / par->Rcs));
+
+    if (t < drive->t_leb) t = drive->t_leb;
+    if (t > drive->t_on_max) t = drive->t_on_max;
+
+    return(t);
+}
+
+void flyback_cycle(FLYBACK_STATE_t* state, const FLYBACK_PARAMETERS_t* par, const FLYBACK_DRIVE_t* drive)
+{
+    double v_refl, k_off, t_off, t_cond, i_end, charge, t_ring, w_ring, dv;
+
+    // On-time
+    state->t_on = flyback_on_time(state, par, drive);
+    state->i_peak = state->i_mag + (state->vin / par->Lp) * state->t_on;
+    state->e_in = state->vin * 0.5 * (state->i_mag + state->i_peak) * state->t_on;
+
+    // Off-time: demagnetization by the reflected output voltage
+    v_refl = par->n * (((state->vout > 0.0) ? state->vout : 0.0) + par->Vf);
+    k_off = v_refl / par->Lp;
+    t_off = drive->period - state->t_on;
+    state->t_demag = state->i_peak / k_off;
+
+    if (state->t_demag < t_off) {
+        t_cond = state->t_demag;
+        i_end = 0.0;
+        state->ccm = false;
+
+        // Drain voltage ringing of Lp and Coss after demagnetization
+        t_ring = t_off - state->t_demag;
+        w_ring = 1.0 / sqrt(par->Lp * par->Coss);
+        state->v_ds_on = state->vin + v_refl * cos(w_ring * t_ring) * exp(-t_ring / par->tau_ring);
+        state->v_ds_on = fmax(state->v_ds_on, -par->Vf_body); // body diode of the switch clamps the drain
+        state->valley = (uint16_t)floor((t_ring * w_ring / (2.0 * M_PI)) + 1.0);
+    }
+    else {
+        t_cond = t_off;
+        i_end = state->i_peak - k_off * t_off;
+        state->ccm = true;
+        state->v_ds_on = state->vin + v_refl;
+        state->valley = 0;
+    }
+    if (state->i_peak <= 0.0) { // no switching
+        t_cond = 0.0;
+        i_end = 0.0;
+        state->v_ds_on = state->vin;
+        state->valley = 0;
+    }
+    state->i_mag = i_end;
+
+    // Output capacitor: secondary charge minus load charge
+    charge = par->eta * par->n * 0.5 * (state->i_peak + i_end) * t_cond;
+    dv = (charge - (state->vout / state->r_load) * drive->period) / par->Cout;
+    state->vout += dv;
+    if (state->vout < 0.0) state->vout = 0.0;
+}
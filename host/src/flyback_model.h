@@ -0,0 +1,98 @@
+/* 
+ * File:   flyback_model.h
+ * Author: M91406
+ * Comments: cycle-by-cycle model of a peak current controlled flyback converter with
+ *           quasi-resonant drain voltage ringing
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef HOST_FLYBACK_MODEL_H
+#define	HOST_FLYBACK_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Flyback Plant Model
+ * *************************************************************************************************
+ * Summary:
+ * Switching cycle resolved model of the flyback power stage
+ * 
+ * Description:
+ * Each call of flyback_cycle() computes one switching period analytically:
+ * 
+ *    - On-time: the magnetizing current rises with Vin/Lp from the residual current of the 
+ *      previous cycle until it crosses the comparator threshold (DAC voltage minus slope
+ *      compensation ramp) divided by the current sense gain. The comparator is blanked during 
+ *      the leading edge blanking period, the on-time is limited by the maximum duty cycle.
+ *    - Off-time: the reflected output voltage n*(Vout+Vf) demagnetizes the transformer. If the
+ *      current reaches zero before the end of the period (DCM), the drain voltage rings around 
+ *      Vin with the reflected voltage amplitude, resonance of Lp and Coss and exponential 
+ *      damping. Where the reflected voltage exceeds Vin, the body diode of the switch clamps 
+ *      the drain voltage at -Vf_body. The drain voltage at the next turn-on and the valley 
+ *      number are reported. 
+ *      Otherwise the residual current is carried into the next cycle (CCM).
+ *    - Output: the charge delivered by the secondary current (scaled by the efficiency factor) 
+ *      and the load current are integrated on the output capacitor.
+ *    - Input: the energy drawn from the input during the on-time is reported. Gate charge and
+ *      gate driver supply are provided for the switching loss estimate of the simulator.
+ * 
+ * The default parameters describe a generic 10 W flyback stage; they are assumptions, not 
+ * measured data of a specific board.
+ * *************************************************************************************************/
+
+typedef struct {
+    double Lp;          // primary magnetizing inductance in [H]
+    double n;           // turns ratio Np/Ns
+    double Rcs;         // current sense gain at the comparator input in [V/A]
+    double Vf;          // output rectifier forward voltage in [V]
+    double Cout;        // output capacitance in [F]
+    double Coss;        // effective drain node capacitance in [F]
+    double tau_ring;    // damping time constant of the drain voltage ringing in [sec]
+    double Vf_body;     // body diode forward voltage of the switch in [V]
+    double eta;         // charge transfer efficiency (lumped losses)
+    double Qg;          // total gate charge of the switch in [C]
+    double Vdrv;        // gate driver supply voltage in [V]
+}FLYBACK_PARAMETERS_t;
+
+typedef struct {
+    double period;      // switching period in [sec]
+    double t_on_max;    // maximum on-time (maximum duty cycle) in [sec]
+    double t_leb;       // leading edge blanking period in [sec]
+    double v_dac;       // comparator DAC voltage at the start of the cycle in [V]
+    double slope;       // slope compensation ramp in [V/sec] (0 = disabled)
+    double t_slope;     // start of the slope compensation ramp in [sec]
+    bool enabled;       // PWM output enabled (false = output overridden low)
+}FLYBACK_DRIVE_t;
+
+typedef struct {
+    double vin;         // input voltage in [V]
+    double vout;        // output voltage in [V]
+    double r_load;      // load resistance in [Ohm]
+    double i_mag;       // primary referred magnetizing current at the end of the cycle in [A]
+    
+    // Results of the most recent cycle
+    double t_on;        // on-time in [sec]
+    double i_peak;      // primary peak current in [A]
+    double t_demag;     // demagnetization time in [sec]
+    double v_ds_on;     // drain voltage at turn-on of the next cycle in [V]
+    double e_in;        // energy drawn from the input during the on-time in [J]
+    uint16_t valley;    // ringing valley closest to the turn-on instant (1 = first valley, 0 = none/CCM)
+    bool ccm;           // continuous conduction mode cycle
+}FLYBACK_STATE_t;
+
+extern void flyback_default_parameters(FLYBACK_PARAMETERS_t* par);
+extern void flyback_reset(FLYBACK_STATE_t* state, double vin, double r_load);
+extern void flyback_cycle(FLYBACK_STATE_t* state, const FLYBACK_PARAMETERS_t* par, const FLYBACK_DRIVE_t* drive);
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* HOST_FLYBACK_MODEL_H */
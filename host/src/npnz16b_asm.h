@@ -0,0 +1,311 @@
+/*
+ * File:   npnz16b_asm.h
+ * Author: M91406
+ * Comments: host translation of the generic nPnZ assembly template
+ *           qr-mode_setup.X/h/npnz16b.inc
+ * Revision history:
+ * 1.0  initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef HOST_NPNZ16B_ASM_TEMPLATE_H
+#define	HOST_NPNZ16B_ASM_TEMPLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "npnz16b.h"
+#include "dsp_engine.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!NPNZ16B_HOST_KERNELS
+ * *************************************************************************************************
+ * Summary:
+ * Generates the host models of <prefix>_Update, <prefix>_UpdateBlock, <prefix>_Reset and
+ * <prefix>_Precharge of a controller instance of the given order
+ *
+ * Description:
+ * Each block below mirrors one macro of npnz16b.inc, using the DSP engine emulation for all
+ * accumulator operations. The filter order is a compile-time constant, so the compiler
+ * unrolls all delay line loops the same way the assembler does with .rept. Any change to
+ * the assembly template needs to be reflected here to keep the host model bit-exact.
+ *
+ * Optional code of the control output path is selected by the same parameters as in the
+ * template (boost: transient boost, backcalc: back-calculation anti-windup, see 
+ * NPNZ16B_CONTROLLER). Host models of instances without options match the plain linear 
+ * compensator with hard clamping.
+ *
+ * The host skips the ADC trigger register write when no register has been assigned.
+ * *************************************************************************************************/
+
+#define NPMZ16_STATUS_ENABLE    15  // bit position of the ENABLE bit
+#define NPMZ16_STATUS_BOOST     2   // bit position of the TRANSIENT_BOOST_FLAG_BIT
+#define NPMZ16_STATUS_USAT      1   // bit position of the UPPER_SATURATION_FLAG_BIT
+#define NPMZ16_STATUS_LSAT      0   // bit position of the LOWER_SATURATION_FLAG_BIT
+
+/* Back-calculation anti-windup of a clamped output, macro NPNZ16B_BACK_CALCULATE 
+ * (corrects the most recent error history entry) */
+static inline void npnz16b_back_calculate(volatile cNPNZ16b_t* controller, int16_t w4, int16_t w6)
+{
+    int16_t w5;
+    dsp_acc_t a;
+
+    w5 = controller->BackCalcGain;
+    if (w5 != 0) {
+        a = dsp_mpy(w5, w6);
+        a = dsp_msc(a, w4, w5);
+        a = dsp_add(a, controller->ptrErrorHistory[0]);
+        controller->ptrErrorHistory[0] = dsp_sac_r(a);
+    }
+
+    return;
+}
+
+/* Controller Anti-Windup (control output value clamping), macro NPNZ16B_CLAMP 
+ * (returns the clamped control output) */
+static inline int16_t npnz16b_clamp(volatile cNPNZ16b_t* controller, int16_t w4, uint16_t* w12, bool backcalc)
+{
+    int16_t w6;
+
+    w6 = controller->MaxOutput;
+    if (!(w4 < w6)) { if (backcalc) npnz16b_back_calculate(controller, w4, w6); w4 = w6; *w12 |= (1 << NPMZ16_STATUS_USAT); }
+    else { *w12 &= ~(1 << NPMZ16_STATUS_USAT); }
+
+    w6 = controller->MinOutput;
+    if (!(w4 > w6)) { if (backcalc) npnz16b_back_calculate(controller, w4, w6); w4 = w6; *w12 |= (1 << NPMZ16_STATUS_LSAT); }
+    else { *w12 &= ~(1 << NPMZ16_STATUS_LSAT); }
+
+    return(w4);
+}
+
+/* Non-linear transient boost of the control output, macro NPNZ16B_BOOST */
+static inline int16_t npnz16b_boost(volatile cNPNZ16b_t* controller, int16_t error, int16_t w4, uint16_t* w12)
+{
+    int16_t w5, w6;
+
+    *w12 &= ~(1 << NPMZ16_STATUS_BOOST);
+
+    w6 = controller->BoostBand;
+    if (w6 == 0)
+        return(w4);
+
+    /* Branches evaluate the signed result including overflow (bra ge / bra le) */
+    if (error < 0) {
+        if (((int32_t)error + w6) >= 0) return(w4);
+        w5 = (int16_t)(uint16_t)((uint16_t)error + (uint16_t)w6);
+    }
+    else {
+        if (((int32_t)error - w6) <= 0) return(w4);
+        w5 = (int16_t)(uint16_t)((uint16_t)error - (uint16_t)w6);
+    }
+
+    w4 = dsp_sac_r(dsp_add(dsp_mpy(w5, controller->BoostGain), w4));
+    *w12 |= (1 << NPMZ16_STATUS_BOOST);
+
+    return(w4);
+}
+
+/* Multiply & accumulate <taps> coefficients with history entries, macro NPNZ16B_MAC_TERM */
+static inline dsp_acc_t npnz16b_mac_term(dsp_acc_t a, volatile fractional* w8, volatile fractional* w10, uint16_t taps)
+{
+    uint16_t k;
+
+    for (k = 0; k < taps; k++)
+        a = dsp_mac(a, w8[k], w10[k]);
+
+    return(a);
+}
+
+/* Move history entries one tick down the delay line, macro NPNZ16B_SHIFT_HISTORY */
+static inline void npnz16b_shift_history(volatile fractional* w10, uint16_t entries)
+{
+    uint16_t k;
+
+    for (k = (entries - 1); k > 0; k--)
+        w10[k] = w10[k - 1];
+}
+
+#define NPNZ16B_HOST_KERNELS(prefix, order, boost, backcalc) \
+\
+void prefix##_Update(volatile cNPNZ16b_t* controller) \
+{ \
+    uint16_t w12; \
+    int16_t w1, w4; \
+    uint16_t shift; \
+    volatile fractional* w10; \
+    dsp_acc_t a; \
+    \
+    /* Check status word for Enable/Disable flag and bypass computation, if disabled */ \
+    w12 = controller->status.value; \
+    if (!(w12 & (1 << NPMZ16_STATUS_ENABLE))) \
+        return; \
+    \
+    /* Configure DSP for fractional operation with normal saturation (Q1.31 format) */ \
+    CORCON = 0x00E4; \
+    \
+    /* Compute A-term */ \
+    a = npnz16b_mac_term(0, controller->ptrACoefficients, controller->ptrControlHistory, (order)); \
+    \
+    /* Read data from input source and calculate error input to transfer function */ \
+    w10 = controller->ptrErrorHistory; \
+    w1 = (int16_t)*controller->ptrSource; \
+    w1 = (int16_t)(uint16_t)(*controller->ptrControlReference - (uint16_t)w1); /* subr */ \
+    shift = ((uint16_t)controller->normPreShift & 0x000F); \
+    w1 = (int16_t)(uint16_t)((uint16_t)w1 << shift); /* sl */ \
+    \
+    /* Update error history (move error one tick along the delay line) */ \
+    npnz16b_shift_history(w10, (order) + 1); \
+    w10[0] = w1; \
+    \
+    /* Compute B-term */ \
+    a = npnz16b_mac_term(a, controller->ptrBCoefficients, w10, (order) + 1); \
+    \
+    /* Backward normalization of recent result */ \
+    a = dsp_sftac(a, controller->normPostShiftA); \
+    w4 = dsp_sac_r(a); \
+    \
+    /* Initialize scale-factor and multiply */ \
+    a = dsp_mpy(w4, controller->normPostScaler); \
+    w4 = dsp_sac_r(a); \
+    \
+    /* Non-linear transient boost */ \
+    if (boost) w4 = npnz16b_boost(controller, w1, w4, &w12); \
+    \
+    /* Controller Anti-Windup (control output value clamping) */ \
+    w4 = npnz16b_clamp(controller, w4, &w12, (backcalc)); \
+    \
+    /* Write control output value to target */ \
+    *controller->ptrTarget = (uint16_t)w4; \
+    \
+    /* Update ADC trigger position */ \
+    if (controller->ptrADCTriggerRegister != NULL) \
+        *controller->ptrADCTriggerRegister = (uint16_t)((w4 >> 1) + controller->ADCTriggerOffset); \
+    \
+    /* Update control output history */ \
+    w10 = controller->ptrControlHistory; \
+    npnz16b_shift_history(w10, (order)); \
+    w10[0] = w4; \
+    \
+    /* Update status flag bitfield */ \
+    controller->status.value = w12; \
+    \
+    return; \
+} \
+\
+void prefix##_UpdateBlock(volatile cNPNZ16b_t* controller, volatile uint16_t* ptrInput, \
+        volatile uint16_t* ptrOutput, uint16_t count) \
+{ \
+    uint16_t w12; \
+    int16_t w4 = 0, w5; \
+    uint16_t w9; \
+    int16_t w11, w13; \
+    volatile uint16_t* w7; \
+    volatile fractional* w10; \
+    dsp_acc_t a; \
+    \
+    /* Check status word for Enable/Disable flag and bypass computation, if disabled or empty */ \
+    w12 = controller->status.value; \
+    if ((!(w12 & (1 << NPMZ16_STATUS_ENABLE))) || (count == 0)) \
+        return; \
+    \
+    /* Configure DSP for fractional operation with normal saturation (Q1.31 format) */ \
+    CORCON = 0x00E4; \
+    \
+    /* Load block-invariant settings into working registers */ \
+    w9 = ((uint16_t)controller->normPreShift & 0x000F); \
+    w11 = controller->normPostShiftA; \
+    w13 = controller->normPostScaler; \
+    w7 = controller->ptrControlReference; \
+    \
+    do { \
+        /* Compute A-term */ \
+        a = npnz16b_mac_term(0, controller->ptrACoefficients, controller->ptrControlHistory, (order)); \
+        \
+        /* Read next input sample and calculate error input to transfer function */ \
+        w10 = controller->ptrErrorHistory; \
+        w5 = (int16_t)*ptrInput++; \
+        w5 = (int16_t)(uint16_t)(*w7 - (uint16_t)w5); \
+        w5 = (int16_t)(uint16_t)((uint16_t)w5 << w9); \
+        \
+        /* Update error history */ \
+        npnz16b_shift_history(w10, (order) + 1); \
+        w10[0] = w5; \
+        \
+        /* Compute B-term */ \
+        a = npnz16b_mac_term(a, controller->ptrBCoefficients, w10, (order) + 1); \
+        \
+        /* Backward normalization and output scaling */ \
+        a = dsp_sftac(a, w11); \
+        w4 = dsp_sac_r(a); \
+        a = dsp_mpy(w4, w13); \
+        w4 = dsp_sac_r(a); \
+        \
+        /* Non-linear transient boost */ \
+        if (boost) w4 = npnz16b_boost(controller, w5, w4, &w12); \
+        \
+        /* Controller Anti-Windup (control output value clamping) */ \
+        w4 = npnz16b_clamp(controller, w4, &w12, (backcalc)); \
+        \
+        /* Write control output value to output array */ \
+        *ptrOutput++ = (uint16_t)w4; \
+        \
+        /* Update control output history */ \
+        w10 = controller->ptrControlHistory; \
+        npnz16b_shift_history(w10, (order)); \
+        w10[0] = w4; \
+        \
+    } while (--count); \
+    \
+    /* Write most recent control output value to target */ \
+    *controller->ptrTarget = (uint16_t)w4; \
+    \
+    /* Update ADC trigger position */ \
+    if (controller->ptrADCTriggerRegister != NULL) \
+        *controller->ptrADCTriggerRegister = (uint16_t)((w4 >> 1) + controller->ADCTriggerOffset); \
+    \
+    /* Update status flag bitfield */ \
+    controller->status.value = w12; \
+    \
+    return; \
+} \
+\
+void prefix##_Reset(volatile cNPNZ16b_t* controller) \
+{ \
+    uint16_t i; \
+    \
+    /* Clear control history array */ \
+    for (i = 0; i < (order); i++) \
+        controller->ptrControlHistory[i] = 0; \
+    \
+    /* Clear error history array */ \
+    for (i = 0; i < ((order) + 1); i++) \
+        controller->ptrErrorHistory[i] = 0; \
+    \
+    return; \
+} \
+\
+void prefix##_Precharge(volatile cNPNZ16b_t* controller, volatile uint16_t ctrl_input, volatile uint16_t ctrl_output) \
+{ \
+    uint16_t i; \
+    \
+    /* Charge error history array with defined value */ \
+    for (i = 0; i < ((order) + 1); i++) \
+        controller->ptrErrorHistory[i] = (fractional)ctrl_input; \
+    \
+    /* Charge control history array with defined value */ \
+    for (i = 0; i < (order); i++) \
+        controller->ptrControlHistory[i] = (fractional)ctrl_output; \
+    \
+    return; \
+}
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* HOST_NPNZ16B_ASM_TEMPLATE_H */
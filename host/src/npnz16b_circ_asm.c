@@ -0,0 +1,203 @@
+/*
+ * File:   npnz16b_circ_asm.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 11:45 AM
+ *
+ * Host translation of qr-mode_setup.X/src/npnz16b_circ_asm.s
+ *
+ * Each block below mirrors one block of the assembly routine, using the DSP engine
+ * emulation for all accumulator operations. Byte offsets of the head index are kept
+ * as they are on the device. Any change to the assembly file needs to be reflected
+ * here to keep the host model bit-exact.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "npnz16b_circ.h"
+#include "dsp_engine.h"
+
+#define NPMZ16_STATUS_ENABLE    15  // bit position of the ENABLE bit
+#define NPMZ16_STATUS_BOOST     2   // bit position of the TRANSIENT_BOOST_FLAG_BIT
+#define NPMZ16_STATUS_USAT      1   // bit position of the UPPER_SATURATION_FLAG_BIT
+#define NPMZ16_STATUS_LSAT      0   // bit position of the LOWER_SATURATION_FLAG_BIT
+
+#define HIST_ENTRY(base, byte_offset)   (*(volatile fractional*)((volatile uint8_t*)(base) + (byte_offset)))
+
+/* Back-calculation anti-windup of a clamped output, macro NPNZ16B_BACK_CALCULATE with <circ> = 1
+ * (corrects the head entry of the error history and its mirror) */
+static inline void circ_back_calculate(volatile cNPNZ16b_t* controller, int16_t w4, int16_t w6, uint16_t w2, uint16_t w3)
+{
+    int16_t w5;
+    volatile fractional* w8;
+    dsp_acc_t a;
+
+    w5 = controller->BackCalcGain;
+    if (w5 != 0) {
+        a = dsp_mpy(w5, w6);
+        a = dsp_msc(a, w4, w5);
+        w8 = &HIST_ENTRY(controller->ptrErrorHistory, w3);
+        a = dsp_add(a, w8[0]);
+        w5 = dsp_sac_r(a);
+        w8[0] = w5;
+        HIST_ENTRY(w8, w2) = w5;
+    }
+
+    return;
+}
+
+void npnz16b_circ_Update(volatile cNPNZ16b_t* controller)
+{
+    uint16_t w12;                       // status flag tracking
+    int16_t w1, w4, w6;                 // working registers
+    uint16_t w2, w3, w5, shift;
+    uint16_t rpt;                       // REPEAT loop counter
+    volatile fractional* w8;            // X-space pointer (coefficients)
+    volatile fractional* w10;           // Y-space pointer (histories)
+    dsp_acc_t a;
+
+    // Check status word for Enable/Disable flag and bypass computation, if disabled
+    w12 = controller->status.value;
+    if (!(w12 & (1 << NPMZ16_STATUS_ENABLE)))
+        return;
+
+    // Configure DSP for fractional operation with normal saturation (Q1.31 format)
+    CORCON = 0x00E4;
+
+    // Advance the history head by one entry (shared by control and error delay line)
+    w2 = (uint16_t)(controller->ErrorHistoryArraySize << 1);
+    w3 = (uint16_t)(controller->HistoryHead - 2);
+    if (w3 & 0x8000)
+        w3 = (uint16_t)(w3 + w2);
+    controller->HistoryHead = w3;
+
+    // Compute A-term over the control history window of the previous call (n-1 ... n-N)
+    w8 = controller->ptrACoefficients;
+    w10 = &HIST_ENTRY(controller->ptrControlHistory, w3 + 2);
+    w5 = (uint16_t)(controller->ACoefficientsArraySize - 2);
+    a = 0;
+    for (rpt = 0; rpt <= w5; rpt++)  // repeat w5: N-1 MACs with prefetch
+        a = dsp_mac(a, *w8++, *w10++);
+    a = dsp_mac(a, *w8, *w10);              // last MAC without prefetch
+
+    // Read data from input source and calculate error input to transfer function
+    w1 = (int16_t)*controller->ptrSource;
+    w1 = (int16_t)(uint16_t)(*controller->ptrControlReference - (uint16_t)w1); // subr
+    shift = ((uint16_t)controller->normPreShift & 0x000F);
+    w1 = (int16_t)(uint16_t)((uint16_t)w1 << shift);     // sl
+
+    // Update error history (write error to head entry and its mirror)
+    w10 = &HIST_ENTRY(controller->ptrErrorHistory, w3);
+    w10[0] = w1;
+    HIST_ENTRY(w10, w2) = w1;
+
+    // Compute B-term over the error history window (n ... n-N)
+    w8 = controller->ptrBCoefficients;
+    w5 = (uint16_t)(controller->BCoefficientsArraySize - 2);
+    for (rpt = 0; rpt <= w5; rpt++)  // repeat w5: N MACs with prefetch
+        a = dsp_mac(a, *w8++, *w10++);
+    a = dsp_mac(a, *w8, *w10);              // last MAC without prefetch
+
+    // Backward normalization of recent result
+    a = dsp_sftac(a, controller->normPostShiftA);
+    w4 = dsp_sac_r(a);
+
+    // Initialize scale-factor and multiply
+    a = dsp_mpy(w4, controller->normPostScaler);
+    w4 = dsp_sac_r(a);
+
+    // Non-linear transient boost (macro NPNZ16B_BOOST, assembled with USE_TRANSIENT_BOOST)
+    #if (USE_TRANSIENT_BOOST == true)
+    int16_t w7;                         // working register w5 of the boost macro
+    w12 &= ~(1 << NPMZ16_STATUS_BOOST);
+    w6 = controller->BoostBand;
+    if (w6 != 0) {
+        // (branches evaluate the signed result including overflow)
+        w7 = (int16_t)(uint16_t)((w1 < 0) ? ((uint16_t)w1 + (uint16_t)w6) : ((uint16_t)w1 - (uint16_t)w6));
+        if ((w1 < 0) ? (((int32_t)w1 + w6) < 0) : (((int32_t)w1 - w6) > 0)) {
+            a = dsp_add(dsp_mpy(w7, controller->BoostGain), w4);
+            w4 = dsp_sac_r(a);
+            w12 |= (1 << NPMZ16_STATUS_BOOST);
+        }
+    }
+    #endif
+
+    // Controller Anti-Windup (control output value clamping, macro NPNZ16B_CLAMP)
+    // (back-calculation assembled with USE_SOFT_DESATURATION, see npnz16b.inc)
+    w6 = controller->MaxOutput;
+    if (!(w4 < w6)) {
+        #if (USE_SOFT_DESATURATION == true)
+        circ_back_calculate(controller, w4, w6, w2, w3);
+        #endif
+        w4 = w6; w12 |= (1 << NPMZ16_STATUS_USAT);
+    }
+    else { w12 &= ~(1 << NPMZ16_STATUS_USAT); }
+
+    w6 = controller->MinOutput;
+    if (!(w4 > w6)) {
+        #if (USE_SOFT_DESATURATION == true)
+        circ_back_calculate(controller, w4, w6, w2, w3);
+        #endif
+        w4 = w6; w12 |= (1 << NPMZ16_STATUS_LSAT);
+    }
+    else { w12 &= ~(1 << NPMZ16_STATUS_LSAT); }
+
+    // Write control output value to target
+    *controller->ptrTarget = (uint16_t)w4;
+
+    // Update ADC trigger position
+    // (the device writes unconditionally; the host skips unassigned pointers)
+    if (controller->ptrADCTriggerRegister != NULL)
+        *controller->ptrADCTriggerRegister = (uint16_t)((w4 >> 1) + controller->ADCTriggerOffset);
+
+    // Update control output history (write output to head entry and its mirror)
+    w10 = &HIST_ENTRY(controller->ptrControlHistory, w3);
+    w10[0] = w4;
+    HIST_ENTRY(w10, w2) = w4;
+
+    // Update status flag bitfield
+    controller->status.value = w12;
+
+    return;
+}
+
+void npnz16b_circ_Reset(volatile cNPNZ16b_t* controller)
+{
+    uint16_t i, size;
+
+    // Load number of buffer entries (2 x buffer period)
+    size = (uint16_t)(controller->ErrorHistoryArraySize << 1);
+
+    // Clear control and error history buffers
+    for (i = 0; i < size; i++) {
+        controller->ptrControlHistory[i] = 0;
+        controller->ptrErrorHistory[i] = 0;
+    }
+
+    // Reset head index
+    controller->HistoryHead = 0;
+
+    return;
+}
+
+void npnz16b_circ_Precharge(volatile cNPNZ16b_t* controller, volatile uint16_t ctrl_input, volatile uint16_t ctrl_output)
+{
+    uint16_t i, size;
+
+    // Load number of buffer entries (2 x buffer period)
+    size = (uint16_t)(controller->ErrorHistoryArraySize << 1);
+
+    // Charge error and control history buffers with defined value
+    for (i = 0; i < size; i++) {
+        controller->ptrErrorHistory[i] = (fractional)ctrl_input;
+        controller->ptrControlHistory[i] = (fractional)ctrl_output;
+    }
+
+    // Reset head index
+    controller->HistoryHead = 0;
+
+    return;
+}
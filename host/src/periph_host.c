@@ -0,0 +1,295 @@
+/*
+ * File:   periph_host.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 6:20 PM
+ * 
+ * Host replacements of the peripheral initialization routines in qr-mode_setup.X/src/init
+ * (see periph_host.h)
+ */
+
+#include <string.h>
+#include <xc.h>
+#include "globals.h"
+#include "scheduler.h"
+#include "periph_host.h"
+
+volatile SCHEDULER_t scheduler; // stand-in of the scheduler status (scheduler.c is not part of the host build)
+
+HOST_PERIPHERALS_t host_peripherals;
+HOST_DMA_CHANNEL_t host_dma[HOST_DMA_CHANNELS];
+HOST_ADC_FILTER_t host_adc_filter[HOST_ADC_FILTERS];
+HOST_ADC_COMPARATOR_t host_adc_comparator[HOST_ADC_COMPARATORS] = {
+    { NULL, &ADCMP0CONbits, &ADCMP0LO, &ADCMP0HI, &_ADCMP0IF, 0 },
+    { NULL, &ADCMP1CONbits, &ADCMP1LO, &ADCMP1HI, &_ADCMP1IF, 0 },
+    { NULL, &ADCMP2CONbits, &ADCMP2LO, &ADCMP2HI, &_ADCMP2IF, 0 },
+    { NULL, &ADCMP3CONbits, &ADCMP3LO, &ADCMP3HI, &_ADCMP3IF, 0 }
+};
+
+void host_peripherals_reset(void)
+{
+    uint16_t i;
+    HOST_ADC_COMPARATOR_t* cmp;
+    
+    host_peripherals.adc_running = false;
+    host_peripherals.acmp_running = false;
+    host_peripherals.pwm_running = false;
+    host_peripherals.pwm_fault = false;
+
+    MPER = 0;
+    PG1PER = 0;
+    PG1DC = 0;
+    PG1IOCONLbits.OVRENH = 0;
+    PG1STATbits.UPDREQ = 0;
+    PG2STATbits.UPDREQ = 0;
+    PG2TRIGA = 0;
+    DAC1DATH = 0;
+    DAC1DATL = 0;
+    SLP1DAT = 0;
+    ADCBUF6 = 0;
+    ADCBUF12 = 0;
+    ADCBUF16 = 0;
+    ADFL0DAT = 0;
+    ADFL1DAT = 0;
+    ADFL2DAT = 0;
+    ADFL3DAT = 0;
+    DMADST0 = 0;
+    DMADST1 = 0;
+    PG1FPCIHbits.SWPCI = 0;
+    PG1FPCILbits.SWTERM = 0;
+    TMR1 = 0;
+    _T1IF = 0;
+    scheduler.ticks = 0;
+    
+    memset(host_dma, 0, sizeof(host_dma));
+    memset(host_adc_filter, 0, sizeof(host_adc_filter));
+    
+    for (i = 0; i < HOST_ADC_COMPARATORS; i++) {
+        cmp = &host_adc_comparator[i];
+        cmp->source = NULL;
+        cmp->channel = 0;
+        *cmp->con = (ADCMPxCONBITS){ 0 };
+        *cmp->lo = 0;
+        *cmp->hi = 0;
+        *cmp->flag = 0;
+    }
+    _ADCMP0IE = 0;
+    _ADCMP1IE = 0;
+    _ADCMP2IE = 0;
+    _ADCMP3IE = 0;
+}
+
+bool host_pwm_fault_update(void)
+{
+    if (PG1FPCIHbits.SWPCI) {
+        host_peripherals.pwm_fault = true;      // Latched acceptance
+    }
+    else if (PG1FPCILbits.SWTERM) {
+        host_peripherals.pwm_fault = false;     // Terminated at the end of the previous cycle
+    }
+    PG1FPCILbits.SWTERM = 0;                    // Always reads '0'
+    
+    return(host_peripherals.pwm_fault);
+}
+
+void host_adc_comparator_trigger(void)
+{
+    uint16_t i, result;
+    bool event;
+    HOST_ADC_COMPARATOR_t* cmp;
+    
+    for (i = 0; i < HOST_ADC_COMPARATORS; i++) {
+        cmp = &host_adc_comparator[i];
+        if ((cmp->source == NULL) || (!cmp->con->CMPEN)) continue;
+        result = *cmp->source;
+        event = ((cmp->con->LOLO) && (result < *cmp->lo)) ||
+                ((cmp->con->LOHI) && (result >= *cmp->lo)) ||
+                ((cmp->con->HILO) && (result < *cmp->hi)) ||
+                ((cmp->con->HIHI) && (result >= *cmp->hi)) ||
+                ((cmp->con->BTWN) && (result >= *cmp->lo) && (result < *cmp->hi));
+        if (event) {
+            cmp->con->STAT = 1;
+            cmp->con->CHNL = cmp->channel;
+            *cmp->flag = 1;
+        }
+    }
+}
+
+static void host_adc_comparator_init(uint16_t comparator, volatile uint16_t* source, uint16_t channel)
+{
+    HOST_ADC_COMPARATOR_t* cmp = &host_adc_comparator[comparator];
+    
+    cmp->source = source;
+    cmp->channel = channel;
+}
+
+void host_adc_filter_trigger(void)
+{
+    uint16_t i;
+    HOST_ADC_FILTER_t* fl;
+    
+    for (i = 0; i < HOST_ADC_FILTERS; i++) {
+        fl = &host_adc_filter[i];
+        if (!fl->enabled) continue;
+        fl->sum += *fl->source;
+        if (++fl->count >= (1 << fl->avg_log2)) {
+            *fl->result = (uint16_t)(fl->sum >> fl->avg_log2);
+            fl->sum = 0;
+            fl->count = 0;
+        }
+    }
+}
+
+static void host_adc_filter_init(uint16_t filter, volatile uint16_t* source, volatile uint16_t* result, 
+                    uint16_t avg_log2)
+{
+    HOST_ADC_FILTER_t* fl = &host_adc_filter[filter];
+    
+    fl->source = source;
+    fl->result = result;
+    fl->avg_log2 = avg_log2;
+    fl->sum = 0;
+    fl->count = 0;
+    fl->enabled = USE_ADC_HW_FILTERS;
+}
+
+void host_dma_trigger(uint16_t channel)
+{
+    HOST_DMA_CHANNEL_t* dma = &host_dma[channel];
+    
+    if (!dma->enabled) return;
+    
+    *dma->destination++ = *dma->source;
+    if (--dma->count == 0) {        // Reload destination address and transfer count
+        dma->destination = dma->buffer;
+        dma->count = dma->length;
+    }
+    *dma->dmadst = (uint16_t)(uintptr_t)dma->destination;
+}
+
+static void host_dma_init(uint16_t channel, volatile uint16_t* source, volatile uint16_t* dmadst, 
+                    volatile uint16_t* buffer, uint16_t length)
+{
+    HOST_DMA_CHANNEL_t* dma = &host_dma[channel];
+    
+    dma->source = source;
+    dma->buffer = buffer;
+    dma->destination = buffer;
+    dma->dmadst = dmadst;
+    dma->length = length;
+    dma->count = length;
+    dma->enabled = false;
+    *dmadst = (uint16_t)(uintptr_t)buffer;
+}
+
+/* init_pwm.c */
+volatile uint16_t init_pwm(void)
+{
+    PG1IOCONLbits.OVRENH = 1;   // PWMxH output overridden (off)
+    PG1DC = MAX_DUTY_CYCLE;
+    PG1PER = PWM_PERIOD;
+    PG1FPCIHbits.SWPCI = 0;     // Fault PCI driven by SWPCI only (USE_FAULT_ENGINE)
+    PG1FPCILbits.SWTERM = 0;
+    host_peripherals.pwm_fault = false;
+    return(1);
+}
+
+volatile uint16_t init_trig_pwm(void)
+{
+    MPER = PWM_PERIOD;
+    PG2TRIGA = VOUT_ADCTRIG;
+    return(1);
+}
+
+volatile uint16_t launch_pwm(void)
+{
+    host_peripherals.pwm_running = true;
+    return(1);
+}
+
+/* init_acmp.c */
+volatile uint16_t init_acmp(void)
+{
+    DAC1DATH = (INIT_DACDATH & 0x0FFF);
+    DAC1DATL = (INIT_DACDATL & 0x0FFF);
+    SLP1DAT = 0;
+    return(1);
+}
+
+volatile uint16_t launch_acmp(void)
+{
+    host_peripherals.acmp_running = true;
+    return(1);
+}
+
+/* init_adc.c */
+volatile uint16_t init_vin_adc(void)
+{
+    host_adc_filter_init(VIN_ADC_FILTER, &REG_VIN_ADCBUF, &REG_VIN_ADFLDAT, VIN_ADC_FILTER_AVG_LOG2);
+    host_adc_comparator_init(VIN_ADC_COMPARATOR, &REG_VIN_ADCBUF, 12);
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).CMPEN = 1;
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).HIHI = 1;
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).LOLO = 1;
+    ADC_COMPARATOR_LO(VIN_ADC_COMPARATOR) = FAULT_VIN_UV;
+    ADC_COMPARATOR_HI(VIN_ADC_COMPARATOR) = FAULT_VIN_OV;
+    ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR) = USE_FAULT_ENGINE;
+    return(1);
+}
+
+volatile uint16_t init_adc(void)
+{
+    host_adc_filter_init(VOUT_ADC_FILTER, &REG_VOUT_ADCBUF, &REG_VOUT_ADFLDAT, VOUT_ADC_FILTER_AVG_LOG2);
+    host_adc_comparator_init(VOUT_ADC_COMPARATOR, &REG_VOUT_ADCBUF, 16);
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).CMPEN = USE_FAULT_ENGINE;
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).HIHI = 1;
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).LOLO = 0;
+    ADC_COMPARATOR_LO(VOUT_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_HI(VOUT_ADC_COMPARATOR) = FAULT_VOUT_OV;
+    ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR) = USE_FAULT_ENGINE;
+    return(1);
+}
+
+volatile uint16_t init_pot_adc(void)
+{
+    host_adc_filter_init(VREF_ADC_FILTER, &REG_VREF_ADCBUF, &REG_VREF_ADFLDAT, EXT_REF_HW_AVG_LOG2);
+    return(1);
+}
+
+volatile uint16_t launch_adc(void)
+{
+    host_peripherals.adc_running = true;
+    return(1);
+}
+
+/* init_dma.c */
+volatile uint16_t init_dma_module(volatile uint16_t* ram_end)
+{
+    return(1);
+}
+
+volatile uint16_t init_dma_vin(volatile uint16_t* buffer, uint16_t length)
+{
+    host_dma_init(0, &REG_VIN_ADCBUF, &DMADST0, buffer, length);
+    return(1);
+}
+
+volatile uint16_t init_dma_vref(volatile uint16_t* buffer, uint16_t length)
+{
+    host_dma_init(1, &REG_VREF_ADCBUF, &DMADST1, buffer, length);
+    return(1);
+}
+
+volatile uint16_t launch_dma(void)
+{
+    host_dma[0].enabled = (host_dma[0].buffer != NULL);   // Only channels set up by init_dma_vin/vref()
+    host_dma[1].enabled = (host_dma[1].buffer != NULL);
+    return(1);
+}
+
+/* init_ccp.c: the host clock needs no initialization */
+volatile uint16_t init_ccp1_timer(void)
+{
+    return(1);
+}
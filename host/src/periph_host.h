@@ -0,0 +1,122 @@
+/* 
+ * File:   periph_host.h
+ * Author: M91406
+ * Comments: host replacements of the peripheral initialization routines
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef HOST_PERIPHERALS_H
+#define	HOST_PERIPHERALS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <xc.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Host Peripherals
+ * *************************************************************************************************
+ * The peripheral initialization routines of qr-mode_setup.X/src/init are replaced by functions
+ * writing the register values the plant model depends on (see src/periph_host.c). Any change
+ * of these register settings in the firmware needs to be reflected here.
+ * 
+ * The launch routines set the run-flags below, which are evaluated by the simulator to start
+ * triggering the ADC interrupt service routines and to let the plant model switch.
+ * 
+ * The fault PCI of PWM generator 1 (latched acceptance, software PCI source) is emulated by 
+ * host_pwm_fault_update(), which is called by the simulator at the start of every switching 
+ * cycle: SWPCI = 1 latches the fault, a write of '1' to SWTERM with SWPCI = 0 terminates it.
+ * While the fault is latched, the PWM output does not switch.
+ * *************************************************************************************************/
+
+typedef struct {
+    bool adc_running;   // ADC module launched (interrupts are triggered every PWM cycle)
+    bool acmp_running;  // Comparator/DAC launched
+    bool pwm_running;   // PWM module launched
+    bool pwm_fault;     // Fault PCI of PWM generator 1 latched (PWM output forced off)
+}HOST_PERIPHERALS_t;
+
+extern HOST_PERIPHERALS_t host_peripherals;
+
+/*!Host DMA Channels
+ * *************************************************************************************************
+ * The DMA channels configured by init_dma_vin() and init_dma_vref() are emulated by 
+ * host_dma_trigger(), which is called by the simulator whenever the ADC result of the channel's 
+ * trigger source has been updated. Each call transfers one word from the source register to the 
+ * destination buffer, advances the destination address register DMADSTx and reloads the 
+ * destination address after 'length' transfers (repeated one-shot mode with reload).
+ * *************************************************************************************************/
+
+#define HOST_DMA_CHANNELS   2   // Channel 0: input voltage (AN12), channel 1: external reference (AN6)
+
+typedef struct {
+    volatile uint16_t* source;      // Source register (ADC buffer)
+    volatile uint16_t* buffer;      // Start of the destination buffer (reload address)
+    volatile uint16_t* destination; // Next destination location
+    volatile uint16_t* dmadst;      // Destination address register of the channel
+    uint16_t length;                // Number of transfers per buffer (reload count)
+    uint16_t count;                 // Remaining number of transfers until reload
+    bool enabled;                   // Channel enabled by launch_dma()
+}HOST_DMA_CHANNEL_t;
+
+extern HOST_DMA_CHANNEL_t host_dma[HOST_DMA_CHANNELS];
+
+/*!Host ADC Digital Filters
+ * *************************************************************************************************
+ * The ADC digital filters configured by the ADC initialization routines (averaging mode) are 
+ * emulated by host_adc_filter_trigger(), which is called by the simulator after every update of 
+ * the ADC buffers. Each enabled filter accumulates its input and writes the average of 2^n 
+ * samples into its result register ADFLxDAT.
+ * *************************************************************************************************/
+
+#define HOST_ADC_FILTERS    4   // Number of ADC digital filters (ADFL0...ADFL3)
+
+typedef struct {
+    volatile uint16_t* source;      // ADC buffer of the filter input channel
+    volatile uint16_t* result;      // Filter result register ADFLxDAT
+    uint16_t avg_log2;              // Averaging ratio of 2^avg_log2 samples
+    uint32_t sum;                   // Accumulator of the current block
+    uint16_t count;                 // Number of samples accumulated in the current block
+    bool enabled;                   // Filter enabled (ADFLxCON.FLEN)
+}HOST_ADC_FILTER_t;
+
+extern HOST_ADC_FILTER_t host_adc_filter[HOST_ADC_FILTERS];
+
+/*!Host ADC Digital Comparators
+ * *************************************************************************************************
+ * The ADC digital comparators configured by the ADC initialization routines are emulated by 
+ * host_adc_comparator_trigger(), which is called by the simulator after every update of the 
+ * ADC buffers. Each enabled comparator evaluates the event conditions selected in ADCMPxCON
+ * for its input channel and sets ADCMPxCON.STAT and its interrupt flag on an event. The 
+ * simulator calls the interrupt service routine when the interrupt is enabled.
+ * *************************************************************************************************/
+
+#define HOST_ADC_COMPARATORS    4   // Number of ADC digital comparators (ADCMP0...ADCMP3)
+
+typedef struct {
+    volatile uint16_t* source;      // ADC buffer of the comparator input channel
+    volatile ADCMPxCONBITS* con;    // Comparator control register ADCMPxCON
+    volatile uint16_t* lo;          // Lower threshold register ADCMPxLO
+    volatile uint16_t* hi;          // Upper threshold register ADCMPxHI
+    volatile uint16_t* flag;        // Interrupt flag bit _ADCMPxIF
+    uint16_t channel;               // Input channel number
+}HOST_ADC_COMPARATOR_t;
+
+extern HOST_ADC_COMPARATOR_t host_adc_comparator[HOST_ADC_COMPARATORS];
+
+extern void host_peripherals_reset(void);
+extern void host_dma_trigger(uint16_t channel);
+extern void host_adc_filter_trigger(void);
+extern void host_adc_comparator_trigger(void);
+extern bool host_pwm_fault_update(void);
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* HOST_PERIPHERALS_H */
@@ -0,0 +1,82 @@
+/*
+ * File:   sfr_host.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 9:20 AM
+ * 
+ * RAM stand-ins of the Special Function Registers declared in include/xc.h
+ */
+
+#include <time.h>
+#include <xc.h>
+
+#define HOST_TIMER_FREQUENCY    100000000UL // device instruction clock in [Hz] (see CPU_FREQUENCY)
+
+volatile uint16_t CORCON = 0x0020;  // Device reset value (SATDW enabled)
+volatile uint16_t DISICNT = 0;
+
+volatile uint16_t MPER = 0;
+volatile uint16_t PG1PER = 0;
+volatile uint16_t PG1DC = 0;
+volatile PGxIOCONLBITS PG1IOCONLbits = { 0 };
+volatile PGxSTATBITS PG1STATbits = { 0 };
+volatile PGxSTATBITS PG2STATbits = { 0 };
+volatile PGxyPCIHBITS PG1FPCIHbits = { 0 };
+volatile PGxyPCILBITS PG1FPCILbits = { 0 };
+volatile uint16_t PG2TRIGA = 0;
+
+volatile uint16_t DAC1DATH = 0;
+volatile uint16_t DAC1DATL = 0;
+volatile uint16_t SLP1DAT = 0;
+
+volatile uint16_t ADCBUF6 = 0;
+volatile uint16_t ADCBUF12 = 0;
+volatile uint16_t ADCBUF16 = 0;
+
+volatile uint16_t ADFL0DAT = 0;
+volatile uint16_t ADFL1DAT = 0;
+volatile uint16_t ADFL2DAT = 0;
+volatile uint16_t ADFL3DAT = 0;
+
+volatile uint16_t _ADCAN6IF = 0;
+volatile uint16_t _ADCAN6IE = 0;
+volatile uint16_t _ADCAN16IF = 0;
+
+volatile ADCMPxCONBITS ADCMP0CONbits = { 0 };
+volatile ADCMPxCONBITS ADCMP1CONbits = { 0 };
+volatile ADCMPxCONBITS ADCMP2CONbits = { 0 };
+volatile ADCMPxCONBITS ADCMP3CONbits = { 0 };
+volatile uint16_t ADCMP0LO = 0;
+volatile uint16_t ADCMP0HI = 0;
+volatile uint16_t ADCMP1LO = 0;
+volatile uint16_t ADCMP1HI = 0;
+volatile uint16_t ADCMP2LO = 0;
+volatile uint16_t ADCMP2HI = 0;
+volatile uint16_t ADCMP3LO = 0;
+volatile uint16_t ADCMP3HI = 0;
+
+volatile uint16_t _ADCMP0IF = 0;
+volatile uint16_t _ADCMP0IE = 0;
+volatile uint16_t _ADCMP1IF = 0;
+volatile uint16_t _ADCMP1IE = 0;
+volatile uint16_t _ADCMP2IF = 0;
+volatile uint16_t _ADCMP2IE = 0;
+volatile uint16_t _ADCMP3IF = 0;
+volatile uint16_t _ADCMP3IE = 0;
+
+volatile uint16_t DMADST0 = 0;
+volatile uint16_t DMADST1 = 0;
+
+volatile uint16_t TMR1 = 0;
+volatile uint16_t _T1IF = 0;
+
+/* Stand-in of the free-running profiler time base SCCP1 */
+uint16_t host_timer_ticks(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return((uint16_t)(((uint64_t)t.tv_sec * HOST_TIMER_FREQUENCY) + 
+        ((uint64_t)t.tv_nsec / (1000000000UL / HOST_TIMER_FREQUENCY))));
+}
+
@@ -0,0 +1,42 @@
+/*
+ * File:   vout_isr_asm.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 7:30 PM
+ * 
+ * Host translation of qr-mode_setup.X/src/vout_isr_asm.s
+ * 
+ * The assembly routine executes the coefficient bank commit and the 2P2Z compensator inline
+ * in the alternate working register set of the voltage loop interrupt. On the host, the same
+ * sequence is executed by the host translations of the template routines. As on the device,
+ * the routine is declared weak and is overridden by the C-ISR of pwr_control.c when 
+ * USE_ALT_WREG_ISR is disabled.
+ * 
+ * As on the device, the feed-forward gain is applied to the control output whenever the
+ * controller is enabled, independent of USE_LINE_FEEDFORWARD (unity gain when disabled).
+ */
+
+#include <xc.h>
+#include <stdint.h>
+
+#include "globals.h"
+#include "c2p2z.h"
+#include "task_line_feedforward.h"
+
+void __attribute__((weak)) _ADCAN16Interrupt(void)
+{
+    uint16_t t_entry, t_dac;
+
+    t_entry = CCP1TMRL; // capture ISR entry time stamp (profiler time base)
+
+    npnz16b_CommitCoefficients(&c2p2z); // activate pending coefficient bank at sample boundary
+    if (c2p2z.status.bits.enable) {
+        c2p2z_Update(&c2p2z); // read ADC buffer and compute control output
+        DAC1DATH = line_feedforward_apply(*c2p2z.ptrTarget); // input voltage feed-forward
+    }
+
+    t_dac = CCP1TMRL;   // capture DAC update time stamp
+    _ADCAN16IF = 0;     // clear the ADCAN16 interrupt flag
+
+    vout_isr_complete(t_entry, t_dac);
+}
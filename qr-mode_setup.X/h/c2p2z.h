@@ -20,53 +20,18 @@
 #include <stdint.h>
 
 #include "npnz16b.h"
+#include "npnz16b_template.h"
 
 /* ***************************************************************************************
  * Data Arrays:
- * The cNPNZ_t data structure contains a pointer to derived coefficients in X-space and
- * other pointers to controller and error history in Y-space.
- * This header file holds public declarations for variables and arrays defined in 
- * c2p2z.c
+ * The cNPNZ_t data structure contains pointers to coefficient, control and error history 
+ * arrays. The pointer target objects (variables and arrays) are defined in c2p2z.c
  * 
- * Type definition for A- and B- coefficient arrays and error- and control-history arrays, 
- * which are aligned in memory for optimized addressing during DSP computations.           
- * These data structures need to be placed in specific memory locations to allow direct    
- * X/Y-access from the DSP. (coefficients in x-space, histories in y-space)                
+ * Type definitions of the A- and B- coefficient arrays, error- and control-history arrays,
+ * the public declaration of the controller data object and the function call prototypes
+ * are generated by the generic nPnZ controller template (see npnz16b_template.h).
  * ***************************************************************************************/
 
-	typedef struct
-	{
-		volatile fractional ACoefficients[2]; // A-Coefficients
-		volatile fractional BCoefficients[3]; // B-Coefficients
-	} __attribute__((packed))C2P2Z_CONTROL_LOOP_COEFFICIENTS_t;
-
-	typedef struct
-	{
-		volatile fractional ControlHistory[2];  // Control History
-		volatile fractional ErrorHistory[3];    // Error History
-	} __attribute__((packed))C2P2Z_CONTROL_LOOP_HISTORIES_t;
-
-
-	extern volatile cNPNZ16b_t c2p2z; // user-controller data object
-
-/* ***************************************************************************************/
-
-// Function call prototypes for initialization routines and control loops
-
-extern inline uint16_t c2p2z_Init(void); // Loads default coefficients into 2P2Z controller and resets histories to zero
-
-extern inline void c2p2z_Reset( // Resets the 2P2Z controller histories
-	volatile cNPNZ16b_t* controller // Pointer to nPnZ data structure
-	);
-
-extern inline void c2p2z_Precharge( // Pre-charges histories of the 2P2Z with defined steady-state data
-	volatile cNPNZ16b_t* controller, // Pointer to nPnZ data structure
-	volatile uint16_t ctrl_input, // user-defined, constant error history value
-	volatile uint16_t ctrl_output // user-defined, constant control output history value
-	);
-
-extern inline void c2p2z_Update( // Calls the 2P2Z controller
-	volatile cNPNZ16b_t* controller // Pointer to nPnZ data structure
-	);
+	NPNZ16B_DECLARE(c2p2z, 2) // 2P2Z controller instance 'c2p2z'
 
 #endif	// end of __SPECIAL_FUNCTION_LAYER_C2P2Z_H__ header file section
@@ -0,0 +1,212 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   data_recorder.h
+ * Author: M91406
+ * Comments: triggered data recorder of the voltage loop signals
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef DATA_RECORDER_H
+#define	DATA_RECORDER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "fault_handler.h"
+#include "task_line_feedforward.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Data Recorder
+ * *************************************************************************************************
+ * Summary:
+ * Circular buffer of the voltage loop signals of every switching cycle with trigger
+ * 
+ * Description:
+ * data_recorder_capture() is called by the voltage loop interrupt service routine after the DAC
+ * update. While the recorder is active, it writes one sample per switching cycle into 'buffer'
+ * at position 'index' (wrapping at DATA_RECORDER_DEPTH):
+ * 
+ *    REC_ARM          arm request (written by data_recorder_init(), data_recorder_arm() or the
+ *                     debugger): clears the trigger and starts the recording
+ *    REC_PRETRIGGER   records DATA_RECORDER_PRETRIGGER samples, triggers are ignored
+ *    REC_ARMED        records continuously and evaluates the trigger sources in 'trigger_mask'
+ *    REC_TRIGGERED    records the remaining DATA_RECORDER_POSTTRIGGER - 1 samples after the 
+ *                     trigger sample
+ *    REC_COMPLETE     recording stopped, the buffer holds DATA_RECORDER_DEPTH samples starting 
+ *                     at 'index' (oldest) with the trigger sample at 'trigger'
+ * 
+ * Every call executes the same sequence of conditional statements without loops, the added 
+ * execution time is bounded and recorded in profiler channel PROF_RECORDER. Instructions per 
+ * call, estimated from the C source for the data object in near memory (branches taken count 
+ * two cycles, USE_FAULT_ENGINE enabled):
+ * 
+ *    Path                                          instructions    cycles
+ *    stopped or complete (REC_IDLE, REC_COMPLETE)        4             5
+ *    arm request (REC_ARM, first sample)                40            44
+ *    pre-trigger or post-trigger sample                 32            35
+ *    armed, trigger evaluation without event            48            53
+ *    armed, trigger event (worst case)                  53            57
+ * 
+ *    sample write (index, five signals, wrap-around)    19            19
+ *    trigger evaluation (five sources, mask)            21            25
+ *    trigger event (source, position, counter, state)    5             5
+ * 
+ * The figures are estimates, they have not been confirmed with the compiler listing. The
+ * maximum of PROF_RECORDER on the device (including approx. 4 ticks of time base access) has 
+ * to stay at or below the worst case of about 61 ticks, otherwise the table has to be 
+ * corrected from the listing of the voltage loop interrupt service routine. The data object
+ * is accessed by the interrupt service routine only; once complete, it can be read by the 
+ * debugger while the converter is running. 
+ * 
+ * The 'period' of a sample is the content of MPER at the time of the sample. The sample times
+ * are reconstructed by accumulating the periods (valley switching changes the period between
+ * switching cycles).
+ * *************************************************************************************************/
+
+typedef enum {
+    REC_IDLE         = 0,   // Recorder stopped
+    REC_COMPLETE     = 1,   // Recording completed after a trigger event
+    REC_ARM          = 2,   // Arm request
+    REC_PRETRIGGER   = 3,   // Recording of the pre-trigger samples
+    REC_ARMED        = 4,   // Waiting for a trigger event
+    REC_TRIGGERED    = 5    // Recording of the post-trigger samples
+}DATA_RECORDER_STATE_e;
+
+typedef enum {
+    REC_TRIG_NONE       = 0x0000, // No trigger source
+    REC_TRIG_FAULT      = 0x0001, // Fault shutdown (fault PCI or FAULT flag bit)
+    REC_TRIG_SATURATION = 0x0002, // Compensator output clamped at its maximum
+    REC_TRIG_STATE      = 0x0004, // Soft-start phase different from the phase at arming
+    REC_TRIG_VOUT_ABOVE = 0x0008, // Output voltage sample above 'trigger_level'
+    REC_TRIG_VOUT_BELOW = 0x0010  // Output voltage sample below 'trigger_level'
+}DATA_RECORDER_TRIGGER_e;
+
+typedef struct {
+    volatile uint16_t v_out;        // Output voltage sample in [ADC ticks]
+    volatile uint16_t reference;    // Control reference in [ADC ticks]
+    volatile uint16_t ctrl_out;     // Compensator output in [DAC ticks]
+    volatile uint16_t dac;          // Peak current reference in [DAC ticks]
+    volatile uint16_t period;       // Switching period (MPER) in [PWM ticks]
+}DATA_RECORDER_SAMPLE_t;            // Voltage loop signals of one switching cycle
+
+typedef struct {
+    volatile uint16_t state;        // Recorder state (DATA_RECORDER_STATE_e), REC_ARM re-arms the recorder
+    volatile uint16_t trigger_mask; // Enabled trigger sources (DATA_RECORDER_TRIGGER_e)
+    volatile uint16_t trigger_level; // Output voltage threshold of the level triggers in [ADC ticks]
+    volatile uint16_t source;       // Trigger sources of the recorded event
+    volatile uint16_t phase;        // Soft-start phase at arming
+    volatile uint16_t index;        // Next write position, oldest sample once complete
+    volatile uint16_t trigger;      // Position of the trigger sample
+    volatile uint16_t counter;      // Remaining samples of the pre- or post-trigger recording
+    volatile uint16_t depth;        // Number of samples of the buffer (DATA_RECORDER_DEPTH)
+    volatile uint16_t pretrigger;   // Number of samples before the trigger (DATA_RECORDER_PRETRIGGER)
+    volatile DATA_RECORDER_SAMPLE_t buffer[DATA_RECORDER_DEPTH]; // Circular sample buffer
+}DATA_RECORDER_t;                   // Triggered data recorder
+
+extern volatile DATA_RECORDER_t data_recorder;
+
+extern volatile uint16_t data_recorder_init(void);
+extern volatile uint16_t data_recorder_arm(uint16_t trigger_mask, uint16_t trigger_level);
+
+/*!data_recorder_capture
+ * *************************************************************************************************
+ * Records the voltage loop signals of the recent switching cycle and evaluates the trigger
+ * *************************************************************************************************/
+
+static inline void data_recorder_capture(void)
+{
+    volatile DATA_RECORDER_SAMPLE_t* sample;
+    uint16_t state, index, v_out, mask, source;
+    
+    state = data_recorder.state;
+    if (state < REC_ARM) return;    // Stopped or complete
+    
+    if (state == REC_ARM) {
+        data_recorder.phase = converter.soft_start.phase;
+        data_recorder.source = REC_TRIG_NONE;
+        data_recorder.index = 0;
+        data_recorder.counter = DATA_RECORDER_PRETRIGGER;
+        state = REC_PRETRIGGER;
+    }
+    
+    index = data_recorder.index;
+    v_out = REG_VOUT_ADCBUF;
+    
+    sample = &data_recorder.buffer[index];
+    sample->v_out = v_out;
+    sample->reference = *c2p2z.ptrControlReference;
+    #if (USE_LINE_FEEDFORWARD == true)
+    sample->ctrl_out = line_feedforward.ctrl_out;
+    #else
+    sample->ctrl_out = DAC_VREF_REGISTER;
+    #endif
+    sample->dac = DAC_VREF_REGISTER;
+    sample->period = MPER;
+    
+    data_recorder.index = ((index + 1) & DATA_RECORDER_MASK);
+    
+    if (state == REC_ARMED) {
+        
+        mask = data_recorder.trigger_mask;
+        source = REC_TRIG_NONE;
+        
+        #if (USE_FAULT_ENGINE == true)
+        if (fault_handler.tripped) source |= REC_TRIG_FAULT;
+        #else
+        if (converter.status.flags.fault_active) source |= REC_TRIG_FAULT;
+        #endif
+        if (c2p2z.status.bits.flt_clamp_max) source |= REC_TRIG_SATURATION;
+        if (converter.soft_start.phase != data_recorder.phase) source |= REC_TRIG_STATE;
+        if (v_out > data_recorder.trigger_level) source |= REC_TRIG_VOUT_ABOVE;
+        if (v_out < data_recorder.trigger_level) source |= REC_TRIG_VOUT_BELOW;
+        
+        source &= mask;
+        if (source) {
+            data_recorder.source = source;
+            data_recorder.trigger = index;
+            data_recorder.counter = (DATA_RECORDER_POSTTRIGGER - 1);
+            state = REC_TRIGGERED;
+        }
+    }
+    else if (--data_recorder.counter == 0) {
+        state = (state == REC_PRETRIGGER) ? REC_ARMED : REC_COMPLETE;
+    }
+    
+    data_recorder.state = state;
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* DATA_RECORDER_H */
+
@@ -0,0 +1,177 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   event_log.h
+ * Author: M91406
+ * Comments: event log of the power controller
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef EVENT_LOG_H
+#define	EVENT_LOG_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "scheduler.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Event Log
+ * *************************************************************************************************
+ * Summary:
+ * Ring buffer of time-stamped power controller events
+ * 
+ * Description:
+ * Events are written by the power controller state machine (scheduler context), the voltage 
+ * loop interrupt service routine and the fault interrupt service routines. Each event is 
+ * stored with the number of scheduler ticks and the Timer1 counter value within the tick
+ * (see scheduler_timestamp()). Once the ring buffer is full, the oldest event is overwritten.
+ * 
+ * The writers do not wait for each other: an entry is claimed by incrementing 'head', which 
+ * is the only data shared by all writers. As the device has no atomic fetch-and-increment 
+ * instruction, the claim defers interrupts of priority 1 to 6 for the two instructions 
+ * reading and writing 'head' (DISI). The entry itself is written with interrupts enabled:
+ * 'code' is cleared first and written last, an entry with code EVT_NONE is incomplete.
+ * 
+ * The debugger may read the data object at any time while the converter is running: the 
+ * newest event is at (head - 1) & EVENT_LOG_MASK, events logged between reading 'head' and 
+ * the entries may have overwritten the oldest entries.
+ * *************************************************************************************************/
+
+typedef enum {
+    EVT_NONE        = 0,    // Empty entry or entry being written
+    EVT_PHASE       = 1,    // Soft-start phase transition (data: previous phase << 8 | new phase)
+    EVT_STATUS      = 2,    // Converter status change (data: previous op_status << 8 | new op_status)
+    EVT_FAULT       = 3,    // Fault shutdown (data: fault source FAULT_SOURCE_e)
+    EVT_STATE_ERROR = 4,    // Undefined state of the power controller (data: soft-start phase)
+    EVT_SAT_BEGIN   = 5,    // Compensator output clamped at its maximum (data: control reference)
+    EVT_SAT_END     = 6,    // End of the saturation episode (data: duration up to the last saturated cycle in switching cycles)
+    EVT_RESTART     = 7     // Fault released, restart attempt (data: restarts since the back-off reset)
+}EVENT_LOG_CODE_e;
+
+typedef struct {
+    volatile uint32_t ticks;        // Time stamp: number of scheduler ticks
+    volatile uint16_t timer;        // Time stamp: Timer1 counter value within the tick in [cycles]
+    volatile uint16_t code;         // Event code (EVENT_LOG_CODE_e)
+    volatile uint16_t data;         // Event argument
+}EVENT_LOG_ENTRY_t;                 // Event log entry
+
+typedef struct {
+    volatile uint16_t head;         // Number of events logged, the next event is written at head & EVENT_LOG_MASK
+    volatile uint16_t phase;        // Soft-start phase of the last phase transition
+    volatile uint16_t op_status;    // Converter status of the last status change
+    volatile uint16_t sat_cycles;   // Duration of the recent saturation episode in [switching cycles]
+    volatile uint16_t sat_release;  // Number of switching cycles without saturation within the episode
+    volatile EVENT_LOG_ENTRY_t buffer[EVENT_LOG_DEPTH]; // Ring buffer of events
+}EVENT_LOG_t;                       // Event log of the power controller
+
+extern volatile EVENT_LOG_t event_log;
+
+extern volatile uint16_t event_log_init(void);
+
+/*!event_log_write
+ * *************************************************************************************************
+ * Adds an event to the event log
+ * *************************************************************************************************/
+
+static inline void event_log_write(uint16_t code, uint16_t data)
+{
+    volatile EVENT_LOG_ENTRY_t* entry;
+    uint16_t index, timer;
+    
+    __builtin_disi(0x3FFF);         // Defer interrupts of priority 1 to 6
+    index = event_log.head;         // Claim the next entry
+    event_log.head = (index + 1);
+    DISICNT = 0;                    // Enable interrupts
+    
+    entry = &event_log.buffer[index & EVENT_LOG_MASK];
+    entry->code = EVT_NONE;         // Invalidate entry while it is written
+    entry->ticks = scheduler_timestamp(&timer);
+    entry->timer = timer;
+    entry->data = data;
+    entry->code = code;             // Publish entry
+}
+
+/*!event_log_monitor
+ * *************************************************************************************************
+ * Logs soft-start phase transitions and converter status changes (scheduler context)
+ * *************************************************************************************************/
+
+static inline void event_log_monitor(void)
+{
+    uint16_t phase = converter.soft_start.phase;
+    uint16_t op_status = converter.status.flags.op_status;
+    
+    if (phase != event_log.phase) {
+        event_log_write(EVT_PHASE, ((event_log.phase << 8) | (phase & 0x00FF)));
+        event_log.phase = phase;
+    }
+    
+    if (op_status != event_log.op_status) {
+        event_log_write(EVT_STATUS, ((event_log.op_status << 8) | op_status));
+        event_log.op_status = op_status;
+    }
+}
+
+/*!event_log_saturation
+ * *************************************************************************************************
+ * Logs saturation episodes of the compensator output at its maximum (voltage loop interrupt)
+ * 
+ * An episode ends after EVENT_LOG_SAT_RELEASE cycles without saturation or when the control 
+ * loop has been disabled. Its duration saturates at 0xFFFF cycles.
+ * *************************************************************************************************/
+
+static inline void event_log_saturation(void)
+{
+    uint16_t cycles = event_log.sat_cycles;
+    
+    if ((c2p2z.status.bits.enable) && (c2p2z.status.bits.flt_clamp_max)) {
+        if (cycles == 0)
+            event_log_write(EVT_SAT_BEGIN, *c2p2z.ptrControlReference);
+        cycles += (event_log.sat_release + 1);
+        event_log.sat_cycles = (cycles < event_log.sat_cycles) ? 0xFFFF : cycles;
+        event_log.sat_release = 0;
+    }
+    else if (cycles) {
+        if ((++event_log.sat_release >= EVENT_LOG_SAT_RELEASE) || (!c2p2z.status.bits.enable)) {
+            event_log_write(EVT_SAT_END, cycles);
+            event_log.sat_cycles = 0;
+            event_log.sat_release = 0;
+        }
+    }
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* EVENT_LOG_H */
+
@@ -0,0 +1,105 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   fault_handler.h
+ * Author: M91406
+ * Comments: hardware fault shutdown and restart back-off of the power controller
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef FAULT_HANDLER_H
+#define	FAULT_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Fault Handler
+ * *************************************************************************************************
+ * Summary:
+ * Hardware fault shutdown by the ADC digital comparators and the PWM fault PCI
+ * 
+ * Description:
+ * The ADC digital comparators VIN_ADC_COMPARATOR and VOUT_ADC_COMPARATOR compare every 
+ * conversion of the input and output voltage against their thresholds (see globals.h). An
+ * out-of-range sample calls _VIN_FAULTInterrupt or _VOUT_FAULTInterrupt, which
+ * 
+ *    - set the software PCI input SWPCI of the fault PCI of PWM generator 1 (latched 
+ *      acceptance, PWMxH is forced to FLTDAT immediately)
+ *    - disable the voltage loop compensator
+ *    - record the fault source and disable their own interrupt
+ * 
+ * The power controller state machine detects 'tripped' at the next scheduler tick, shuts the
+ * converter down and calls fault_handler_release() every tick in SS_FAULT. The fault is
+ * released when the restart back-off has expired, the input voltage is within the release 
+ * window and the output voltage is below the over-voltage threshold: SWPCI is cleared, the 
+ * latched fault is terminated at the next end of cycle (SWTERM) and the comparator 
+ * interrupts are enabled again. The back-off doubles with every restart up to 
+ * FAULT_RESTART_MAX and is reset by fault_handler_monitor() after FAULT_RESTART_RESET ticks
+ * of normal operation.
+ * 
+ * The output under-voltage protection is armed by fault_handler_monitor() in normal operation
+ * (SS_COMPLETE) only. Its threshold follows the output voltage reference.
+ * *************************************************************************************************/
+
+typedef enum {
+    FAULT_SRC_NONE    = 0x0000, // No fault
+    FAULT_SRC_VIN_UV  = 0x0001, // Input voltage below FAULT_VIN_UVLO
+    FAULT_SRC_VIN_OV  = 0x0002, // Input voltage above FAULT_VIN_OVLO
+    FAULT_SRC_VOUT_OV = 0x0004, // Output voltage above FAULT_VOUT_OVP
+    FAULT_SRC_VOUT_UV = 0x0008, // Output voltage below FAULT_VOUT_UVP_RATIO x reference in normal operation
+    FAULT_SRC_STATE   = 0x0010  // Undefined state of the power controller state machine
+}FAULT_SOURCE_e;
+
+typedef struct {
+    volatile bool tripped;          // PWM output has been shut down by the fault PCI
+    volatile bool uvp_armed;        // Output under-voltage protection is active
+    volatile uint16_t source;       // Fault sources since the last restart (FAULT_SOURCE_e)
+    volatile uint16_t restart_delay; // Restart back-off in [scheduler ticks]
+    volatile uint16_t counter;      // Scheduler ticks since the shutdown or in normal operation
+    volatile uint16_t retries;      // Consecutive restarts without FAULT_RESTART_RESET ticks of normal operation
+    volatile uint16_t events;       // Number of fault shutdowns since power-up
+}FAULT_HANDLER_t;                   // Fault handler status
+
+extern volatile FAULT_HANDLER_t fault_handler;
+
+extern volatile uint16_t fault_handler_init(void);
+extern volatile uint16_t fault_handler_trip(uint16_t source);
+extern volatile uint16_t fault_handler_release(void);
+extern volatile uint16_t fault_handler_monitor(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* FAULT_HANDLER_H */
+
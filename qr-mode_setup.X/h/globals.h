@@ -40,6 +40,8 @@
 // List of user included header files
 #include "init/init_fosc.h"
 #include "init/init_timer1.h"
+#include "init/init_ccp.h"
+#include "init/init_dma.h"
 #include "init/init_gpio.h"
 
 #include "init/init_acmp.h"
@@ -48,6 +50,7 @@
 
 #include "pwr_control.h"
 #include "task_external_reference.h"
+#include "task_gain_scheduler.h"
 
 
 #ifdef	__cplusplus
@@ -205,13 +208,26 @@ extern "C" {
 #define VOUT_FB_GAIN  (float)((VOUT_R2) / (VOUT_R1 + VOUT_R2))
 #define V_OUT_REF     (uint16_t)(VOUT_NOMINAL * VOUT_FB_GAIN / ADC_GRAN)
 
+#define VIN_R1        (15.8)          // Upper input voltage divider resistor in kOhm
+#define VIN_R2        (1.0)           // Lower input voltage divider resistor in kOhm
+
+#define VIN_FB_GAIN   (float)((VIN_R2) / (VIN_R1 + VIN_R2))
+
+// Flyback power stage parameters (generic 10 W design assumptions, used by the valley control)
+#define FLYBACK_LP          3.3e-6          // Primary magnetizing inductance in [H]
+#define FLYBACK_TURNS_RATIO 1.0             // Transformer turns ratio Np/Ns
+#define FLYBACK_COSS        200e-12         // Effective drain node capacitance in [F]
+#define FLYBACK_VF          0.5             // Output rectifier forward voltage in [V]
+#define CS_GAIN             0.65            // Current sense gain at the comparator input in [V/A]
+
 /*!State Machine Settings
  * *************************************************************************************************
  * Summary:
  * Global defines for state-machine specific parameters
  * 
  * Description:
- * This section is used to define state-machine settings such as the main execution call interval. 
+ * This section is used to define state-machine settings such as the main execution call interval
+ * (scheduler tick period, see scheduler.h). 
  * Pre-compiler macros are used to translate physical values into binary (integer) numbers to be 
  * written to SFRs and variables.
  * 
@@ -219,6 +235,7 @@ extern "C" {
     
 #define MAIN_EXECUTION_PERIOD    100e-6     // main state machine pace period in [sec]
 #define MAIN_EXEC_PER           (uint16_t)((CPU_FREQUENCY * MAIN_EXECUTION_PERIOD)-1.0)
+#define SCHEDULER_ISR_PRIORITY  1          // interrupt priority of the scheduler tick (Timer1)
 
 /*!Startup Behavior
  * *************************************************************************************************
@@ -235,16 +252,92 @@ extern "C" {
  * Pre-compiler macros are used to translate physical values into binary (integer) numbers to 
  * be written to SFRs and variables.
  * 
+ * Delays are converted into numbers of scheduler ticks (MAIN_EXECUTION_PERIOD). The ramp is 
+ * specified by its output voltage slope RAMP_SLOPE, which is converted into a reference 
+ * increment per scheduler tick in Q16 format (REF_STEP). The soft-start accumulates the 
+ * fractional part of the reference, the ramp slope does therefore not depend on the granularity
+ * of the ADC. The ramp from zero to the nominal output voltage lasts RAMP_PERIOD. Tick counts 
+ * exceeding 16 bit and slopes resulting in an increment of less than 1 LSB (Q16) per tick or 
+ * in a ramp shorter than one tick are rejected at compile time (see pwr_control.c).
+ * 
  * *************************************************************************************************/
 
 #define POWER_ON_DELAY          500e-3      // power on delay in [sec]
-#define RAMP_PERIOD             50e-3         // ramp period in [sec]
-#define POWER_GOOD_DELAY        100e-3        // power good in [sec]
+#define RAMP_SLOPE              300.0       // output voltage slope of the ramp in [V/sec]
+#define POWER_GOOD_DELAY        100e-3      // power good in [sec]
+
+//------ macros
+#define RAMP_PERIOD (VOUT_NOMINAL / RAMP_SLOPE)     // ramp period from zero to the nominal output voltage in [sec]
+#define RAMP_STEP   (RAMP_SLOPE * MAIN_EXECUTION_PERIOD * VOUT_FB_GAIN / ADC_GRAN * 65536.0) // reference increment per scheduler tick in [ADC ticks x 2^16]
+
+#define POD         (uint16_t)((POWER_ON_DELAY / MAIN_EXECUTION_PERIOD) + 0.5)     // power on delay in [scheduler ticks]
+#define RPER        (uint16_t)((RAMP_PERIOD / MAIN_EXECUTION_PERIOD) + 0.5)        // ramp period in [scheduler ticks]
+#define PGD         (uint16_t)((POWER_GOOD_DELAY / MAIN_EXECUTION_PERIOD) + 0.5)   // power good delay in [scheduler ticks]
+#define REF_STEP    (uint32_t)(RAMP_STEP + 0.5)                                    // reference increment per scheduler tick in [ADC ticks, Q16]
+
+/*!Pre-Biased Startup
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the soft-start into a pre-charged output
+ * 
+ * Description:
+ * When the output capacitor is still charged at the end of the power-on delay (e.g. restart 
+ * after a fault or a short power interruption), starting the ramp at zero discharges the 
+ * output through the load until the soft-start reference has caught up with it.
+ * When enabled, the power controller starts the ramp at the measured output voltage 
+ * converter.data.v_out (limited to the reference) and pre-charges the compensator histories 
+ * with an estimate of the steady-state compensator output at this voltage:
+ * 
+ *    output = PREBIAS_DAC x v_out / v_ref
+ * 
+ * For a resistive load the transferred power scales with v_out^2, the peak current and with it
+ * the compensator output (power normalized by the input voltage feed-forward) with v_out. The
+ * estimate is clamped to the limits of the compensator. Below PREBIAS_VOLTAGE_MINIMUM the 
+ * regular soft-start from zero with empty histories is used.
+ * 
+ * USE_PREBIAS_STARTUP may be overridden by a compiler option (-DUSE_PREBIAS_STARTUP=false).
+ * 
+ * *************************************************************************************************/
 
-#define POD       (uint16_t)((POWER_ON_DELAY * MAIN_EXECUTION_PERIOD)-1.0)
-#define RPER      (uint16_t)((RAMP_PERIOD * MAIN_EXECUTION_PERIOD)-1.0)
-#define PGD       (uint16_t)((POWER_GOOD_DELAY * MAIN_EXECUTION_PERIOD)-1.0)
-#define REF_STEP  (uint16_t)(V_OUT_REF / (RPER + 1.0))
+#ifndef USE_PREBIAS_STARTUP
+#define USE_PREBIAS_STARTUP     true    // Enable/disable ramp start at the measured output voltage
+#endif
+
+#define PREBIAS_VOLTAGE_MINIMUM 1.0     // output voltage above which the output is treated as pre-biased in [V]
+#define PREBIAS_PEAK_LEVEL      2.000   // steady-state compensator output at nominal output voltage and load in [V]
+
+//------ macros
+#define PREBIAS_VOUT_MIN        (uint16_t)(PREBIAS_VOLTAGE_MINIMUM * VOUT_FB_GAIN / ADC_GRAN)  // pre-bias detection level in [ADC ticks]
+#define PREBIAS_DAC             (uint16_t)(PREBIAS_PEAK_LEVEL / DAC_GRAN)                      // steady-state compensator output in [DAC ticks]
+
+/*!Voltage Loop Control Mode
+ * *************************************************************************************************
+ * Summary:
+ * Global option to enable/disable the closed voltage loop
+ *
+ * Description:
+ * When enabled, the voltage loop interrupt service routine _VOUT_ADCInterrupt executes the
+ * compensator c2p2z_Update(), which reads the output voltage sample directly from the ADC buffer
+ * (REG_VOUT_ADCBUF) and writes the peak current reference directly into the DAC register
+ * (DAC_VREF_REGISTER). Monitoring values in converter.data are updated by the power controller
+ * state machine every scheduler tick.
+ * When disabled, the DAC register is set to the external reference value (open loop operation
+ * with the peak current reference adjusted by the external reference input).
+ *
+ * *************************************************************************************************/
+
+#define USE_CLOSED_LOOP_CONTROL true    // Enable/disable closed voltage loop
+
+/* Alternate working register set option
+ * When enabled, _VOUT_ADCInterrupt is replaced by the assembly routine of vout_isr_asm.s, which 
+ * runs in the alternate working register set assigned to its interrupt priority level
+ * (CTXT2 = IPL5, see config_bits.c) without stack frame and with the compensator executed 
+ * inline up to the DAC update. Requires USE_CLOSED_LOOP_CONTROL. 
+ * The option is disabled until the latency gain estimated in vout_isr_asm.s has been measured
+ * on the device (profiler channels PROF_VOUT_LATENCY and PROF_VOUT_ISR of both variants). */
+#ifndef USE_ALT_WREG_ISR
+#define USE_ALT_WREG_ISR        false   // Enable/disable alternate working register set ISR variant
+#endif
 
 /*!External Reference Voltage Input
  * *************************************************************************************************
@@ -275,7 +368,556 @@ extern "C" {
 #define V_REF_MIN           (uint16_t)(V_REF_MINIMUM * 1.0 / ADC_GRAN)
 #define V_REF_MAX           (uint16_t)(V_REF_MAXIMUM * 1.0 / ADC_GRAN)
 #define V_REF_DIFF          (V_REF_MAX - V_REF_MIN)
+
+/* Reference filter options
+ * The external reference signal is filtered by one of the following filters:
+ * 
+ *    - EXT_REF_FILTER_HARDWARE: blocks of 2^EXT_REF_HW_AVG_LOG2 samples are averaged by the 
+ *                              ADC digital filter VREF_ADC_FILTER; the filter result is published 
+ *                              every scheduler tick by ext_reference_exec() (no CPU load per sample)
+ *    - EXT_REF_FILTER_MOVING_AVERAGE: sliding window of 2^EXT_REF_MA_LENGTH_LOG2 samples using 
+ *                              a ring buffer and running sum; updated every sample
+ *    - EXT_REF_FILTER_IIR:     first-order low-pass y += (x - y) / 2^EXT_REF_IIR_SHIFT; 
+ *                              updated every sample
+ * 
+ * EXT_REF_FILTER may be overridden by a compiler option (-DEXT_REF_FILTER=...). */
+#define EXT_REF_FILTER_HARDWARE         0
+#define EXT_REF_FILTER_MOVING_AVERAGE   1
+#define EXT_REF_FILTER_IIR              2
+
+#ifndef EXT_REF_FILTER
+#define EXT_REF_FILTER          EXT_REF_FILTER_HARDWARE     // Selected reference filter
+#endif
+
+#define EXT_REF_HW_AVG_LOG2     6   // Hardware filter average of 2^6 = 64 samples (1...8)
+#define EXT_REF_MA_LENGTH_LOG2  6   // Moving average window of 2^6 = 64 samples
+#define EXT_REF_IIR_SHIFT       5   // IIR filter coefficient of 1/2^5 = 1/32
+
+/*!Gain Scheduling
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the gain scheduler adapting the 2P2Z coefficients to the operating point
+ * 
+ * Description:
+ * The gain scheduler interpolates the coefficients of the voltage loop compensator c2p2z
+ * from a table of coefficient sets designed at GS_VIN_POINTS input voltage levels and 
+ * GS_LOAD_POINTS load levels (see task_gain_scheduler.c). Input voltage and load levels are 
+ * equally spaced between the limits specified below, where
+ * 
+ *    - GS_VIN_MINIMUM/GS_VIN_MAXIMUM define the input voltage range covered by the table in [V]
+ *    - GS_LOAD_MINIMUM/GS_LOAD_MAXIMUM define the load range covered by the table, given as 
+ *                    compensator output (peak current reference before input voltage 
+ *                    feed-forward) in [V]
+ * 
+ * The scheduler is called by the main loop every MAIN_EXECUTION_PERIOD and recalculates the 
+ * coefficients every GS_EXEC_INTERVAL calls. Operating points outside the specified ranges 
+ * are clamped to the table borders. GS_TABLE_EXTERNAL = true removes the coefficient tables
+ * from task_gain_scheduler.c so they can be provided by another source file.
+ * 
+ * Please note:
+ * All entries of the coefficient table still hold the same design (see task_gain_scheduler.c),
+ * so gain scheduling is disabled until operating point specific designs are available.
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_GAIN_SCHEDULING
+#define USE_GAIN_SCHEDULING     false   // Enable/disable gain scheduling of the voltage loop compensator
+#endif
+
+#ifndef GS_TABLE_EXTERNAL
+#define GS_TABLE_EXTERNAL       false   // Coefficient tables are defined outside task_gain_scheduler.c
+#endif
+
+#define GS_VIN_MINIMUM          9.0     // lowest input voltage of the coefficient table in [V]
+#define GS_VIN_MAXIMUM          18.0    // highest input voltage of the coefficient table in [V]
+#define GS_LOAD_MINIMUM         DAC_MINIMUM // lowest peak current reference of the coefficient table in [V]
+#define GS_LOAD_MAXIMUM         DAC_MAXIMUM // highest peak current reference of the coefficient table in [V]
+
+#define GS_EXEC_INTERVAL        9       // coefficient update interval of (9 + 1) x 100usec = 1ms
+#define GS_FILTER_SHIFT         3       // operating point low-pass filter: y += (x - y) / 2^GS_FILTER_SHIFT
+
+#define GS_VIN_MIN              (uint16_t)(GS_VIN_MINIMUM * VIN_FB_GAIN / ADC_GRAN)
+#define GS_VIN_MAX              (uint16_t)(GS_VIN_MAXIMUM * VIN_FB_GAIN / ADC_GRAN)
+#define GS_LOAD_MIN             (uint16_t)(GS_LOAD_MINIMUM / DAC_GRAN)
+#define GS_LOAD_MAX             (uint16_t)(GS_LOAD_MAXIMUM / DAC_GRAN)
     
+/*!Transient Boost
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the non-linear transient boost of the voltage loop compensator
+ * 
+ * Description:
+ * The linear compensator is designed for stability and low noise sensitivity around the 
+ * operating point. Large load steps move the output voltage far away from the reference, 
+ * where the compensator output rises only slowly. When enabled, the compensator adds an 
+ * output step proportional to the part of the error beyond an error band (see NPNZ16B_BOOST
+ * in npnz16b.inc):
+ * 
+ *    u = u + TRANSIENT_BOOST_GAIN x (|e| - TRANSIENT_BOOST_BAND) x sign(e)
+ * 
+ * where 
+ * 
+ *    - TRANSIENT_BOOST_BAND defines the output voltage deviation in [V] within which the 
+ *                    compensator is purely linear
+ *    - TRANSIENT_BOOST_GAIN defines the step of the peak current reference per sample 
+ *                    in [DAC ticks] per ADC tick beyond the band
+ * 
+ * The step is added before the output clamping and stored in the control history, so the 
+ * linear compensator continues from the boosted output when the error has returned into the 
+ * band. Within the band the compensator is unchanged, and small-signal loop gain and ripple 
+ * are not affected. TRANSIENT_BOOST_GAIN must be smaller than 2^c2p2z_pre_scaler.
+ * 
+ * USE_TRANSIENT_BOOST may be overridden by a compiler option (-DUSE_TRANSIENT_BOOST=false).
+ * The boost code of the compensator is selected by the assembler symbol of the same name (see
+ * npnz16b.inc, --defsym USE_TRANSIENT_BOOST=0), which has to match this option.
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_TRANSIENT_BOOST
+#define USE_TRANSIENT_BOOST     true    // Enable/disable non-linear transient boost of the voltage loop
+#endif
+
+#define TRANSIENT_BOOST_BAND    0.030   // output voltage deviation beyond which the boost applies in [V]
+#define TRANSIENT_BOOST_GAIN    4.0    // peak current reference step per ADC tick beyond the band in [DAC ticks]
+
+//------ macros
+#define BOOST_BAND              (int16_t)(TRANSIENT_BOOST_BAND * VOUT_FB_GAIN / ADC_GRAN) // error band in [ADC ticks]
+#define BOOST_GAIN              (uint32_t)(TRANSIENT_BOOST_GAIN * 32768.0) // boost gain in Q15 before input normalization
+
+/*!Soft Anti-Windup
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the soft desaturation (back-calculation) of the voltage loop compensator
+ * 
+ * Description:
+ * When the compensator output u exceeds MinOutput or MaxOutput, the output is clamped and the
+ * limit is written into the control history. The error history, however, still contains the
+ * error which caused the cut-off output. When enabled, the most recent error history entry is 
+ * back-calculated towards the error which would have resulted in the clamped output (see 
+ * NPNZ16B_BACK_CALCULATE in npnz16b.inc):
+ * 
+ *    e(n) = e(n) + SOFT_DESATURATION_GAIN x (limit - u) / (B0 x PostScaler x 2^-PostShiftA)
+ * 
+ * where SOFT_DESATURATION_GAIN selects the strength of the back-calculation:
+ * 
+ *    - 0.0 results in hard clamping (error history unchanged)
+ *    - 1.0 removes the complete output excess, the histories match the clamped output
+ * 
+ * The correction gain is derived from the default coefficients of c2p2z.c by init_pwr_control().
+ * This option corresponds to the option AntiWindupSoftDesaturation of the z-domain control 
+ * loop designer (ctrl_loop.dcld).
+ * 
+ * Please note:
+ * In the closed-loop simulation (host/readme.txt, scenarios sat_recovery and standby) no gain 
+ * up to 1.0 improves saturation recovery or standby input power measurably over hard clamping.
+ * A gain of 1.0 slows down the saturation recovery. The option is therefore disabled.
+ * 
+ * USE_SOFT_DESATURATION and SOFT_DESATURATION_GAIN may be overridden by compiler options
+ * (e.g. -DUSE_SOFT_DESATURATION=true). The back-calculation code of the compensator is selected
+ * by the assembler symbol of the same name (see npnz16b.inc, --defsym USE_SOFT_DESATURATION=1),
+ * which has to match this option.
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_SOFT_DESATURATION
+#define USE_SOFT_DESATURATION   false   // Enable/disable soft desaturation of the voltage loop compensator
+#endif
+
+#ifndef SOFT_DESATURATION_GAIN
+#define SOFT_DESATURATION_GAIN  0.5     // share of the output excess removed from the error history (0.0 ... 1.0)
+#endif
+
+//------ macros
+#define SOFT_DESAT_GAIN         (fractional)(SOFT_DESATURATION_GAIN * 32767.0) // back-calculation gain in Q15
+
+/*!Valley Switching
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the valley switching control of the quasi-resonant operation
+ * 
+ * Description:
+ * After the transformer has been demagnetized, the drain voltage rings around the input voltage
+ * with the resonance period of magnetizing inductance and drain capacitance (FLYBACK_LP, 
+ * FLYBACK_COSS). The valley control (see task_valley_control.c) sets the switching period so 
+ * that the next cycle starts in a valley of this ringing. As the board offers no drain voltage 
+ * or auxiliary winding sense input, the valley timing is predicted from peak current reference,
+ * input voltage and output voltage using the power stage parameters of the hardware abstraction
+ * section. The turn-on valley is selected as the first valley at or after the minimum period 
+ * permitted at the present load:
+ * 
+ *    - VALLEY_FREQUENCY_MAX: highest switching frequency (= SWITCHING_FREQUENCY), applied 
+ *                    above VALLEY_POWER_HIGH
+ *    - VALLEY_FREQUENCY_FOLDBACK: switching frequency limit applied below VALLEY_POWER_LOW; 
+ *                    between both load levels the period limit is interpolated linearly
+ *    - VALLEY_FREQUENCY_MIN: lowest switching frequency, the period is clamped to this value
+ * 
+ * The load is estimated as power transferred per cycle (1/2 x Lp x Ipk^2 x fsw), which does not 
+ * change when the converter moves between valleys. A lower valley is only selected when its 
+ * period has exceeded the limit by VALLEY_HYSTERESIS for VALLEY_DWELL_TIME, preventing the 
+ * converter from toggling between two valleys while the voltage loop settles after a change. 
+ * VALLEY_DELAY_COMPENSATION advances the turn-on by the propagation delay of comparator, PWM 
+ * and gate driver.
+ * 
+ * The valley control is active in normal operation (soft-start complete). During startup, and
+ * when disabled, the converter runs at the fixed frequency SWITCHING_FREQUENCY.
+ * 
+ * *************************************************************************************************/
+
+#define USE_VALLEY_SWITCHING        true    // Enable/disable valley switching control
+
+#define VALLEY_FREQUENCY_MAX        SWITCHING_FREQUENCY // highest switching frequency in [Hz]
+#define VALLEY_FREQUENCY_FOLDBACK   150e+3  // switching frequency limit at light load in [Hz]
+#define VALLEY_FREQUENCY_MIN        100e+3  // lowest switching frequency in [Hz]
+#define VALLEY_POWER_HIGH           4.0     // load above which VALLEY_FREQUENCY_MAX applies in [W]
+#define VALLEY_POWER_LOW            1.0     // load below which VALLEY_FREQUENCY_FOLDBACK applies in [W]
+#define VALLEY_HYSTERESIS           100e-9  // period margin required to move to a lower valley in [sec]
+#define VALLEY_DWELL_TIME           1e-3    // time the margin has to persist before moving to a lower valley in [sec]
+#define VALLEY_DELAY_COMPENSATION   0e-9    // turn-on propagation delay compensation in [sec]
+#define VALLEY_VIN_MINIMUM          6.0     // input voltage below which the valley control is inactive in [V]
+#define VALLEY_VOUT_MINIMUM         (0.5 * VOUT_NOMINAL) // output voltage below which the valley control is inactive in [V]
+#define VALLEY_FILTER_SHIFT         3       // load low-pass filter: y += (x - y) / 2^VALLEY_FILTER_SHIFT
+
+//------ macros
+#define VALLEY_PERIOD_MIN       (uint16_t)((1.0 / VALLEY_FREQUENCY_MAX) / PWM_RES)      // shortest period in [PWM ticks]
+#define VALLEY_PERIOD_FOLDBACK  (uint16_t)((1.0 / VALLEY_FREQUENCY_FOLDBACK) / PWM_RES) // period limit at light load in [PWM ticks]
+#define VALLEY_PERIOD_MAX       (uint16_t)((1.0 / VALLEY_FREQUENCY_MIN) / PWM_RES)      // longest period in [PWM ticks]
+#define VALLEY_HYST             (uint16_t)(VALLEY_HYSTERESIS / PWM_RES)                 // hysteresis in [PWM ticks]
+#define VALLEY_DWELL            (uint16_t)(VALLEY_DWELL_TIME / MAIN_EXECUTION_PERIOD)   // dwell time in [scheduler ticks]
+#define VALLEY_DELAY            (uint16_t)(VALLEY_DELAY_COMPENSATION / PWM_RES)         // delay compensation in [PWM ticks]
+#define VALLEY_VIN_MIN          (uint16_t)(VALLEY_VIN_MINIMUM * VIN_FB_GAIN / ADC_GRAN)
+#define VALLEY_VOUT_MIN         (uint16_t)(VALLEY_VOUT_MINIMUM * VOUT_FB_GAIN / ADC_GRAN)
+
+// Ringing period of Lp and Coss in [PWM ticks << 4]
+#define VALLEY_T_RING           (uint16_t)(16.0 * 2.0 * M_PI * sqrt(FLYBACK_LP * FLYBACK_COSS) / PWM_RES)
+// On-time per peak current reference and input voltage: t_on = dac * VALLEY_K_TON / vin in [PWM ticks << 4]
+#define VALLEY_K_TON            (uint16_t)(16.0 * DAC_GRAN * FLYBACK_LP * VIN_FB_GAIN / (CS_GAIN * ADC_GRAN * PWM_RES))
+// Demagnetization time per peak current reference and output voltage: t_demag = dac * VALLEY_K_TDEMAG / (vout + VALLEY_VF) in [PWM ticks << 4]
+#define VALLEY_K_TDEMAG         (uint16_t)(16.0 * DAC_GRAN * FLYBACK_LP * VOUT_FB_GAIN / (CS_GAIN * FLYBACK_TURNS_RATIO * ADC_GRAN * PWM_RES))
+#define VALLEY_VF               (uint16_t)(FLYBACK_VF * VOUT_FB_GAIN / ADC_GRAN)        // rectifier forward voltage in [ADC ticks]
+// Slope compensation ramp per slope register value (SLPxDAT) in [DAC ticks per PWM tick << 8]
+#define VALLEY_SLOPE_GAIN       (uint16_t)(256.0 * PWM_RES / (16.0 * DACCLK))
+// Transferred power per cycle: P = dac^2 / period in [DAC ticks^2 / PWM tick]
+#define VALLEY_POWER(p)         (uint16_t)((p) * 2.0 * CS_GAIN * CS_GAIN * PWM_RES / (FLYBACK_LP * DAC_GRAN * DAC_GRAN))
+#define VALLEY_PWR_HIGH         VALLEY_POWER(VALLEY_POWER_HIGH)
+#define VALLEY_PWR_LOW          VALLEY_POWER(VALLEY_POWER_LOW)
+
+/*!Burst Mode
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the light-load burst mode of the power controller
+ * 
+ * Description:
+ * At very light load the compensator output settles at its lower clamping limit (MinOutput,
+ * LSAT flag of the controller status) and each switching cycle delivers more energy than the 
+ * load takes. When the LSAT flag has been set for BURST_ENTRY_DELAY_TIME in normal operation, 
+ * the power controller freezes the compensator and gates PG1 on and off in packets:
+ * 
+ *    - a packet starts when the output voltage drops BURST_RIPPLE_LOW below the reference
+ *    - a packet stops when the output voltage rises BURST_RIPPLE_HIGH above the reference
+ *    - during packets the peak current reference is fixed at BURST_PEAK_LEVEL
+ * 
+ * Continuous operation is resumed when the output voltage drops BURST_EXIT_DROP below the 
+ * reference or when a single packet lasts longer than BURST_PACKET_MAXIMUM. The compensator
+ * histories are then pre-charged with the burst peak current reference. 
+ * 
+ * Output voltage thresholds are evaluated every scheduler tick on the averaged output voltage
+ * (converter.data.v_out), the effective ripple therefore exceeds the thresholds by the output
+ * voltage change within one tick. PWM override changes take effect at the next start of cycle.
+ * 
+ * USE_BURST_MODE may be overridden by a compiler option (-DUSE_BURST_MODE=false).
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_BURST_MODE
+#define USE_BURST_MODE          true    // Enable/disable light-load burst mode
+#endif
+
+#define BURST_ENTRY_DELAY_TIME  2e-3    // time the compensator output has to be clamped before burst mode is entered in [sec]
+#define BURST_RIPPLE_HIGH       0.100   // output voltage above reference ending a packet in [V]
+#define BURST_RIPPLE_LOW        0.100   // output voltage below reference starting a packet in [V]
+#define BURST_EXIT_DROP         0.400   // output voltage below reference resuming continuous operation in [V]
+#define BURST_PACKET_MAXIMUM    1e-3    // packet duration resuming continuous operation in [sec]
+#define BURST_PEAK_LEVEL        1.000   // peak current reference (comparator DAC) during packets in [V]
+
+//------ macros
+#define BURST_ENTRY_DELAY       (uint16_t)(BURST_ENTRY_DELAY_TIME / MAIN_EXECUTION_PERIOD)  // entry delay in [scheduler ticks]
+#define BURST_PACKET_MAX        (uint16_t)(BURST_PACKET_MAXIMUM / MAIN_EXECUTION_PERIOD)    // maximum packet duration in [scheduler ticks]
+#define BURST_VOUT_HIGH         (uint16_t)(BURST_RIPPLE_HIGH * VOUT_FB_GAIN / ADC_GRAN)     // upper ripple limit in [ADC ticks]
+#define BURST_VOUT_LOW          (uint16_t)(BURST_RIPPLE_LOW * VOUT_FB_GAIN / ADC_GRAN)      // lower ripple limit in [ADC ticks]
+#define BURST_VOUT_EXIT         (uint16_t)(BURST_EXIT_DROP * VOUT_FB_GAIN / ADC_GRAN)       // exit threshold in [ADC ticks]
+#define BURST_DAC               (uint16_t)(BURST_PEAK_LEVEL / DAC_GRAN)                     // packet peak current reference in [DAC ticks]
+
+/*!Adaptive Slope Compensation
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the adaptive slope compensation of the peak current mode control
+ * 
+ * Description:
+ * When enabled, the slope compensation rate (SLP1DAT) is computed every scheduler tick from the
+ * measured input and output voltage, the current sense gain CS_GAIN and the power stage 
+ * parameters of the hardware abstraction section (see task_slope_control.h):
+ * 
+ *    Se = SLOPE_MARGIN x (m2 - m1) / 2
+ * 
+ * This ramp is required in continuous conduction mode only. It is applied in full when the 
+ * predicted conduction time (on-time plus demagnetization time) reaches the switching period
+ * and blended out down to SLOPE_CCM_RATIO of the period, below which the minimum ramp is used.
+ * 
+ *    - SLOPE_MARGIN: ratio of applied to minimum required compensation ramp (> 1.0)
+ *    - SLOPE_CCM_RATIO: conduction time relative to the switching period below which 
+ *                    the converter is considered to operate in discontinuous conduction mode
+ *    - SLOPE_RATE_MINIMUM/SLOPE_RATE_MAXIMUM: limits of the compensation ramp in [V/usec]
+ *    - SLOPE_HYSTERESIS: minimum change of the compensation ramp written to SLP1DAT in [V/usec]
+ * 
+ * When disabled, SLP1DAT is left at the value of init_acmp() and may be changed by SW1.
+ * USE_ADAPTIVE_SLOPE may be overridden by a compiler option (-DUSE_ADAPTIVE_SLOPE=false).
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_ADAPTIVE_SLOPE
+#define USE_ADAPTIVE_SLOPE      true    // Enable/disable adaptive slope compensation
+#endif
+
+#define SLOPE_MARGIN            1.5     // applied compensation ramp relative to the minimum required ramp
+#define SLOPE_RATE_MINIMUM      SLEW_RATE // lowest compensation ramp in [V/usec]
+#define SLOPE_RATE_MAXIMUM      1.500   // highest compensation ramp in [V/usec]
+#define SLOPE_HYSTERESIS        0.025   // minimum change of the compensation ramp in [V/usec]
+#define SLOPE_CCM_RATIO         0.95    // conduction time ratio below which the minimum ramp is applied
+
+//------ macros
+#define SLOPE_RATE(s)           (uint16_t)((16.0 * ((s) / DAC_GRAN) / (1.0e-6/DACCLK)) + 1.0) // ramp in [V/usec] to [SLPxDAT ticks]
+#define SLOPE_RATE_MIN          SLOPE_RATE(SLOPE_RATE_MINIMUM)
+#define SLOPE_RATE_MAX          SLOPE_RATE(SLOPE_RATE_MAXIMUM)
+#define SLOPE_HYST              (uint16_t)(16.0 * (SLOPE_HYSTERESIS / DAC_GRAN) / (1.0e-6/DACCLK))
+#define SLOPE_CCM_LIMIT         (uint16_t)(256.0 * SLOPE_CCM_RATIO)                    // conduction time ratio in [1/256]
+#define SLOPE_VF                (uint16_t)(FLYBACK_VF * VOUT_FB_GAIN / ADC_GRAN)       // rectifier forward voltage in [ADC ticks]
+// Half current slope per ADC tick including SLOPE_MARGIN in [SLPxDAT ticks << 16]
+#define SLOPE_K_VOUT            (uint16_t)(65536.0 * 0.5 * SLOPE_MARGIN * 16.0 * DACCLK * CS_GAIN * FLYBACK_TURNS_RATIO * ADC_GRAN / (DAC_GRAN * VOUT_FB_GAIN * FLYBACK_LP))
+#define SLOPE_K_VIN             (uint16_t)(65536.0 * 0.5 * SLOPE_MARGIN * 16.0 * DACCLK * CS_GAIN * ADC_GRAN / (DAC_GRAN * VIN_FB_GAIN * FLYBACK_LP))
+
+/*!Input Voltage Feed-Forward
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the input voltage feed-forward of the peak current reference
+ * 
+ * Description:
+ * In quasi-resonant operation every cycle starts at zero current and transfers the energy
+ * 1/2 x Lp x Ipk^2. The input voltage does not enter the transferred power directly, but 
+ * through the on-time t_on = Ipk x Lp / Vin:
+ * 
+ *    - the switching period set by the valley control contains t_on and follows the input 
+ *      voltage (P = 1/2 x Lp x Ipk^2 / period)
+ *    - the compensation ramp reduces the peak current at the end of t_on by Se x t_on
+ * 
+ * When enabled, the compensator output is no longer written to DAC_VREF_REGISTER directly 
+ * but multiplied by a feed-forward gain computed every scheduler tick from the measured input
+ * voltage, the switching period (MPER) and the compensation ramp (SLP1DAT):
+ * 
+ *    gain = sqrt(period / LINE_FF_PERIOD_REF) x (1 + Se x Lp / (CS_GAIN x Vin))
+ * 
+ * The compensator output thereby represents the transferred power independent of input 
+ * voltage and valley, and a line step is compensated before the voltage loop has to react. 
+ * The clamping limits of the compensator are scaled by the inverse gain, keeping the DAC 
+ * within DAC_MIN and DAC_MAX (see task_line_feedforward.h). Below LINE_FF_VIN_MINIMUM the 
+ * gain is held at unity.
+ * 
+ * USE_LINE_FEEDFORWARD may be overridden by a compiler option (-DUSE_LINE_FEEDFORWARD=false).
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_LINE_FEEDFORWARD
+#define USE_LINE_FEEDFORWARD    true    // Enable/disable input voltage feed-forward
+#endif
+
+#define LINE_FF_VIN_MINIMUM     6.0     // input voltage below which the feed-forward gain is unity in [V]
+
+//------ macros
+#define LINE_FF_GAIN_UNITY      4096    // feed-forward gain of 1.0 (Q12)
+#define LINE_FF_PERIOD_REF      PWM_PERIOD  // switching period of unity gain in [PWM ticks]
+#define LINE_FF_VIN_MIN         (uint16_t)(LINE_FF_VIN_MINIMUM * VIN_FB_GAIN / ADC_GRAN)
+// Peak current reduction by the ramp per slope register value and ADC tick: Se x Lp / (CS_GAIN x Vin) = SLP1DAT x LINE_FF_K_SLOPE / vin in [Q12]
+#define LINE_FF_K_SLOPE         (uint16_t)(4096.0 * DAC_GRAN * FLYBACK_LP * VIN_FB_GAIN / (16.0 * DACCLK * CS_GAIN * ADC_GRAN))
+
+/*!Fault Engine
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the hardware fault shutdown and restart of the power controller
+ *
+ * Description:
+ * When enabled, the ADC digital comparators monitor every conversion of the input voltage
+ * (under- and over-voltage lockout) and of the output voltage (over- and under-voltage
+ * protection). A comparator event calls a high priority interrupt, which latches the software
+ * input of the fault PCI of the PWM generator. The PWM output is turned off (FLTDAT) within the
+ * switching cycle following the out-of-range sample, independent of the scheduler tick.
+ *
+ * The power controller state machine takes the converter down into SS_FAULT at the next
+ * scheduler tick. After the restart back-off has expired and the input voltage has returned
+ * into the window of the release levels, the fault PCI is terminated and the converter
+ * restarts from SS_STANDBY. The back-off starts at FAULT_RESTART_DELAY and is doubled with
+ * every consecutive restart up to FAULT_RESTART_DELAY_MAX. It is reset once the converter has
+ * operated in SS_COMPLETE for FAULT_RESTART_RESET_TIME (see fault_handler.h).
+ *
+ *    - FAULT_VIN_UVLO/FAULT_VIN_OVLO: input voltage trip levels in [V]
+ *    - FAULT_VIN_UVLO_RELEASE/FAULT_VIN_OVLO_RELEASE: input voltage window for restart in [V]
+ *    - FAULT_VOUT_OVP: output voltage trip level in [V]
+ *    - FAULT_VOUT_UVP_RATIO: output voltage trip level relative to the reference, active in
+ *                    SS_COMPLETE only
+ *
+ * USE_FAULT_ENGINE may be overridden by a compiler option (-DUSE_FAULT_ENGINE=false).
+ *
+ * *************************************************************************************************/
+
+#ifndef USE_FAULT_ENGINE
+#define USE_FAULT_ENGINE        true    // Enable/disable hardware fault shutdown and restart
+#endif
+
+#define FAULT_VIN_UVLO              8.5     // input under-voltage lockout level in [V]
+#define FAULT_VIN_UVLO_RELEASE      8.8     // input voltage above which a restart is permitted in [V]
+#define FAULT_VIN_OVLO              19.5    // input over-voltage lockout level in [V]
+#define FAULT_VIN_OVLO_RELEASE      19.0    // input voltage below which a restart is permitted in [V]
+#define FAULT_VOUT_OVP              20.0    // output over-voltage protection level in [V]
+#define FAULT_VOUT_UVP_RATIO        0.50    // output under-voltage protection level relative to the reference
+#define FAULT_RESTART_DELAY         10e-3   // restart back-off after the first fault in [sec]
+#define FAULT_RESTART_DELAY_MAX     160e-3  // restart back-off limit of consecutive faults in [sec]
+#define FAULT_RESTART_RESET_TIME    200e-3  // normal operation resetting the restart back-off in [sec]
+#define FAULT_ISR_PRIORITY          6       // interrupt priority of the comparator fault interrupts (above the voltage loop)
+
+//------ macros
+#define FAULT_VIN_UV            (uint16_t)(FAULT_VIN_UVLO * VIN_FB_GAIN / ADC_GRAN)         // ADC comparator low threshold in [ADC ticks]
+#define FAULT_VIN_UV_RELEASE    (uint16_t)(FAULT_VIN_UVLO_RELEASE * VIN_FB_GAIN / ADC_GRAN) // release level in [ADC ticks]
+#define FAULT_VIN_OV            (uint16_t)(FAULT_VIN_OVLO * VIN_FB_GAIN / ADC_GRAN)         // ADC comparator high threshold in [ADC ticks]
+#define FAULT_VIN_OV_RELEASE    (uint16_t)(FAULT_VIN_OVLO_RELEASE * VIN_FB_GAIN / ADC_GRAN) // release level in [ADC ticks]
+#define FAULT_VOUT_OV           (uint16_t)(FAULT_VOUT_OVP * VOUT_FB_GAIN / ADC_GRAN)        // ADC comparator high threshold in [ADC ticks]
+#define FAULT_VOUT_UV_GAIN      (uint16_t)(FAULT_VOUT_UVP_RATIO * 65536.0)                  // low threshold per reference tick in [1/65536]
+#define FAULT_RESTART_MIN       (uint16_t)(FAULT_RESTART_DELAY / MAIN_EXECUTION_PERIOD)     // back-off in [scheduler ticks]
+#define FAULT_RESTART_MAX       (uint16_t)(FAULT_RESTART_DELAY_MAX / MAIN_EXECUTION_PERIOD) // back-off limit in [scheduler ticks]
+#define FAULT_RESTART_RESET     (uint16_t)(FAULT_RESTART_RESET_TIME / MAIN_EXECUTION_PERIOD) // back-off reset in [scheduler ticks]
+
+/*!ADC Digital Filters
+ * *************************************************************************************************
+ * Summary:
+ * Global option to enable/disable the averaging filters of the ADC module
+ * 
+ * Description:
+ * When enabled, the input voltage (AN12), the output voltage (AN16) and the external reference 
+ * (AN6) are averaged by the ADC digital filters assigned in the signal mapping section below.
+ * The filters run in the ADC module without any CPU involvement. Their results (ADFLxDAT) are 
+ * read by the tasks instead of the raw ADC buffers:
+ * 
+ *    - converter.data.v_in:  average of 2^VIN_ADC_FILTER_AVG_LOG2 samples (unless the input 
+ *                            voltage is averaged by the monitoring task)
+ *    - converter.data.v_out: average of 2^VOUT_ADC_FILTER_AVG_LOG2 samples
+ *    - converter.data.v_ref: average of 2^EXT_REF_HW_AVG_LOG2 samples (EXT_REF_FILTER_HARDWARE)
+ * 
+ * The voltage loop always reads the most recent raw sample of AN16.
+ * When disabled, the monitoring values are copied from the raw ADC buffers.
+ * 
+ * *************************************************************************************************/
+
+#define USE_ADC_HW_FILTERS      true    // Enable/disable ADC digital filters of the monitoring values
+#define VIN_ADC_FILTER_AVG_LOG2     4   // Input voltage average of 2^4 = 16 samples (1...8)
+#define VOUT_ADC_FILTER_AVG_LOG2    4   // Output voltage average of 2^4 = 16 samples (1...8)
+
+/*!Monitoring Sample Capture
+ * *************************************************************************************************
+ * Summary:
+ * Global option to enable/disable the DMA capture of the monitoring ADC channels
+ * 
+ * Description:
+ * When enabled, the conversions of the input voltage (AN12) and the external reference (AN6) are
+ * transferred by DMA into RAM ring buffers and processed in blocks by the monitoring task every 
+ * scheduler tick (see task_monitor.h). The AN6 interrupt is disabled, leaving the voltage loop 
+ * as the only interrupt executed every switching cycle.
+ * When disabled, the external reference is filtered by the AN6 interrupt service routine and
+ * the input voltage is read by the power controller state machine.
+ * 
+ * The ring length needs to hold more than the number of conversions per scheduler tick 
+ * (SWITCHING_FREQUENCY * MAIN_EXECUTION_PERIOD = 40) plus the maximum scheduling latency.
+ * A DMA channel without samples for more than MON_STALL_TICKS scheduler ticks is flagged and
+ * its ADC buffer is read directly.
+ * 
+ * *************************************************************************************************/
+
+#define USE_DMA_MONITORING      true    // Enable/disable DMA capture of the monitoring channels
+#define MON_RING_LENGTH_LOG2    7       // Ring buffer of 2^7 = 128 samples (320 usec) per channel
+#define MON_STALL_TICKS         10      // DMA channel flagged after 10 task calls (1 ms) without samples
+
+/*!Execution Time Profiler
+ * *************************************************************************************************
+ * Summary:
+ * Global option to enable/disable the execution time profiler
+ * 
+ * Description:
+ * When enabled, the execution times of the interrupt service routines and the power controller 
+ * state machine are measured in instruction cycles and recorded in the data object 'profiler'
+ * (see profiler.h). The profiler occupies SCCP1 as time base.
+ * 
+ * *************************************************************************************************/
+
+#define USE_PROFILER            true    // Enable/disable execution time profiler
+
+/*!Data Recorder
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the triggered data recorder of the voltage loop
+ * 
+ * Description:
+ * When enabled, the voltage loop interrupt service routine captures output voltage sample, 
+ * control reference, compensator output, DAC value and switching period of every switching 
+ * cycle into the circular buffer of the data object 'data_recorder' (see data_recorder.h). 
+ * The recording stops DATA_RECORDER_DEPTH - DATA_RECORDER_PRETRIGGER samples after the first
+ * enabled trigger event (fault shutdown, compensator saturation, state change of the power 
+ * controller, output voltage threshold crossing), keeping DATA_RECORDER_PRETRIGGER samples 
+ * before the trigger. The recorder is armed at startup with the trigger sources 
+ * DATA_RECORDER_TRIGGER and can be re-armed by the debugger at runtime. A RAM image of the 
+ * data object is decoded by the host tool decode_recorder (see host/readme.txt).
+ * 
+ * USE_DATA_RECORDER may be overridden by a compiler option (-DUSE_DATA_RECORDER=false).
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_DATA_RECORDER
+#define USE_DATA_RECORDER       true    // Enable/disable triggered data recorder
+#endif
+
+#define DATA_RECORDER_DEPTH     256     // number of samples (switching cycles) of the buffer (power of 2)
+#define DATA_RECORDER_PRETRIGGER 64     // number of samples recorded before the trigger event
+#define DATA_RECORDER_TRIGGER   REC_TRIG_FAULT  // trigger sources armed at startup (DATA_RECORDER_TRIGGER_e)
+#define DATA_RECORDER_LEVEL     16.5    // output voltage threshold of the level triggers in [V]
+
+//------ macros
+#define DATA_RECORDER_MASK      (DATA_RECORDER_DEPTH - 1)
+#define DATA_RECORDER_POSTTRIGGER (DATA_RECORDER_DEPTH - DATA_RECORDER_PRETRIGGER)
+#define DATA_RECORDER_VOUT_LEVEL (uint16_t)(DATA_RECORDER_LEVEL * VOUT_FB_GAIN / ADC_GRAN) // level trigger threshold in [ADC ticks]
+
+/*!Event Log
+ * *************************************************************************************************
+ * Summary:
+ * Global options of the event log of the power controller
+ * 
+ * Description:
+ * When enabled, soft-start phase transitions, converter status changes, fault shutdowns and
+ * their causes, undefined controller states, compensator saturation episodes and restart 
+ * attempts are recorded with a time stamp of the scheduler time base into the ring buffer of 
+ * the data object 'event_log' (see event_log.h). The log keeps the last EVENT_LOG_DEPTH events
+ * and can be read by the debugger while the converter is running. A saturation episode ends 
+ * after EVENT_LOG_SAT_RELEASE switching cycles without saturation, so a compensator alternating
+ * between saturated and unsaturated cycles in overload does not flood the log.
+ * 
+ * USE_EVENT_LOG may be overridden by a compiler option (-DUSE_EVENT_LOG=false).
+ * 
+ * *************************************************************************************************/
+
+#ifndef USE_EVENT_LOG
+#define USE_EVENT_LOG           true    // Enable/disable event log of the power controller
+#endif
+
+#define EVENT_LOG_DEPTH         32      // number of events kept in the ring buffer (power of 2)
+#define EVENT_LOG_SAT_RELEASE   64      // number of switching cycles without saturation ending a saturation episode
+
+//------ macros
+#define EVENT_LOG_MASK          (EVENT_LOG_DEPTH - 1)
+
 /*!Microcontroller Signal Mapping
  * *************************************************************************************************
  * Summary:
@@ -292,15 +934,30 @@ extern "C" {
  *     - ADC input number
  *     - Comparator/DAC Instance
  *     - Comparator Input Selection
+ *     - ADC digital filter and digital comparator instances (see init_adc.h)
  *  
  * *************************************************************************************************/
 
 #define _VOUT_ADCInterrupt        _ADCAN16Interrupt
 #define REG_VIN_ADCBUF            ADCBUF12
+#define REG_VREF_ADCBUF           ADCBUF6
 #define REG_VOUT_ADCBUF           ADCBUF16
 #define REG_VOUT_ADCTRIG          PG2TRIGA
 #define VOUT_FEEDBACK_OFFSET      0
 #define DAC_VREF_REGISTER         DAC1DATH
+#define PROFILER_TIMER            CCP1TMRL
+
+#define VIN_ADC_FILTER            0     // ADC digital filter ADFL0 averaging AN12
+#define VOUT_ADC_FILTER           1     // ADC digital filter ADFL1 averaging AN16
+#define VREF_ADC_FILTER           2     // ADC digital filter ADFL2 averaging AN6
+#define VIN_ADC_COMPARATOR        0     // ADC digital comparator ADCMP0 monitoring AN12
+#define VOUT_ADC_COMPARATOR       1     // ADC digital comparator ADCMP1 monitoring AN16
+#define VREF_ADC_COMPARATOR       2     // ADC digital comparator ADCMP2 monitoring AN6
+#define _VIN_FAULTInterrupt       ADC_COMPARATOR_INTERRUPT(VIN_ADC_COMPARATOR)   // Input voltage fault interrupt
+#define _VOUT_FAULTInterrupt      ADC_COMPARATOR_INTERRUPT(VOUT_ADC_COMPARATOR)  // Output voltage fault interrupt
+#define REG_VIN_ADFLDAT           ADC_FILTER_DAT(VIN_ADC_FILTER)
+#define REG_VREF_ADFLDAT          ADC_FILTER_DAT(VREF_ADC_FILTER)
+#define REG_VOUT_ADFLDAT          ADC_FILTER_DAT(VOUT_ADC_FILTER)
 
 /*!POWER_CONTROLLER_t data structure 
  * *************************************************************************************************
@@ -41,6 +41,47 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*!ADC Digital Filter and Comparator Instances
+ * *************************************************************************************************
+ * The ADC digital filters (ADFLx) and digital comparators (ADCMPx) are assigned to the analog 
+ * inputs by the instance numbers VIN_ADC_FILTER, VOUT_ADC_FILTER, etc. in the signal mapping 
+ * section of globals.h. The macros below resolve an instance number into its registers, e.g. 
+ * ADC_FILTER_CON(2) = ADFL2CONbits and ADC_FILTER_DAT(2) = ADFL2DAT.
+ * 
+ * In averaging mode (ADFLxCON.MODE = 0b11) the filter accumulates 2^n conversions of its input 
+ * channel (n = 1...8) and publishes the 12-bit average in ADFLxDAT. ADC_FILTER_AVG_RATIO(n) 
+ * returns the ADFLxCON.OVRSAM setting of 2^n samples.
+ * 
+ * Each digital comparator has an individual interrupt vector, e.g. ADC_COMPARATOR_INTERRUPT(1)
+ * = _ADCMP1Interrupt with the control bits ADC_COMPARATOR_IF/IE/IP(1) = _ADCMP1IF/IE/IP.
+ * *************************************************************************************************/
+
+#define ADC_FILTER_CON_(x)          ADFL##x##CONbits
+#define ADC_FILTER_DAT_(x)          ADFL##x##DAT
+#define ADC_COMPARATOR_CON_(x)      ADCMP##x##CONbits
+#define ADC_COMPARATOR_ENL_(x)      ADCMP##x##ENLbits
+#define ADC_COMPARATOR_ENH_(x)      ADCMP##x##ENHbits
+#define ADC_COMPARATOR_LO_(x)       ADCMP##x##LO
+#define ADC_COMPARATOR_HI_(x)       ADCMP##x##HI
+#define ADC_COMPARATOR_INTERRUPT_(x) _ADCMP##x##Interrupt
+#define ADC_COMPARATOR_IF_(x)       _ADCMP##x##IF
+#define ADC_COMPARATOR_IE_(x)       _ADCMP##x##IE
+#define ADC_COMPARATOR_IP_(x)       _ADCMP##x##IP
+
+#define ADC_FILTER_CON(x)           ADC_FILTER_CON_(x)      // ADFLxCON bits of filter instance x
+#define ADC_FILTER_DAT(x)           ADC_FILTER_DAT_(x)      // ADFLxDAT result register of filter instance x
+#define ADC_COMPARATOR_CON(x)       ADC_COMPARATOR_CON_(x)  // ADCMPxCON bits of comparator instance x
+#define ADC_COMPARATOR_ENL(x)       ADC_COMPARATOR_ENL_(x)  // ADCMPxENL bits of comparator instance x (AN0...AN15)
+#define ADC_COMPARATOR_ENH(x)       ADC_COMPARATOR_ENH_(x)  // ADCMPxENH bits of comparator instance x (AN16...AN31)
+#define ADC_COMPARATOR_LO(x)        ADC_COMPARATOR_LO_(x)   // ADCMPxLO lower threshold of comparator instance x
+#define ADC_COMPARATOR_HI(x)        ADC_COMPARATOR_HI_(x)   // ADCMPxHI upper threshold of comparator instance x
+#define ADC_COMPARATOR_INTERRUPT(x) ADC_COMPARATOR_INTERRUPT_(x) // interrupt service routine of comparator instance x
+#define ADC_COMPARATOR_IF(x)        ADC_COMPARATOR_IF_(x)   // interrupt flag bit of comparator instance x
+#define ADC_COMPARATOR_IE(x)        ADC_COMPARATOR_IE_(x)   // interrupt enable bit of comparator instance x
+#define ADC_COMPARATOR_IP(x)        ADC_COMPARATOR_IP_(x)   // interrupt priority of comparator instance x
+
+#define ADC_FILTER_AVG_RATIO(n)     ((n) - 1)   // ADFLxCON.OVRSAM of 2^n samples in averaging mode
+
 extern volatile uint16_t init_adc_module(void);
 extern volatile uint16_t init_vin_adc(void);
 extern volatile uint16_t init_adc(void);
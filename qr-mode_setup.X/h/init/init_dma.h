@@ -0,0 +1,62 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   init_dma.h
+ * Author: M91406
+ * Comments: header file of the DMA initialization capturing ADC samples into RAM ring buffers
+ * Revision history: 
+ * 1.0  initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INITIALIZE_DMA_H
+#define	INITIALIZE_DMA_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* DMA channel trigger sources (DMAINTx.CHSEL) of the ADC channel conversion complete events
+ * according to dsPIC33CK256MP508 Family Data Sheet (DS70005349), section 'Direct Memory 
+ * Access (DMA) Controller', table 'DMA Channel Trigger Sources': the codes of 'ADC1 Done AN0'
+ * and the following analog inputs are assumed to be consecutive. The resulting codes have not 
+ * been verified on the device; monitor_exec() flags channels which are not triggered. */
+#define DMA_TRIGGER_ADCAN0      0x40    // ADC1 Done AN0
+#define DMA_TRIGGER_ADCAN6      (DMA_TRIGGER_ADCAN0 + 6)    // ADC1 Done AN6 (external reference input)
+#define DMA_TRIGGER_ADCAN12     (DMA_TRIGGER_ADCAN0 + 12)   // ADC1 Done AN12 (input voltage feedback)
+
+extern volatile uint16_t init_dma_module(volatile uint16_t* ram_end);
+extern volatile uint16_t init_dma_vin(volatile uint16_t* buffer, uint16_t length);
+extern volatile uint16_t init_dma_vref(volatile uint16_t* buffer, uint16_t length);
+extern volatile uint16_t launch_dma(void);
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* INITIALIZE_DMA_H */
+
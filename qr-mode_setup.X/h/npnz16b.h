@@ -9,6 +9,7 @@
 
 #include <xc.h>
 #include <dsp.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -17,6 +18,8 @@
 #define NPNZ16_STATUS_LSAT_CLEAR           0
 #define NPNZ16_STATUS_USAT_SET             1
 #define NPNZ16_STATUS_USAT_CLEAR           0
+#define NPNZ16_STATUS_BOOST_SET            1
+#define NPNZ16_STATUS_BOOST_CLEAR          0
 #define NPNZ16_STATUS_INPUT_INVERTED       1
 #define NPNZ16_STATUS_INPUT_NOT_INVERTED   0
 #define NPNZ16_STATUS_ENABLED              1
@@ -30,6 +33,8 @@ typedef enum {
     CONTROLLER_STATUS_LSAT_CLEAR = 0b0000000000000000,
     CONTROLLER_STATUS_USAT_ACTIVE = 0b0000000000000010,
     CONTROLLER_STATUS_USAT_CLEAR = 0b0000000000000000,
+    CONTROLLER_STATUS_BOOST_ACTIVE = 0b0000000000000100,
+    CONTROLLER_STATUS_BOOST_CLEAR = 0b0000000000000000,
     CONTROLLER_STATUS_INV_INPUT_OFF = 0b0000000000000000,
     CONTROLLER_STATUS_INV_INPUT_ON = 0b0100000000000000,
     CONTROLLER_STATUS_ENABLE_OFF = 0b0000000000000000,
@@ -40,7 +45,7 @@ typedef union {
     struct {
         volatile unsigned flt_clamp_min : 1; // Bit 0: control loop is clamped at minimum output level
         volatile unsigned flt_clamp_max : 1; // Bit 1: control loop is clamped at maximum output level
-        volatile unsigned : 1; // Bit 2: reserved
+        volatile unsigned flt_boost : 1; // Bit 2: control output has been boosted by a large error (transient boost)
         volatile unsigned : 1; // Bit 3: reserved
         volatile unsigned : 1; // Bit 4: reserved
         volatile unsigned : 1; // Bit 5: reserved
@@ -96,8 +101,90 @@ typedef struct {
     volatile uint16_t* ptrADCTriggerRegister; // Pointer to ADC trigger register (e.g. TRIG1)
     volatile uint16_t ADCTriggerOffset; // ADC trigger offset to compensate propagation delays 
     
+    // Circular delay line handling (npnz16b_circ variant only)
+    volatile uint16_t HistoryHead; // Byte offset of the most recent entry in the mirrored control and error history buffers
+    
+    // Coefficient hot-swap
+    volatile fractional* ptrCoefficientsPending; // Pointer to the first A coefficient of a bank waiting to become active (NULL = no swap pending)
+    
+    // Non-linear transient boost
+    volatile int16_t BoostBand; // Normalized error magnitude beyond which the control output is boosted (0 = boost disabled)
+    volatile fractional BoostGain; // Control output step per normalized error beyond the band (Q15)
+    
+    // Soft anti-windup (back-calculation)
+    volatile fractional BackCalcGain; // Error history correction per output tick beyond the clamping limits (Q15, 0 = hard clamping)
+    
 } __attribute__((packed))cNPNZ16b_t; // Generic nPnZ Controller Object
 
 
+/*!npnz16b_CommitCoefficients
+ * ***************************************************************************************
+ * Summary:
+ * Activates a pending coefficient bank at the sample boundary
+ * 
+ * Description:
+ * Coefficient banks are published by writing the single-word pointer ptrCoefficientsPending
+ * (see <prefix>_SwapCoefficientBank() generated by NPNZ16B_DEFINE). This function has to be
+ * called by the control loop interrupt service routine right before the controller update.
+ * It is the only place where ptrACoefficients and ptrBCoefficients are changed while the 
+ * controller is running. As it cannot be interrupted by the code publishing a new bank, 
+ * both pointers are always switched together and every sample is computed with the 
+ * coefficients of a single bank.
+ * 
+ * A- and B-coefficients of one bank need to be located back to back in X-space 
+ * (A1 ... AN, B0 ... BN), which is ensured by the bank type generated by NPNZ16B_DECLARE.
+ * ***************************************************************************************/
+
+static inline void npnz16b_CommitCoefficients(volatile cNPNZ16b_t* controller)
+{
+    volatile fractional* ptrBank = controller->ptrCoefficientsPending;
+    
+    if (ptrBank != NULL) {
+        controller->ptrACoefficients = ptrBank; // Switch to first A-coefficient of new bank
+        controller->ptrBCoefficients = (ptrBank + controller->ACoefficientsArraySize); // Switch to first B-coefficient of new bank
+        controller->ptrCoefficientsPending = NULL; // Acknowledge swap
+    }
+    
+    return;
+}
+
+/*!npnz16b_BackCalcGain
+ * ***************************************************************************************
+ * Summary:
+ * Converts a relative back-calculation gain into the BackCalcGain of a controller
+ * 
+ * Description:
+ * When the control output is clamped, the back-calculation of the assembly kernel (macro
+ * NPNZ16B_BACK_CALCULATE in npnz16b.inc) corrects the most recent error history entry by 
+ * BackCalcGain x (limit - u). A change of this entry changes the control output by
+ * 
+ *    B0 x PostScaler x 2^-PostShiftA
+ * 
+ * per tick. 'gain' (Q15) selects the share of the output excess removed from the error
+ * history: 1.0 (0x7FFF) results in an error history matching the clamped output, 0 in hard 
+ * clamping. The result is derived from the active coefficient bank and saturates at 0x7FFF.
+ * It is zero for B0 <= 0.
+ * ***************************************************************************************/
+
+static inline fractional npnz16b_BackCalcGain(volatile cNPNZ16b_t* controller, fractional gain)
+{
+    int32_t slope;
+    uint32_t result;
+    
+    // Control output per error history tick in Q15
+    slope = ((int32_t)controller->ptrBCoefficients[0] * (int32_t)controller->normPostScaler) >> 15;
+    if (controller->normPostShiftA < 0)
+        slope <<= (-controller->normPostShiftA);
+    else
+        slope >>= controller->normPostShiftA;
+    
+    if ((slope <= 0) || (gain <= 0))
+        return(0);
+    
+    result = ((uint32_t)gain << 15) / (uint32_t)slope;
+    
+    return((result > 0x7FFF) ? 0x7FFF : (fractional)result);
+}
+
 /* ***************************************************************************************/
 #endif	// end of __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_H__ header file section
@@ -0,0 +1,54 @@
+/* ***************************************************************************************
+ * Generic library header for z-domain compensation filter assembly functions
+ * ***************************************************************************************
+ * Circular delay line variant (npnz16b_circ_asm.s)
+ *
+ * Control and error histories are kept in mirrored circular buffers addressed through
+ * the HistoryHead field of the cNPNZ16b_t data structure. Each call of
+ * npnz16b_circ_Update() moves the head by one entry instead of shifting every history
+ * entry one tick down the delay line. The routine supports any filter order N >= 2,
+ * taking N from the array size fields of the controller data structure.
+ *
+ * Histories have to be declared with NPNZ16B_CIRC_HISTORY_SIZE(N) entries each and
+ * need to be placed in Y-space. Array size fields need to be set as follows:
+ *
+ *    ACoefficientsArraySize  = N
+ *    BCoefficientsArraySize  = N+1
+ *    ControlHistoryArraySize = N
+ *    ErrorHistoryArraySize   = N+1 (buffer period of both history buffers)
+ *
+ * npnz16b_circ_Reset() or npnz16b_circ_Precharge() have to be called before the first
+ * execution to initialize the buffers and the head index.
+ * ***************************************************************************************/
+
+#ifndef __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_CIRC_H__
+#define __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_CIRC_H__
+
+#include <xc.h>
+#include <dsp.h>
+#include <stdint.h>
+
+#include "npnz16b.h"
+
+/* Number of entries of each mirrored history buffer of a filter of order N */
+#define NPNZ16B_CIRC_HISTORY_SIZE(order)    (2 * ((order) + 1))
+
+/* ***************************************************************************************/
+
+// Function call prototypes for initialization routines and control loops
+
+extern inline void npnz16b_circ_Reset( // Clears the nPnZ controller history buffers and resets the head index
+	volatile cNPNZ16b_t* controller // Pointer to nPnZ data structure
+	);
+
+extern inline void npnz16b_circ_Precharge( // Pre-charges history buffers of the nPnZ with defined steady-state data
+	volatile cNPNZ16b_t* controller, // Pointer to nPnZ data structure
+	volatile uint16_t ctrl_input, // user-defined, constant error history value
+	volatile uint16_t ctrl_output // user-defined, constant control output history value
+	);
+
+extern inline void npnz16b_circ_Update( // Calls the nPnZ controller using circular delay lines
+	volatile cNPNZ16b_t* controller // Pointer to nPnZ data structure
+	);
+
+#endif	// end of __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_CIRC_H__ header file section
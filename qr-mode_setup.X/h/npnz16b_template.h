@@ -0,0 +1,215 @@
+/* ***************************************************************************************
+ * Generic library header for z-domain compensation filter assembly functions
+ * ***************************************************************************************
+ * nPnZ controller template
+ *
+ * C-side counterpart of the assembly template npnz16b.inc. One controller instance of
+ * order N with symbol prefix <prefix> is created by
+ *
+ *    <prefix>.h:      NPNZ16B_DECLARE(<prefix>, N)
+ *    <prefix>.c:      designer output (coefficients and scalers, see below)
+ *                     NPNZ16B_DEFINE(<prefix>, N)
+ *    <prefix>_asm.s:  .include "npnz16b.inc"
+ *                     NPNZ16B_CONTROLLER <prefix>, N
+ *
+ * NPNZ16B_DEFINE expects the following designer output to be declared in the source
+ * file before the macro is expanded:
+ *
+ *    volatile fractional <prefix>_ACoefficients[N]      A-coefficients A1 ... AN
+ *    volatile fractional <prefix>_BCoefficients[N+1]    B-coefficients B0 ... BN
+ *    volatile int16_t <prefix>_pre_scaler               input normalization bit-shift
+ *    volatile int16_t <prefix>_post_shift_A             A-term normalization bit-shift
+ *    volatile int16_t <prefix>_post_shift_B             B-term normalization bit-shift
+ *    volatile fractional <prefix>_post_scaler           output normalization factor
+ *
+ * Supported filter orders are 1 to 6 (limited by the assembly template).
+ *
+ * Coefficient hot-swap:
+ * Each instance owns two coefficient banks in X-space. The running controller uses the
+ * active bank while new coefficients are written into the inactive bank, which is then
+ * published by a single-word pointer write and activated by npnz16b_CommitCoefficients()
+ * at the next sample boundary:
+ *
+ *    bank = <prefix>_GetCoefficientBank();     // NULL while a previous swap is pending
+ *    if (bank != NULL) {
+ *        ... write bank->ACoefficients[] and bank->BCoefficients[] ...
+ *        <prefix>_SwapCoefficientBank(bank);
+ *    }
+ *
+ * or <prefix>_SetCoefficients(a, b) combining these steps. Banks may only be written by
+ * one execution context (e.g. the main loop/scheduler) at a time.
+ * ***************************************************************************************/
+
+#ifndef __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_TEMPLATE_H__
+#define __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_TEMPLATE_H__
+
+#include <xc.h>
+#include <dsp.h>
+#include <stdint.h>
+
+#include "npnz16b.h"
+
+/* ***************************************************************************************
+ * NPNZ16B_DECLARE
+ * Type definitions of the A- and B- coefficient arrays and error- and control-history
+ * arrays, public declaration of the controller data object and function call prototypes
+ * of initialization routines and control loops of one controller instance.
+ *
+ * Coefficient and history arrays are aligned in memory using the 'packed' attribute for
+ * optimized addressing during DSP computations. They are placed in X-space (coefficients)
+ * and Y-space (histories) by NPNZ16B_DEFINE to allow direct X/Y-access from the DSP.
+ * ***************************************************************************************/
+
+#define NPNZ16B_DECLARE(prefix, order) \
+	typedef struct \
+	{ \
+		volatile fractional ACoefficients[(order)]; /* A-Coefficients */ \
+		volatile fractional BCoefficients[(order) + 1]; /* B-Coefficients */ \
+	} __attribute__((packed))prefix##_CONTROL_LOOP_COEFFICIENTS_t; \
+	\
+	typedef struct \
+	{ \
+		volatile fractional ControlHistory[(order)]; /* Control History */ \
+		volatile fractional ErrorHistory[(order) + 1]; /* Error History */ \
+	} __attribute__((packed))prefix##_CONTROL_LOOP_HISTORIES_t; \
+	\
+	extern volatile cNPNZ16b_t prefix; /* user-controller data object */ \
+	\
+	extern inline uint16_t prefix##_Init(void); /* Loads default coefficients into the controller and resets histories to zero */ \
+	\
+	extern inline void prefix##_Reset( /* Resets the controller histories */ \
+		volatile cNPNZ16b_t* controller /* Pointer to nPnZ data structure */ \
+		); \
+	\
+	extern inline void prefix##_Precharge( /* Pre-charges histories of the controller with defined steady-state data */ \
+		volatile cNPNZ16b_t* controller, /* Pointer to nPnZ data structure */ \
+		volatile uint16_t ctrl_input, /* user-defined, constant error history value */ \
+		volatile uint16_t ctrl_output /* user-defined, constant control output history value */ \
+		); \
+	\
+	extern inline void prefix##_Update( /* Calls the controller */ \
+		volatile cNPNZ16b_t* controller /* Pointer to nPnZ data structure */ \
+		); \
+	\
+	extern inline void prefix##_UpdateBlock( /* Calls the controller for a block of input samples */ \
+		volatile cNPNZ16b_t* controller, /* Pointer to nPnZ data structure */ \
+		volatile uint16_t* ptrInput, /* Pointer to array of input samples (replaces controller source) */ \
+		volatile uint16_t* ptrOutput, /* Pointer to array receiving one control output per input sample */ \
+		uint16_t count /* Number of samples to process */ \
+		); \
+	\
+	extern volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t* prefix##_GetCoefficientBank(void); /* Returns the inactive coefficient bank or NULL while a swap is pending */ \
+	\
+	extern uint16_t prefix##_SwapCoefficientBank( /* Publishes a coefficient bank to become active at the next sample */ \
+		volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t* bank /* Pointer to inactive coefficient bank */ \
+		); \
+	\
+	extern uint16_t prefix##_SetCoefficients( /* Loads a new coefficient set into the inactive bank and publishes it */ \
+		volatile fractional* ptrACoefficients, /* Pointer to new A-coefficients A1 ... AN */ \
+		volatile fractional* ptrBCoefficients /* Pointer to new B-coefficients B0 ... BN */ \
+		);
+
+/* ***************************************************************************************
+ * NPNZ16B_DEFINE
+ * Definition of the X/Y-space data arrays, their sizes, the controller data object, the
+ * initialization routine <prefix>_Init() and the coefficient hot-swap functions of one
+ * controller instance.
+ * ***************************************************************************************/
+
+#define NPNZ16B_DEFINE(prefix, order) \
+	volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t __attribute__((space(xmemory), near)) prefix##_coefficients[2]; /* A/B-Coefficient banks (active/inactive) */ \
+	volatile uint16_t prefix##_ACoefficients_size = (sizeof(prefix##_coefficients[0].ACoefficients)/sizeof(prefix##_coefficients[0].ACoefficients[0])); /* A-coefficient array size */ \
+	volatile uint16_t prefix##_BCoefficients_size = (sizeof(prefix##_coefficients[0].BCoefficients)/sizeof(prefix##_coefficients[0].BCoefficients[0])); /* B-coefficient array size */ \
+	\
+	volatile prefix##_CONTROL_LOOP_HISTORIES_t __attribute__((space(ymemory), far)) prefix##_histories; /* Control/Error Histories */ \
+	volatile uint16_t prefix##_ControlHistory_size = (sizeof(prefix##_histories.ControlHistory)/sizeof(prefix##_histories.ControlHistory[0])); /* Control history array size */ \
+	volatile uint16_t prefix##_ErrorHistory_size = (sizeof(prefix##_histories.ErrorHistory)/sizeof(prefix##_histories.ErrorHistory[0])); /* Error history array size */ \
+	\
+	volatile cNPNZ16b_t prefix; /* user-controller data object */ \
+	\
+	uint16_t prefix##_Init(void) \
+	{ \
+		volatile uint16_t i = 0; \
+		\
+		/* Initialize controller data structure at runtime with pre-defined default values */ \
+		prefix.status.value = CONTROLLER_STATUS_CLEAR; /* clear all status flag bits (will turn off execution) */ \
+		\
+		prefix.ptrACoefficients = &prefix##_coefficients[0].ACoefficients[0]; /* initialize pointer to A-coefficients array of bank #0 */ \
+		prefix.ptrBCoefficients = &prefix##_coefficients[0].BCoefficients[0]; /* initialize pointer to B-coefficients array of bank #0 */ \
+		prefix.ptrCoefficientsPending = NULL; /* no coefficient bank swap pending */ \
+		prefix.ptrControlHistory = &prefix##_histories.ControlHistory[0]; /* initialize pointer to control history array */ \
+		prefix.ptrErrorHistory = &prefix##_histories.ErrorHistory[0]; /* initialize pointer to error history array */ \
+		prefix.normPostShiftA = prefix##_post_shift_A; /* initialize A-coefficients/single bit-shift scaler */ \
+		prefix.normPostShiftB = prefix##_post_shift_B; /* initialize B-coefficients/dual/post scale factor bit-shift scaler */ \
+		prefix.normPostScaler = prefix##_post_scaler; /* initialize control output value normalization scaling factor */ \
+		prefix.normPreShift = prefix##_pre_scaler; /* initialize input normalization bit-shift scaler */ \
+		prefix.BoostBand = 0; /* transient boost disabled */ \
+		prefix.BoostGain = 0; /* no transient boost gain */ \
+		prefix.BackCalcGain = 0; /* hard clamping, no back-calculation */ \
+		\
+		prefix.ACoefficientsArraySize = prefix##_ACoefficients_size; /* initialize A-coefficients array size */ \
+		prefix.BCoefficientsArraySize = prefix##_BCoefficients_size; /* initialize B-coefficients array size */ \
+		prefix.ControlHistoryArraySize = prefix##_ControlHistory_size; /* initialize control history array size */ \
+		prefix.ErrorHistoryArraySize = prefix##_ErrorHistory_size; /* initialize error history array size */ \
+		\
+		/* Load default set of A-coefficients from user RAM into X-Space controller A-array */ \
+		for(i=0; i<prefix.ACoefficientsArraySize; i++) \
+		{ \
+			prefix##_coefficients[0].ACoefficients[i] = prefix##_ACoefficients[i]; \
+		} \
+		\
+		/* Load default set of B-coefficients from user RAM into X-Space controller B-array */ \
+		for(i=0; i<prefix.BCoefficientsArraySize; i++) \
+		{ \
+			prefix##_coefficients[0].BCoefficients[i] = prefix##_BCoefficients[i]; \
+		} \
+		\
+		/* Clear error and control histories of the controller */ \
+		prefix##_Reset(&prefix); \
+		\
+		return(1); \
+	} \
+	\
+	volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t* prefix##_GetCoefficientBank(void) \
+	{ \
+		/* The inactive bank must not be written while it is waiting to be activated */ \
+		if (prefix.ptrCoefficientsPending != NULL) \
+			return(NULL); \
+		\
+		/* Return the bank not referenced by the running controller */ \
+		if (prefix.ptrACoefficients == &prefix##_coefficients[0].ACoefficients[0]) \
+			return(&prefix##_coefficients[1]); \
+		else \
+			return(&prefix##_coefficients[0]); \
+	} \
+	\
+	uint16_t prefix##_SwapCoefficientBank(volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t* bank) \
+	{ \
+		/* Publish bank by a single-word pointer write (activated by npnz16b_CommitCoefficients) */ \
+		prefix.ptrCoefficientsPending = &bank->ACoefficients[0]; \
+		return(1); \
+	} \
+	\
+	uint16_t prefix##_SetCoefficients(volatile fractional* ptrACoefficients, volatile fractional* ptrBCoefficients) \
+	{ \
+		volatile uint16_t i = 0; \
+		volatile prefix##_CONTROL_LOOP_COEFFICIENTS_t* bank; \
+		\
+		bank = prefix##_GetCoefficientBank(); \
+		if (bank == NULL) \
+			return(0); /* previous swap still pending, try again after the next sample */ \
+		\
+		for(i=0; i<(order); i++) \
+		{ \
+			bank->ACoefficients[i] = ptrACoefficients[i]; \
+		} \
+		for(i=0; i<((order) + 1); i++) \
+		{ \
+			bank->BCoefficients[i] = ptrBCoefficients[i]; \
+		} \
+		\
+		return(prefix##_SwapCoefficientBank(bank)); \
+	}
+
+/* ***************************************************************************************/
+#endif	// end of __SPECIAL_FUNCTION_LAYER_LIB_NPNZ_TEMPLATE_H__ header file section
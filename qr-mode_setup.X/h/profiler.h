@@ -0,0 +1,143 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   profiler.h
+ * Author: M91406
+ * Comments: execution time profiler of interrupt service routines and tasks
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef EXECUTION_TIME_PROFILER_H
+#define	EXECUTION_TIME_PROFILER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Execution Time Profiler
+ * *************************************************************************************************
+ * Summary:
+ * Cycle-accurate execution time statistics of interrupt service routines and tasks
+ * 
+ * Description:
+ * Code sections are enclosed by PROFILER_ENTER(channel) and PROFILER_EXIT(channel). Both macros
+ * read the free-running time base PROFILER_TIMER (SCCP1, one tick per instruction cycle, see 
+ * init_ccp1_timer()) and the difference is recorded in the statistics of the given channel:
+ * 
+ *    - last:      execution time of the most recent call in [ticks]
+ *    - min/max:   shortest/longest execution time since the last reset in [ticks]
+ *    - mean:      average execution time of the most recent block of 2^PROFILER_MEAN_SHIFT calls
+ *                 in [ticks] (zero until the first block has been completed)
+ *    - histogram: number of calls per execution time bin of 2^PROFILER_HIST_SHIFT ticks; the last 
+ *                 bin collects all calls exceeding the histogram range (saturating at 0xFFFF)
+ * 
+ * PROFILER_SPLIT(channel, split_channel) records the time elapsed since PROFILER_ENTER(channel)
+ * in the statistics of split_channel without ending the measurement of channel.
+ *
+ * The statistics are placed in RAM (data object 'profiler') and can be read by the debugger
+ * or any communication interface. Measured times include interrupt latencies of higher priority
+ * interrupts preempting the profiled code section as well as approx. 4 ticks of time base access.
+ * 
+ * The profiler is enabled by USE_PROFILER in globals.h. When disabled, all macros are empty.
+ * *************************************************************************************************/
+
+typedef enum {
+    PROF_VOUT_ISR     = 0,  // Voltage loop interrupt service routine _VOUT_ADCInterrupt
+    PROF_VREF_ISR     = 1,  // External reference interrupt service routine _ADCAN6Interrupt
+    PROF_PWR_CONTROL  = 2,  // Power controller state machine exec_pwr_control()
+    PROF_VOUT_LATENCY = 3,  // Voltage loop latency from entry of _VOUT_ADCInterrupt to the DAC update
+    PROF_RECORDER     = 4,  // Data recorder capture in _VOUT_ADCInterrupt
+    PROF_CHANNEL_COUNT      // Number of profiler channels
+}PROFILER_CHANNEL_e;
+
+#define PROFILER_HIST_BINS      16  // Number of histogram bins per channel
+#define PROFILER_HIST_SHIFT     5   // Histogram bin width of 2^5 = 32 ticks
+#define PROFILER_MEAN_SHIFT     10  // Mean value is calculated over blocks of 2^10 = 1024 calls
+
+typedef struct {
+    volatile uint16_t last;     // Execution time of the most recent call in [ticks]
+    volatile uint16_t min;      // Minimum execution time in [ticks]
+    volatile uint16_t max;      // Maximum execution time in [ticks]
+    volatile uint16_t mean;     // Average execution time of the most recent block of calls in [ticks]
+    volatile uint32_t sum;      // Execution time accumulator of the recent block
+    volatile uint16_t count;    // Number of calls accumulated in the recent block
+    volatile uint32_t calls;    // Total number of recorded calls
+    volatile uint16_t histogram[PROFILER_HIST_BINS]; // Execution time distribution
+}PROFILER_STATS_t;              // Execution time statistics of one profiler channel
+
+extern volatile PROFILER_STATS_t profiler[PROF_CHANNEL_COUNT];
+
+extern volatile uint16_t profiler_init(void);
+extern volatile uint16_t profiler_reset(void);
+
+/*!profiler_record
+ * *************************************************************************************************
+ * Adds one execution time measurement to the statistics of a profiler channel
+ * *************************************************************************************************/
+
+static inline void profiler_record(volatile PROFILER_STATS_t* stats, uint16_t ticks)
+{
+    uint16_t bin;
+    
+    stats->last = ticks;
+    if (ticks < stats->min) stats->min = ticks;
+    if (ticks > stats->max) stats->max = ticks;
+    
+    stats->sum += ticks;
+    if (++stats->count >= (1 << PROFILER_MEAN_SHIFT)) {
+        stats->mean = (uint16_t)(stats->sum >> PROFILER_MEAN_SHIFT);
+        stats->sum = 0;
+        stats->count = 0;
+    }
+    
+    bin = (ticks >> PROFILER_HIST_SHIFT);
+    if (bin >= PROFILER_HIST_BINS) bin = (PROFILER_HIST_BINS - 1);
+    if (stats->histogram[bin] != 0xFFFF) stats->histogram[bin]++;
+    
+    stats->calls++;
+}
+
+#if (USE_PROFILER == true)
+    #define PROFILER_ENTER(channel)  volatile uint16_t profiler_t0_##channel = PROFILER_TIMER
+    #define PROFILER_EXIT(channel)   { profiler_record(&profiler[channel], (uint16_t)(PROFILER_TIMER - profiler_t0_##channel)); }
+    #define PROFILER_SPLIT(channel, split_channel) { profiler_record(&profiler[split_channel], (uint16_t)(PROFILER_TIMER - profiler_t0_##channel)); }
+#else
+    #define PROFILER_ENTER(channel)
+    #define PROFILER_EXIT(channel)
+    #define PROFILER_SPLIT(channel, split_channel)
+#endif
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* EXECUTION_TIME_PROFILER_H */
+
@@ -80,20 +80,34 @@ typedef enum {
     SS_PWR_ON_DELAY    = 3,  // Soft-Start Phase Power On Delay
     SS_RAMP_UP         = 4,  // Soft-Start Phase Output Ramp Up 
     SS_PWR_GOOD_DELAY  = 5,  // Soft-Start Phase Power Good Delay
-    SS_COMPLETE        = 6   // Soft-Start Phase Complete
+    SS_COMPLETE        = 6,  // Soft-Start Phase Complete
+    SS_FAULT           = 7   // Fault Shutdown (wait for restart back-off and fault release)
 }SOFT_START_STATUS_e;
 
 typedef struct {
     volatile uint16_t reference;            // Soft-Start target reference value
-    volatile uint16_t pwr_on_delay;         // Soft-Start POwer On Delay
+    volatile uint16_t fraction;             // Soft-Start fractional part of the reference (Q16)
+    volatile uint16_t pwr_on_delay;         // Soft-Start Power On Delay in [scheduler ticks]
     volatile uint16_t precharge_delay;      // Soft-Start Bootstrap Capacitor pre-charge delay
-    volatile uint16_t ramp_period;          // Soft-Start Ramp-Up Duration
-    volatile uint16_t ramp_ref_increment;   // Soft-Start Single Reference Increment per Step
-    volatile uint16_t pwr_good_delay;       // Soft-Start Power Good Delay
+    volatile uint16_t ramp_period;          // Soft-Start Ramp-Up Duration in [scheduler ticks]
+    volatile uint32_t ramp_ref_increment;   // Soft-Start Single Reference Increment per Step (Q16)
+    volatile uint16_t pwr_good_delay;       // Soft-Start Power Good Delay in [scheduler ticks]
     volatile uint16_t counter;              // Soft-Start Execution Counter
     volatile uint16_t phase;                // Soft-Start Phase Index
 }SOFT_START_t;                              // Power converter soft-start settings and variables
 
+// ==============================================================================================
+// Power converter burst mode data structure
+// ==============================================================================================
+
+typedef struct {
+    volatile bool active;                   // Burst mode engaged (compensator frozen, PWM gated in packets)
+    volatile bool packet;                   // PWM output is switching (burst packet in progress)
+    volatile uint16_t counter;              // Scheduler ticks of entry qualification or current packet
+    volatile uint16_t packets;              // Number of burst packets since startup
+    volatile uint16_t exits;                // Number of returns to continuous operation since startup
+}BURST_MODE_t;                              // Power converter light-load burst mode status
+
 // ==============================================================================================
 // Power converter soft-start settings data structure and defines
 // ==============================================================================================
@@ -109,6 +123,7 @@ typedef struct {
     volatile CONVERTER_STATUS_t status; // Power converter operation status bits
     volatile SOFT_START_t soft_start;   // Power converter soft-start settings and variables
     volatile CONVERTER_DATA_t data;     // Power converter runtime data
+    volatile BURST_MODE_t burst;        // Power converter light-load burst mode status
 }POWER_CONTROLLER_t;                    // Power converter control & monitoring data structure
 
 
@@ -119,6 +134,7 @@ typedef struct {
 extern volatile uint16_t init_pwr_control(void);
 extern volatile uint16_t launch_pwr_control(void);
 extern volatile uint16_t exec_pwr_control(void);
+extern volatile uint16_t vout_isr_complete(uint16_t t_entry, uint16_t t_dac);
 
 #ifdef	__cplusplus
 }
@@ -0,0 +1,141 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   scheduler.h
+ * Author: M91406
+ * Comments: table-driven cooperative task scheduler based on the Timer1 tick interrupt
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef COOPERATIVE_TASK_SCHEDULER_H
+#define	COOPERATIVE_TASK_SCHEDULER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Cooperative Task Scheduler
+ * *************************************************************************************************
+ * Summary:
+ * Table-driven scheduler executing tasks at multiples of the Timer1 tick period
+ * 
+ * Description:
+ * Timer1 generates an interrupt every MAIN_EXECUTION_PERIOD (scheduler tick). Between ticks 
+ * the CPU is put into Idle mode by scheduler_run(). On every tick, all tasks due are called 
+ * in order of their priority (0 = highest). Each task is described by an entry of the task 
+ * table handed to scheduler_init():
+ * 
+ *    - function:  task function (same signature as all exec-functions of this application)
+ *    - period:    call interval in scheduler ticks
+ *    - offset:    tick at which the task is called first (allows to spread task load)
+ *    - priority:  execution order of tasks due at the same tick (0 = highest)
+ * 
+ * The scheduler records the following statistics per task in the task table, measured in
+ * instruction cycles of the Timer1 time base:
+ * 
+ *    - latency_min/latency_max: delay between scheduler tick and task start; the difference
+ *                 is the jitter of the task
+ *    - wcet:      worst-case execution time
+ *    - overruns:  number of calls which completed after the next scheduler tick (deadline miss)
+ * 
+ * Ticks passed while tasks were still executing are counted as missed ticks. Task counters
+ * advance by the number of elapsed ticks, so task periods remain aligned with real time.
+ * *************************************************************************************************/
+
+typedef volatile uint16_t (*SCHEDULER_TASK_FUNCTION_t)(void);
+
+typedef struct {
+    SCHEDULER_TASK_FUNCTION_t function; // Pointer to task function
+    volatile uint16_t period;           // Task call interval in [ticks]
+    volatile uint16_t offset;           // Tick of the first task call
+    volatile uint16_t priority;         // Execution priority (0 = highest)
+    volatile uint16_t counter;          // Tick counter of the recent task period
+    volatile uint32_t calls;            // Number of task calls
+    volatile uint16_t overruns;         // Number of task calls completing after the next tick
+    volatile uint16_t latency_min;      // Minimum delay between tick and task start in [cycles]
+    volatile uint16_t latency_max;      // Maximum delay between tick and task start in [cycles]
+    volatile uint16_t wcet;             // Worst-case execution time in [cycles]
+}SCHEDULER_TASK_t;                      // Task table entry incl. timing statistics
+
+typedef struct {
+    volatile SCHEDULER_TASK_t* tasks;   // Pointer to task table
+    volatile uint16_t task_count;       // Number of tasks in task table
+    volatile uint16_t pending;          // Number of ticks not processed yet (set by Timer1 interrupt)
+    volatile uint32_t ticks;            // Total number of scheduler ticks
+    volatile uint16_t missed_ticks;     // Number of ticks passed while tasks were executing
+    volatile uint16_t busy_max;         // Longest processing time of one tick incl. all tasks in [cycles]
+}SCHEDULER_t;                           // Scheduler status and statistics
+
+extern volatile SCHEDULER_t scheduler;
+
+#define SCHEDULER_TASK(fn, per, ofs, prio)  { .function = (fn), .period = (per), .offset = (ofs), .priority = (prio) }
+
+extern volatile uint16_t scheduler_init(volatile SCHEDULER_TASK_t* tasks, uint16_t task_count);
+extern volatile uint16_t scheduler_reset_statistics(void);
+extern volatile uint16_t scheduler_run(void);
+
+/*!scheduler_timestamp
+ * *************************************************************************************************
+ * Summary:
+ * Returns the number of scheduler ticks and the recent Timer1 counter value
+ * 
+ * Description:
+ * A Timer1 period match which has not been serviced yet by the tick interrupt (e.g. while a 
+ * higher priority interrupt is executed) is detected by its interrupt flag bit and counted as
+ * tick. The Timer1 counter value in [cycles] is returned in 'timer'.
+ * *************************************************************************************************/
+
+static inline uint32_t scheduler_timestamp(uint16_t* timer)
+{
+    uint32_t ticks;
+    uint16_t count;
+    bool flag;
+    
+    do {
+        ticks = scheduler.ticks;
+        flag = _T1IF;
+        count = TMR1;
+        if ((!flag) && (_T1IF)) { // Timer1 period match between reading flag and counter
+            flag = true;
+            count = TMR1;
+        }
+    } while (ticks != scheduler.ticks);
+    
+    if (flag) ticks++;
+    
+    *timer = count;
+    return(ticks);
+}
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* COOPERATIVE_TASK_SCHEDULER_H */
+
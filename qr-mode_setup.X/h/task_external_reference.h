@@ -44,6 +44,8 @@ extern "C" {
 
 
 extern volatile uint16_t ext_reference_init(void);
+extern volatile uint16_t ext_reference_update(volatile uint16_t* samples, uint16_t count);
+extern volatile uint16_t ext_reference_exec(void);
 
 
 #ifdef	__cplusplus
@@ -0,0 +1,121 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   task_gain_scheduler.h
+ * Author: M91406
+ * Comments: Operating point dependent coefficient scheduling of the voltage loop compensator
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef GAIN_SCHEDULER_HANDLER_H
+#define	GAIN_SCHEDULER_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "c2p2z.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define GS_VIN_POINTS       3   // Number of input voltage levels of the coefficient table
+#define GS_LOAD_POINTS      3   // Number of load levels of the coefficient table
+
+typedef struct {
+    volatile uint16_t counter;      // Execution interval counter
+    volatile uint16_t vin;          // Filtered input voltage in [ADC ticks]
+    volatile uint16_t load;         // Filtered compensator output in [DAC ticks]
+    volatile uint32_t vin_filter;   // Input voltage low-pass filter buffer
+    volatile uint32_t load_filter;  // Peak current reference low-pass filter buffer
+    volatile uint16_t swaps;        // Number of coefficient sets published to the controller
+}GAIN_SCHEDULER_t;                  // Gain scheduler status and operating point
+
+extern volatile GAIN_SCHEDULER_t gain_scheduler;
+
+extern volatile uint16_t gain_scheduler_init(void);
+extern volatile uint16_t gain_scheduler_exec(void);
+
+extern const fractional gs_ACoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][2];
+extern const fractional gs_BCoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][3];
+
+/*!gs_table_position
+ * *************************************************************************************************
+ * Summary:
+ * Locates a value between equally spaced table breakpoints
+ * 
+ * Description:
+ * Returns the index of the lower breakpoint of the table interval containing 'value' and 
+ * writes the position within this interval into 'fraction' (Q15, 0x8000 = upper breakpoint).
+ * Values outside the range [min, max] are clamped to the table borders.
+ * *************************************************************************************************/
+
+static inline uint16_t gs_table_position(uint16_t value, uint16_t min, uint16_t max, uint16_t points, uint16_t* fraction)
+{
+    uint32_t pos;
+    uint16_t span, index;
+
+    if (value <= min) {
+        *fraction = 0;
+        return(0);
+    }
+    if (value >= max) {
+        *fraction = 0x8000;
+        return(points - 2);
+    }
+
+    span = (max - min);
+    pos = (uint32_t)(value - min) * (points - 1);
+    index = (uint16_t)(pos / span);
+    *fraction = (uint16_t)(((pos - ((uint32_t)index * span)) << 15) / span);
+
+    return(index);
+}
+
+/*!gs_interpolate
+ * *************************************************************************************************
+ * Summary:
+ * Bilinear interpolation of one coefficient between four table entries
+ * *************************************************************************************************/
+
+static inline fractional gs_lerp(fractional a, fractional b, uint16_t fraction)
+{
+    return((fractional)(a + (int16_t)((((int32_t)b - (int32_t)a) * (int32_t)fraction) >> 15)));
+}
+
+static inline fractional gs_interpolate(fractional c00, fractional c01, fractional c10, fractional c11, 
+                                        uint16_t f_vin, uint16_t f_load)
+{
+    return(gs_lerp(gs_lerp(c00, c01, f_load), gs_lerp(c10, c11, f_load), f_vin));
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* GAIN_SCHEDULER_HANDLER_H */
+
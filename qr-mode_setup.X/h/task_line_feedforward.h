@@ -0,0 +1,112 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   task_line_feedforward.h
+ * Author: M91406
+ * Comments: Input voltage feed-forward of the peak current reference
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef LINE_FEEDFORWARD_TASK_HANDLER_H
+#define	LINE_FEEDFORWARD_TASK_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Input Voltage Feed-Forward
+ * *************************************************************************************************
+ * Summary:
+ * Feed-forward gain applied to the compensator output before it is written to the DAC
+ * 
+ * Description:
+ * With USE_LINE_FEEDFORWARD enabled, the compensator writes its output into 'ctrl_out' and the
+ * voltage loop interrupt writes 
+ * 
+ *    DAC_VREF_REGISTER = (ctrl_out x gain) >> 12
+ * 
+ * line_feedforward_exec() computes 'gain' every scheduler tick from the averaged input 
+ * voltage, the switching period (MPER) and the slope compensation rate (SLP1DAT) and scales the
+ * clamping limits of the compensator by 1/gain. The assembly variant of the voltage loop 
+ * interrupt (vout_isr_asm.s) reads 'gain' as first word of this data structure and applies it
+ * unconditionally; it is held at LINE_FF_GAIN_UNITY when USE_LINE_FEEDFORWARD is disabled.
+ * *************************************************************************************************/
+
+typedef struct {
+    volatile uint16_t gain;         // Feed-forward gain applied to the compensator output (Q12, first member)
+    volatile uint16_t ctrl_out;     // Compensator output before feed-forward in [DAC ticks]
+    volatile uint16_t period_gain;  // Share of the switching period: sqrt(MPER / LINE_FF_PERIOD_REF) (Q12)
+    volatile uint16_t slope_gain;   // Share of the compensation ramp: 1 + Se x Lp / (CS_GAIN x Vin) (Q12)
+}LINE_FEEDFORWARD_t;                // Input voltage feed-forward status
+
+extern volatile LINE_FEEDFORWARD_t line_feedforward;
+
+extern volatile uint16_t line_feedforward_init(void);
+extern volatile uint16_t line_feedforward_exec(void);
+
+/*!line_feedforward_apply
+ * *************************************************************************************************
+ * Summary:
+ * Converts a compensator output into a peak current reference in [DAC ticks]
+ * *************************************************************************************************/
+
+static inline uint16_t line_feedforward_apply(uint16_t ctrl_out)
+{
+    return((uint16_t)(__builtin_muluu(ctrl_out, line_feedforward.gain) >> 12));
+}
+
+/*!line_feedforward_revert
+ * *************************************************************************************************
+ * Summary:
+ * Converts a peak current reference in [DAC ticks] into the equivalent compensator output
+ * 
+ * Description:
+ * Used to pre-charge the compensator histories when the control loop takes over a DAC value
+ * which has been set directly (e.g. burst mode exit).
+ * *************************************************************************************************/
+
+static inline uint16_t line_feedforward_revert(uint16_t dac)
+{
+    uint16_t gain = line_feedforward.gain;
+    
+    if ((uint16_t)(dac >> 4) >= gain)
+        return(0xFFFF);
+    
+    return(__builtin_divud(((uint32_t)dac << 12), gain));
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* LINE_FEEDFORWARD_TASK_HANDLER_H */
+
@@ -0,0 +1,111 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   task_monitor.h
+ * Author: M91406
+ * Comments: DMA-fed capture and block processing of the monitoring ADC channels
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef MONITORING_TASK_HANDLER_H
+#define	MONITORING_TASK_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Monitoring Sample Ring
+ * *************************************************************************************************
+ * Summary:
+ * RAM ring buffers of the monitoring ADC channels filled by DMA
+ * 
+ * Description:
+ * The input voltage (AN12) and the external reference (AN6) are converted every switching cycle.
+ * Each conversion is transferred by DMA into the next element of the channel's ring buffer 
+ * without any CPU interaction. The monitoring task monitor_exec() is called every scheduler 
+ * tick and processes all samples written since its previous call as one block:
+ * 
+ *    - input voltage: block average published in converter.data.v_in, block minimum/maximum 
+ *    - external reference: block passed to ext_reference_update() (see task_external_reference.c)
+ * 
+ * When the external reference is averaged by the ADC digital filter (EXT_REF_FILTER_HARDWARE),
+ * its ring buffer and DMA channel are not used (MON_CAPTURE_VREF = false).
+ * 
+ * The ring length of 2^MON_RING_LENGTH_LOG2 samples has to exceed the number of conversions per 
+ * scheduler tick plus the maximum scheduling latency. The largest block processed is tracked in
+ * monitor.block_max; blocks close to the ring length indicate lost samples.
+ * 
+ * A DMA channel whose write position does not advance for more than MON_STALL_TICKS calls 
+ * (e.g. due to a wrong trigger source code) is flagged in monitor.dma_fault. While it is 
+ * stalled, monitor_exec() reads the ADC buffer of the channel directly.
+ * *************************************************************************************************/
+
+#define MON_RING_LENGTH     (1 << MON_RING_LENGTH_LOG2) // Number of samples per ring buffer
+#define MON_CAPTURE_VREF    (EXT_REF_FILTER != EXT_REF_FILTER_HARDWARE) // External reference captured by DMA
+
+typedef enum {
+    MON_DMA_FAULT_NONE  = 0x0000,   // All DMA channels advance
+    MON_DMA_FAULT_VIN   = 0x0001,   // DMA channel 0 (AN12 input voltage) stalled at least once
+    MON_DMA_FAULT_VREF  = 0x0002    // DMA channel 1 (AN6 external reference) stalled at least once
+}MONITOR_DMA_FAULT_e;
+
+typedef struct {
+    volatile uint16_t vin[MON_RING_LENGTH];     // Input voltage samples of AN12 (DMA channel 0)
+    #if (MON_CAPTURE_VREF)
+    volatile uint16_t vref[MON_RING_LENGTH];    // External reference samples of AN6 (DMA channel 1)
+    #endif
+}MONITOR_RING_t;                                // Sample ring buffers of the monitoring channels
+
+typedef struct {
+    volatile uint16_t vin_tail;     // Ring index of the oldest unprocessed input voltage sample
+    volatile uint16_t vref_tail;    // Ring index of the oldest unprocessed external reference sample
+    volatile uint16_t vin_min;      // Lowest input voltage sample of the most recent block in [ADC ticks]
+    volatile uint16_t vin_max;      // Highest input voltage sample of the most recent block in [ADC ticks]
+    volatile uint16_t block;        // Number of input voltage samples of the most recent block
+    volatile uint16_t block_max;    // Largest number of input voltage samples per block since startup
+    volatile uint16_t vin_stall;    // Number of consecutive calls without input voltage samples
+    volatile uint16_t vref_stall;   // Number of consecutive calls without external reference samples
+    volatile uint16_t dma_fault;    // Stalled DMA channels since startup (MONITOR_DMA_FAULT_e)
+}MONITOR_t;                         // Monitoring task status
+
+extern volatile MONITOR_RING_t monitor_ring;
+extern volatile MONITOR_t monitor;
+
+extern volatile uint16_t monitor_init(void);
+extern volatile uint16_t monitor_exec(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* MONITORING_TASK_HANDLER_H */
+
@@ -0,0 +1,112 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   task_slope_control.h
+ * Author: M91406
+ * Comments: Adaptive slope compensation of the peak current mode control
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef SLOPE_CONTROL_TASK_HANDLER_H
+#define	SLOPE_CONTROL_TASK_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Adaptive Slope Compensation
+ * *************************************************************************************************
+ * Summary:
+ * Slope compensation ramp (SLP1DAT) adapted to input and output voltage
+ * 
+ * Description:
+ * Peak current mode control in continuous conduction mode is stable against sub-harmonic 
+ * oscillation when the compensation ramp Se exceeds half the difference of the sensed current 
+ * down-slope m2 and up-slope m1:
+ * 
+ *    - m1 = CS_GAIN x Vin / Lp
+ *    - m2 = CS_GAIN x n x (Vout + Vf) / Lp
+ *    - Se = SLOPE_MARGIN x (m2 - m1) / 2, clamped to [SLOPE_RATE_MINIMUM, SLOPE_RATE_MAXIMUM]
+ * 
+ * m2 > m1 corresponds to a duty ratio above 50%, the ramp therefore tracks duty ratio and line 
+ * voltage. As the ramp is only required in continuous conduction mode, it is blended out when 
+ * the predicted conduction time drops below SLOPE_CCM_RATIO of the switching period (quasi-
+ * resonant and discontinuous operation). slope_control_exec() computes the required SLP1DAT 
+ * value every scheduler tick from the averaged voltages in converter.data. Changes larger than 
+ * SLOPE_HYST are handed over to the voltage loop interrupt through 'pending' and written by 
+ * slope_control_commit() once per switching cycle, after the compensator has updated the DAC.
+ * 
+ * When 'enabled' is cleared (SW1 on the development board), the fixed rate DAC_SLOPE_RATE 
+ * is applied.
+ * *************************************************************************************************/
+
+typedef struct {
+    volatile bool enabled;          // Adaptive slope compensation active (fixed DAC_SLOPE_RATE otherwise)
+    volatile uint16_t rate;         // Required slope compensation rate in [SLPxDAT ticks]
+    volatile uint16_t pending;      // Rate waiting to be written into SLP1DAT (0 = none)
+    volatile uint16_t updates;      // Number of rate changes handed over since startup
+}SLOPE_CONTROL_t;                   // Adaptive slope compensation status
+
+extern volatile SLOPE_CONTROL_t slope_control;
+
+extern volatile uint16_t slope_control_init(void);
+extern volatile uint16_t slope_control_exec(void);
+
+/*!slope_control_commit
+ * *************************************************************************************************
+ * Summary:
+ * Writes a pending slope compensation rate into SLP1DAT
+ * 
+ * Description:
+ * Called by the voltage loop interrupt service routine after the DAC update. As the scheduler
+ * task cannot interrupt this routine, the pending rate is taken over and acknowledged in one 
+ * step and SLP1DAT changes at most once per switching cycle.
+ * *************************************************************************************************/
+
+static inline void slope_control_commit(void)
+{
+    uint16_t rate = slope_control.pending;
+    
+    if (rate != 0) {
+        SLP1DAT = rate;             // Slope rate applied from the next ramp on
+        slope_control.pending = 0;  // Acknowledge update
+    }
+    
+    return;
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* SLOPE_CONTROL_TASK_HANDLER_H */
+
@@ -0,0 +1,131 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+/* 
+ * File:   task_valley_control.h
+ * Author: M91406
+ * Comments: Valley switching control of the quasi-resonant flyback operation
+ * Revision history: 
+ *      10/16/2026   initial version
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef VALLEY_CONTROL_TASK_HANDLER_H
+#define	VALLEY_CONTROL_TASK_HANDLER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Valley Switching Control
+ * *************************************************************************************************
+ * Summary:
+ * Selection of the turn-on valley of the drain voltage ringing by the switching period
+ * 
+ * Description:
+ * The PWM generators PG1 (main switch) and PG2 (ADC trigger) run from the master period MPER. 
+ * Every scheduler tick, valley_control_exec() predicts the timing of the switching cycle from 
+ * the peak current reference (comparator DAC), input voltage and output voltage:
+ * 
+ *    - on-time:      t_on    = Lp x Ipk / Vin (reduced by the slope compensation ramp)
+ *    - demagnetization: t_demag = Lp x Ipk / (n x (Vout + Vf))
+ *    - valley k:     t_k     = t_on + t_demag + (k - 1/2) x T_ring
+ * 
+ * and writes the period of the selected valley into MPER. The valley is the first one at or
+ * after the period limit of the present load (see globals.h, section Valley Switching). All 
+ * times are handled in PWM ticks, intermediate results in [PWM ticks << 4].
+ * 
+ * Please note:
+ * The voltage loop is sampled once per switching cycle. Its sampling rate, and therefore the
+ * loop gain of the discrete compensator, changes with the switching period.
+ * *************************************************************************************************/
+
+typedef struct {
+    volatile bool active;           // Valley control is setting the switching period
+    volatile uint16_t valley;       // Selected turn-on valley (1 = first valley, 0 = inactive)
+    volatile uint16_t period;       // Switching period written to MPER in [PWM ticks]
+    volatile uint16_t limit;        // Minimum switching period at the present load in [PWM ticks]
+    volatile uint16_t dwell;        // Number of calls a lower valley has been permitted
+    volatile uint16_t t_on;         // Predicted on-time in [PWM ticks]
+    volatile uint16_t t_demag;      // Predicted demagnetization time in [PWM ticks]
+    volatile uint16_t load;         // Filtered transferred power in [DAC ticks^2 / PWM tick]
+    volatile uint32_t load_filter;  // Transferred power low-pass filter buffer
+    volatile uint16_t changes;      // Number of valley changes since startup
+}VALLEY_CONTROL_t;                  // Valley switching control status
+
+extern volatile VALLEY_CONTROL_t valley_control;
+
+extern volatile uint16_t valley_control_init(void);
+extern volatile uint16_t valley_control_exec(void);
+
+/*!valley_divide
+ * *************************************************************************************************
+ * Unsigned 32/16-bit division saturating at 0xFFFF
+ * *************************************************************************************************/
+
+static inline uint16_t valley_divide(uint32_t numerator, uint16_t denominator)
+{
+    if ((uint16_t)(numerator >> 16) >= denominator)
+        return(0xFFFF);
+
+    return(__builtin_divud(numerator, denominator));
+}
+
+/*!valley_predict
+ * *************************************************************************************************
+ * Predicts on-time and demagnetization time at the peak current reference 'dac'
+ * 
+ * The peak current at the DAC threshold is reduced by the slope compensation ramp SLP1DAT
+ * accumulated after SLP_TRIG_START. 'vout' includes the rectifier forward voltage. t_on and
+ * t_demag are returned in [PWM ticks << 4], the corrected peak current reference in [DAC ticks].
+ * Used by the valley control and the adaptive slope compensation.
+ * *************************************************************************************************/
+
+static inline uint16_t valley_predict(uint16_t dac, uint16_t vin, uint16_t vout, 
+                                      uint32_t* t_on, uint32_t* t_demag)
+{
+    uint16_t slope;
+    
+    *t_on = valley_divide(__builtin_muluu(dac, VALLEY_K_TON), vin);
+    if ((*t_on >> 4) > SLP_TRIG_START) {
+        slope = (uint16_t)((__builtin_muluu((uint16_t)((*t_on >> 4) - SLP_TRIG_START), SLP1DAT) * VALLEY_SLOPE_GAIN) >> 8);
+        dac = (dac > slope) ? (dac - slope) : 0;
+        *t_on = valley_divide(__builtin_muluu(dac, VALLEY_K_TON), vin);
+    }
+    *t_demag = valley_divide(__builtin_muluu(dac, VALLEY_K_TDEMAG), vout);
+    
+    return(dac);
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* VALLEY_CONTROL_TASK_HANDLER_H */
+
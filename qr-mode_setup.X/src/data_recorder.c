@@ -0,0 +1,67 @@
+/*
+ * File:   data_recorder.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 2:20 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "data_recorder.h"
+
+#if ((DATA_RECORDER_DEPTH & DATA_RECORDER_MASK) != 0)
+#error DATA_RECORDER_DEPTH must be a power of 2
+#endif
+#if ((DATA_RECORDER_PRETRIGGER < 1) || (DATA_RECORDER_POSTTRIGGER < 2))
+#error DATA_RECORDER_PRETRIGGER must be in the range of 1 to DATA_RECORDER_DEPTH - 2
+#endif
+
+volatile DATA_RECORDER_t data_recorder; // triggered data recorder of the voltage loop signals
+
+/*!data_recorder_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the data recorder and arms the default trigger sources
+ * *************************************************************************************************/
+
+volatile uint16_t data_recorder_init(void) {
+    
+    data_recorder.state = REC_IDLE;
+    data_recorder.source = REC_TRIG_NONE;
+    data_recorder.index = 0;
+    data_recorder.trigger = 0;
+    data_recorder.counter = 0;
+    data_recorder.depth = DATA_RECORDER_DEPTH;
+    data_recorder.pretrigger = DATA_RECORDER_PRETRIGGER;
+    
+    #if (USE_DATA_RECORDER == true)
+    data_recorder_arm(DATA_RECORDER_TRIGGER, DATA_RECORDER_VOUT_LEVEL);
+    #endif
+    
+    return(1);
+}
+
+/*!data_recorder_arm
+ * *************************************************************************************************
+ * Summary:
+ * Starts a new recording with the given trigger sources
+ * 
+ * Description:
+ * The recording starts with the next call of data_recorder_capture(). The trigger sources are
+ * a combination of DATA_RECORDER_TRIGGER_e flags, the trigger level is the output voltage 
+ * threshold of REC_TRIG_VOUT_ABOVE and REC_TRIG_VOUT_BELOW in [ADC ticks]. Previously recorded
+ * data is overwritten.
+ * *************************************************************************************************/
+
+volatile uint16_t data_recorder_arm(uint16_t trigger_mask, uint16_t trigger_level) {
+    
+    data_recorder.trigger_mask = trigger_mask;
+    data_recorder.trigger_level = trigger_level;
+    data_recorder.state = REC_ARM;
+    
+    return(1);
+}
@@ -0,0 +1,50 @@
+/*
+ * File:   event_log.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 3:40 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "event_log.h"
+
+#if ((EVENT_LOG_DEPTH & EVENT_LOG_MASK) != 0)
+#error EVENT_LOG_DEPTH must be a power of 2
+#endif
+
+volatile EVENT_LOG_t event_log; // event log of the power controller
+
+/*!event_log_init
+ * *************************************************************************************************
+ * Summary:
+ * Clears the event log
+ * 
+ * Description:
+ * Called before the power controller state machine is started. Phase transitions and status 
+ * changes are logged relative to SS_INIT and STAT_OFF.
+ * *************************************************************************************************/
+
+volatile uint16_t event_log_init(void) {
+    
+    volatile uint16_t i=0;
+    
+    for (i=0; i<EVENT_LOG_DEPTH; i++) {
+        event_log.buffer[i].ticks = 0;
+        event_log.buffer[i].timer = 0;
+        event_log.buffer[i].code = EVT_NONE;
+        event_log.buffer[i].data = 0;
+    }
+    
+    event_log.head = 0;
+    event_log.phase = SS_INIT;
+    event_log.op_status = STAT_OFF;
+    event_log.sat_cycles = 0;
+    event_log.sat_release = 0;
+    
+    return(1);
+}
@@ -0,0 +1,222 @@
+/*
+ * File:   fault_handler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 11:55 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "fault_handler.h"
+#include "event_log.h"
+
+volatile FAULT_HANDLER_t fault_handler;
+
+/*!fault_handler_latch
+ * *************************************************************************************************
+ * Summary:
+ * Turns off the PWM output by the fault PCI and records the fault source
+ * *************************************************************************************************/
+
+static inline void fault_handler_latch(uint16_t source)
+{
+    PG1FPCIHbits.SWPCI = 1;         // Latched fault PCI: PWMxH is forced to FLTDAT
+    c2p2z.status.bits.enable = 0;   // Freeze the control loop
+    
+    fault_handler.source |= source;
+    
+    #if (USE_EVENT_LOG == true)
+    event_log_write(EVT_FAULT, source);
+    #endif
+    
+    if (!fault_handler.tripped) {
+        fault_handler.tripped = true;
+        fault_handler.counter = 0;
+        fault_handler.events++;
+    }
+    
+    return;
+}
+
+/*!fault_handler_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the fault handler data structure
+ * 
+ * Description:
+ * The ADC digital comparators and their interrupts are configured by init_vin_adc() and 
+ * init_adc(), the fault PCI of the PWM generator by init_pwm().
+ * *************************************************************************************************/
+
+volatile uint16_t fault_handler_init(void) {
+    
+    fault_handler.tripped = false;
+    fault_handler.uvp_armed = false;
+    fault_handler.source = FAULT_SRC_NONE;
+    fault_handler.restart_delay = FAULT_RESTART_MIN;
+    fault_handler.counter = 0;
+    fault_handler.retries = 0;
+    fault_handler.events = 0;
+    
+    return(1);
+}
+
+/*!fault_handler_trip
+ * *************************************************************************************************
+ * Summary:
+ * Shuts the PWM output down by software (e.g. undefined state of the power controller)
+ * *************************************************************************************************/
+
+volatile uint16_t fault_handler_trip(uint16_t source) {
+    
+    fault_handler_latch(source);
+    
+    return(1);
+}
+
+/*!fault_handler_release
+ * *************************************************************************************************
+ * Summary:
+ * Counts down the restart back-off and releases the fault PCI
+ * 
+ * Description:
+ * Called by the power controller state machine every scheduler tick in SS_FAULT. Returns 1 
+ * when the fault has been released and the converter may restart from SS_STANDBY, otherwise 0.
+ * The output under-voltage protection is disarmed, pending comparator events are cleared and
+ * the comparator interrupts are enabled again. If a fault condition is still present, the 
+ * comparator trips again with the next conversion.
+ * *************************************************************************************************/
+
+volatile uint16_t fault_handler_release(void) {
+    
+    uint16_t v_in = converter.data.v_in;
+    
+    if (fault_handler.counter < fault_handler.restart_delay) {
+        fault_handler.counter++;
+        return(0);
+    }
+    
+    if ((v_in < FAULT_VIN_UV_RELEASE) || (v_in > FAULT_VIN_OV_RELEASE) || 
+        (converter.data.v_out >= FAULT_VOUT_OV))
+        return(0);
+    
+    // Back-off of the next restart
+    if (fault_handler.restart_delay < (FAULT_RESTART_MAX >> 1))
+        fault_handler.restart_delay <<= 1;
+    else
+        fault_handler.restart_delay = FAULT_RESTART_MAX;
+    fault_handler.retries++;
+    
+    // Disarm the output under-voltage protection and clear pending comparator events
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).LOLO = 0;
+    fault_handler.uvp_armed = false;
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).STAT = 0;
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).STAT = 0;
+    ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) = 0;
+    
+    fault_handler.source = FAULT_SRC_NONE;
+    fault_handler.counter = 0;
+    fault_handler.tripped = false;
+    
+    #if (USE_EVENT_LOG == true)
+    event_log_write(EVT_RESTART, fault_handler.retries);
+    #endif
+    
+    // Terminate the latched fault PCI at the next end of cycle
+    PG1FPCIHbits.SWPCI = 0;
+    PG1FPCILbits.SWTERM = 1;
+    
+    ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR) = 1;
+    ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR) = 1;
+    
+    return(1);
+}
+
+/*!fault_handler_monitor
+ * *************************************************************************************************
+ * Summary:
+ * Arms the output under-voltage protection and resets the restart back-off
+ * 
+ * Description:
+ * Called by the power controller state machine every scheduler tick in SS_COMPLETE. The lower
+ * threshold of the output voltage comparator follows the reference:
+ * 
+ *    ADCMPxLO = (v_ref x FAULT_VOUT_UV_GAIN) >> 16
+ * 
+ * After FAULT_RESTART_RESET ticks of normal operation, the next fault is treated as the first
+ * one again (restart back-off FAULT_RESTART_MIN).
+ * *************************************************************************************************/
+
+volatile uint16_t fault_handler_monitor(void) {
+    
+    ADC_COMPARATOR_LO(VOUT_ADC_COMPARATOR) = 
+        (uint16_t)(__builtin_muluu(converter.data.v_ref, FAULT_VOUT_UV_GAIN) >> 16);
+    
+    if (!fault_handler.uvp_armed) {
+        ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).LOLO = 1;
+        fault_handler.uvp_armed = true;
+    }
+    
+    if ((fault_handler.retries > 0) && (++fault_handler.counter >= FAULT_RESTART_RESET)) {
+        fault_handler.restart_delay = FAULT_RESTART_MIN;
+        fault_handler.retries = 0;
+        fault_handler.counter = 0;
+    }
+    
+    return(1);
+}
+
+/*!_VIN_FAULTInterrupt
+ * *************************************************************************************************
+ * Summary:
+ * Input voltage under-/over-voltage lockout interrupt service routine
+ * 
+ * Description:
+ * Called by the ADC digital comparator VIN_ADC_COMPARATOR when a conversion of the input 
+ * voltage is below ADCMPxLO or at/above ADCMPxHI. The PWM output is turned off first. As the 
+ * comparator fires with every conversion while the input voltage is out of range, the 
+ * interrupt is disabled until the fault has been released by fault_handler_release().
+ * *************************************************************************************************/
+
+void __attribute__((__interrupt__, auto_psv))_VIN_FAULTInterrupt(void)
+{
+    PG1FPCIHbits.SWPCI = 1; // Turn off the PWM output first
+    
+    if (REG_VIN_ADCBUF < ADC_COMPARATOR_LO(VIN_ADC_COMPARATOR))
+        fault_handler_latch(FAULT_SRC_VIN_UV);
+    else
+        fault_handler_latch(FAULT_SRC_VIN_OV);
+    
+    ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).STAT = 0;
+    ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) = 0;
+}
+
+/*!_VOUT_FAULTInterrupt
+ * *************************************************************************************************
+ * Summary:
+ * Output voltage over-/under-voltage protection interrupt service routine
+ * 
+ * Description:
+ * Called by the ADC digital comparator VOUT_ADC_COMPARATOR when a conversion of the output 
+ * voltage is at/above ADCMPxHI or, with the under-voltage protection armed, below ADCMPxLO.
+ * *************************************************************************************************/
+
+void __attribute__((__interrupt__, auto_psv))_VOUT_FAULTInterrupt(void)
+{
+    PG1FPCIHbits.SWPCI = 1; // Turn off the PWM output first
+    
+    if (REG_VOUT_ADCBUF >= ADC_COMPARATOR_HI(VOUT_ADC_COMPARATOR))
+        fault_handler_latch(FAULT_SRC_VOUT_OV);
+    else
+        fault_handler_latch(FAULT_SRC_VOUT_UV);
+    
+    ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR) = 0;
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).STAT = 0;
+    ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) = 0;
+}
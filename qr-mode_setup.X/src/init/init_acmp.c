@@ -73,7 +73,11 @@ volatile uint16_t init_acmp(void) {
     DAC1DATL = (INIT_DACDATL & 0x0FFF); // DACx Low Data
         
     // SLPxCONH: DACx SLOPE CONTROL HIGH REGISTER
-    SLP1CONHbits.SLOPEN = 0; // Slope Function Enable/On: Enables slope function
+    #if (USE_ADAPTIVE_SLOPE == true)
+    SLP1CONHbits.SLOPEN = 1; // Slope Function Enable/On: Enables slope function (rate set by slope_control_exec())
+    #else
+    SLP1CONHbits.SLOPEN = 0; // Slope Function Enable/On: Disables slope function
+    #endif
     SLP1CONHbits.HME = 0; // Hysteretic Mode Enable: Disables Hysteretic mode for DACx
     SLP1CONHbits.TWME = 0; // Triangle Wave Mode Enable: Disables Triangle Wave mode for DACx
     SLP1CONHbits.PSE = 0; // Positive Slope Mode Enable: Slope mode is negative (decreasing)
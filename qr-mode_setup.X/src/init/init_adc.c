@@ -10,10 +10,23 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "globals.h"
 #include "init_adc.h"
 
 #define ADC_POWRUP_TIMEOUT  5000
 
+// Each ADC digital filter and digital comparator instance can only be assigned to one input
+#if ((VIN_ADC_FILTER == VOUT_ADC_FILTER) || (VIN_ADC_FILTER == VREF_ADC_FILTER) || (VOUT_ADC_FILTER == VREF_ADC_FILTER))
+#error ADC digital filter instance assigned to more than one analog input (see globals.h)
+#endif
+#if ((VIN_ADC_COMPARATOR == VOUT_ADC_COMPARATOR) || (VIN_ADC_COMPARATOR == VREF_ADC_COMPARATOR) || (VOUT_ADC_COMPARATOR == VREF_ADC_COMPARATOR))
+#error ADC digital comparator instance assigned to more than one analog input (see globals.h)
+#endif
+#if ((VIN_ADC_FILTER_AVG_LOG2 < 1) || (VIN_ADC_FILTER_AVG_LOG2 > 8) || (VOUT_ADC_FILTER_AVG_LOG2 < 1) || \
+     (VOUT_ADC_FILTER_AVG_LOG2 > 8) || (EXT_REF_HW_AVG_LOG2 < 1) || (EXT_REF_HW_AVG_LOG2 > 8))
+#error ADC digital filter averaging ratio out of range (2^1 ... 2^8 samples)
+#endif
+
 volatile uint16_t init_adc_module(void) {
     
     // Make sure power to peripheral is enabled
@@ -118,30 +131,36 @@ volatile uint16_t init_vin_adc(void) {
     ADTRIG3Lbits.TRGSRC12 = 0b00110; // Trigger Source Selection for Corresponding Analog Inputs: PWM2 Trigger 1
     
     // ADCMPxCON: ADC DIGITAL COMPARATOR x CONTROL REGISTER
-    ADCMP0CONbits.CHNL = 12; // Input Channel Number: 12=AN12
-    ADCMP0CONbits.CMPEN = 1; // Comparator Enable: Comparator is enabled
-    ADCMP0CONbits.IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
-    ADCMP0CONbits.BTWN = 0; // Between Low/High Comparator Event: Disabled
-    ADCMP0CONbits.HIHI = 1; // High/High Comparator Event: Enabled
-    ADCMP0CONbits.HILO = 0; // High/Low Comparator Event: Disabled
-    ADCMP0CONbits.LOHI = 0; // Low/High Comparator Event: Disabled
-    ADCMP0CONbits.LOLO = 1; // Low/Low Comparator Event: Enabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).CHNL = 12; // Input Channel Number: 12=AN12
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).CMPEN = 1; // Comparator Enable: Comparator is enabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).BTWN = 0; // Between Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).HIHI = 1; // High/High Comparator Event: Enabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).HILO = 0; // High/Low Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).LOHI = 0; // Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VIN_ADC_COMPARATOR).LOLO = 1; // Low/Low Comparator Event: Enabled
     
     // ADCMPxENL: ADC DIGITAL COMPARATOR x CHANNEL ENABLE REGISTER LOW
-    ADCMP0ENLbits.CMPEN12 = 1; // Comparator Enable for Corresponding Input Channels: AN11 Enabled
+    ADC_COMPARATOR_ENL(VIN_ADC_COMPARATOR).CMPEN12 = 1; // Comparator Enable for Corresponding Input Channels: AN12 Enabled
     
     // ADCMPxLO: ADC COMPARARE REGISTER LOWER THRESHOLD VALUE REGISTER
-    ADCMP0LO = 665; // R1=15.8kOhm, R2=1kOhm, G=0.0595; 9Vin=665 ADC ticks
+    ADC_COMPARATOR_LO(VIN_ADC_COMPARATOR) = FAULT_VIN_UV; // R1=15.8kOhm, R2=1kOhm, G=0.0595; 8.5Vin=628 ADC ticks
 
     // ADCMPxHI: ADC COMPARARE REGISTER UPPER THRESHOLD VALUE REGISTER
-    ADCMP0HI = 1329; //  R1=15.8kOhm, R2=1kOhm, G=0.0595; 18Vin=1329 ADC ticks
+    ADC_COMPARATOR_HI(VIN_ADC_COMPARATOR) = FAULT_VIN_OV; //  R1=15.8kOhm, R2=1kOhm, G=0.0595; 19.5Vin=1440 ADC ticks
     
     // ADFLxCON: ADC DIGITAL FILTER x CONTROL REGISTER
-    ADFL0CONbits.FLEN = 0; // Filter Enable: Filter is disabled
-    ADFL0CONbits.MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
-    ADFL0CONbits.OVRSAM = 0b011; // Filter Averaging/Oversampling Ratio: 16x (result in the ADFLxDAT)
-    ADFL0CONbits.IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
-    ADFL0CONbits.FLCHSEL = 12; // Oversampling Filter Input Channel Selection: 12=AN12
+    ADC_FILTER_CON(VIN_ADC_FILTER).FLEN = 0; // Filter Enable: Filter is disabled during configuration
+    ADC_FILTER_CON(VIN_ADC_FILTER).MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
+    ADC_FILTER_CON(VIN_ADC_FILTER).OVRSAM = ADC_FILTER_AVG_RATIO(VIN_ADC_FILTER_AVG_LOG2); // Filter Averaging Ratio: 2^VIN_ADC_FILTER_AVG_LOG2 (result in the ADFLxDAT)
+    ADC_FILTER_CON(VIN_ADC_FILTER).IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
+    ADC_FILTER_CON(VIN_ADC_FILTER).FLCHSEL = 12; // Oversampling Filter Input Channel Selection: 12=AN12
+    ADC_FILTER_CON(VIN_ADC_FILTER).FLEN = USE_ADC_HW_FILTERS; // Filter Enable: Filter is enabled if ADC digital filters are used
+    
+    // INITIALIZE ADCMPx INTERRUPT (Input voltage under-/over-voltage lockout)
+    ADC_COMPARATOR_IP(VIN_ADC_COMPARATOR) = FAULT_ISR_PRIORITY; // Interrupt Priority Level 6
+    ADC_COMPARATOR_IF(VIN_ADC_COMPARATOR) = 0; // Reset Interrupt Flag Bit
+    ADC_COMPARATOR_IE(VIN_ADC_COMPARATOR) = USE_FAULT_ENGINE; // Enable ADCMPx Interrupt if the fault engine is used
     
     return(1);
 }
@@ -168,30 +187,36 @@ volatile uint16_t init_adc(void) {
     ADTRIG4Lbits.TRGSRC16 = 0b00110; // Trigger Source Selection for Corresponding Analog Inputs: PWM2 Trigger 1
     
     // ADCMPxCON: ADC DIGITAL COMPARATOR x CONTROL REGISTER
-    ADCMP1CONbits.CHNL = 16; // Input Channel Number: 16=AN16
-    ADCMP1CONbits.CMPEN = 0; // Comparator Enable: Comparator is disabled
-    ADCMP1CONbits.IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
-    ADCMP1CONbits.BTWN = 0; // Between Low/High Comparator Event: Disabled
-    ADCMP1CONbits.HIHI = 0; // High/High Comparator Event: Disabled
-    ADCMP1CONbits.HILO = 0; // High/Low Comparator Event: Disabled
-    ADCMP1CONbits.LOHI = 0; // Low/High Comparator Event: Disabled
-    ADCMP1CONbits.LOLO = 0; // Low/Low Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).CHNL = 16; // Input Channel Number: 16=AN16
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).CMPEN = USE_FAULT_ENGINE; // Comparator Enable: Comparator is enabled if the fault engine is used
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).BTWN = 0; // Between Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).HIHI = 1; // High/High Comparator Event: Enabled (over-voltage protection)
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).HILO = 0; // High/Low Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).LOHI = 0; // Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VOUT_ADC_COMPARATOR).LOLO = 0; // Low/Low Comparator Event: Disabled (under-voltage protection is armed by the fault handler)
    
     // ADCMPxENL: ADC DIGITAL COMPARATOR x CHANNEL ENABLE REGISTER LOW
-    ADCMP1ENHbits.CMPEN16 = 0; // Comparator Enable for Corresponding Input Channels: AN16 Disabled
+    ADC_COMPARATOR_ENH(VOUT_ADC_COMPARATOR).CMPEN16 = USE_FAULT_ENGINE; // Comparator Enable for Corresponding Input Channels: AN16 Enabled if the fault engine is used
     
     // ADCMPxLO: ADC COMPARARE REGISTER LOWER THRESHOLD VALUE REGISTER
-    ADCMP1LO = 0; // G=0.148; 0Vout=0 ADC ticks
+    ADC_COMPARATOR_LO(VOUT_ADC_COMPARATOR) = 0; // G=0.148; 0Vout=0 ADC ticks (set by the fault handler)
 
     // ADCMPxHI: ADC COMPARARE REGISTER UPPER THRESHOLD VALUE REGISTER
-    ADCMP1HI = 3673; // G=0.148; 20Vout=3673 ADC ticks
+    ADC_COMPARATOR_HI(VOUT_ADC_COMPARATOR) = FAULT_VOUT_OV; // G=0.148; 20Vout=3683 ADC ticks
     
     // ADFLxCON: ADC DIGITAL FILTER x CONTROL REGISTER
-    ADFL1CONbits.FLEN = 0; // Filter Enable: Filter is disabled
-    ADFL1CONbits.MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
-    ADFL1CONbits.OVRSAM = 0b001; // Filter Averaging/Oversampling Ratio: 16x (result in the ADFLxDAT)
-    ADFL1CONbits.IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
-    ADFL1CONbits.FLCHSEL = 16; // Oversampling Filter Input Channel Selection: 16=AN16
+    ADC_FILTER_CON(VOUT_ADC_FILTER).FLEN = 0; // Filter Enable: Filter is disabled during configuration
+    ADC_FILTER_CON(VOUT_ADC_FILTER).MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
+    ADC_FILTER_CON(VOUT_ADC_FILTER).OVRSAM = ADC_FILTER_AVG_RATIO(VOUT_ADC_FILTER_AVG_LOG2); // Filter Averaging Ratio: 2^VOUT_ADC_FILTER_AVG_LOG2 (result in the ADFLxDAT)
+    ADC_FILTER_CON(VOUT_ADC_FILTER).IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
+    ADC_FILTER_CON(VOUT_ADC_FILTER).FLCHSEL = 16; // Oversampling Filter Input Channel Selection: 16=AN16
+    ADC_FILTER_CON(VOUT_ADC_FILTER).FLEN = USE_ADC_HW_FILTERS; // Filter Enable: Filter is enabled if ADC digital filters are used
+
+    // INITIALIZE ADCMPx INTERRUPT (Output voltage over-/under-voltage protection)
+    ADC_COMPARATOR_IP(VOUT_ADC_COMPARATOR) = FAULT_ISR_PRIORITY; // Interrupt Priority Level 6
+    ADC_COMPARATOR_IF(VOUT_ADC_COMPARATOR) = 0; // Reset Interrupt Flag Bit
+    ADC_COMPARATOR_IE(VOUT_ADC_COMPARATOR) = USE_FAULT_ENGINE; // Enable ADCMPx Interrupt if the fault engine is used
 
     return(1);
 }
@@ -218,30 +243,31 @@ volatile uint16_t init_pot_adc(void) {
     ADTRIG1Hbits.TRGSRC6 = 0b00101; // Trigger Source Selection for Corresponding Analog Inputs: PWM1 Trigger 2 
     
     // ADCMPxCON: ADC DIGITAL COMPARATOR x CONTROL REGISTER
-    ADCMP1CONbits.CHNL = 6;  // Input Channel Number: 6=AN6
-    ADCMP1CONbits.CMPEN = 0; // Comparator Enable: Comparator is disabled
-    ADCMP1CONbits.IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
-    ADCMP1CONbits.BTWN = 0; // Between Low/High Comparator Event: Disabled
-    ADCMP1CONbits.HIHI = 0; // High/High Comparator Event: Disabled
-    ADCMP1CONbits.HILO = 0; // High/Low Comparator Event: Disabled
-    ADCMP1CONbits.LOHI = 0; // Low/High Comparator Event: Disabled
-    ADCMP1CONbits.LOLO = 0; // Low/Low Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).CHNL = 6;  // Input Channel Number: 6=AN6
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).CMPEN = 0; // Comparator Enable: Comparator is disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).IE = 0; // Comparator Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the comparator
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).BTWN = 0; // Between Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).HIHI = 0; // High/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).HILO = 0; // High/Low Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).LOHI = 0; // Low/High Comparator Event: Disabled
+    ADC_COMPARATOR_CON(VREF_ADC_COMPARATOR).LOLO = 0; // Low/Low Comparator Event: Disabled
    
     // ADCMPxENL: ADC DIGITAL COMPARATOR x CHANNEL ENABLE REGISTER LOW
-    ADCMP1ENLbits.CMPEN6 = 0; // Comparator Enable for Corresponding Input Channels: AN6 Disabled
+    ADC_COMPARATOR_ENL(VREF_ADC_COMPARATOR).CMPEN6 = 0; // Comparator Enable for Corresponding Input Channels: AN6 Disabled
     
     // ADCMPxLO: ADC COMPARARE REGISTER LOWER THRESHOLD VALUE REGISTER
-    ADCMP1LO = 0; // G=1; 0Vpot=0 ADC ticks
+    ADC_COMPARATOR_LO(VREF_ADC_COMPARATOR) = 0; // G=1; 0Vpot=0 ADC ticks
 
     // ADCMPxHI: ADC COMPARARE REGISTER UPPER THRESHOLD VALUE REGISTER
-    ADCMP1HI = 3722; // G=1; 3Vpot=3722 ADC ticks
+    ADC_COMPARATOR_HI(VREF_ADC_COMPARATOR) = 3722; // G=1; 3Vpot=3722 ADC ticks
     
     // ADFLxCON: ADC DIGITAL FILTER x CONTROL REGISTER
-    ADFL1CONbits.FLEN = 0; // Filter Enable: Filter is disabled
-    ADFL1CONbits.MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
-    ADFL1CONbits.OVRSAM = 0b001; // Filter Averaging/Oversampling Ratio: 16x (result in the ADFLxDAT)
-    ADFL1CONbits.IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
-    ADFL1CONbits.FLCHSEL = 6; // Oversampling Filter Input Channel Selection: 6=AN6
+    ADC_FILTER_CON(VREF_ADC_FILTER).FLEN = 0; // Filter Enable: Filter is disabled during configuration
+    ADC_FILTER_CON(VREF_ADC_FILTER).MODE = 0b11; // Filter Mode: Averaging mode (always 12-bit result 7 in oversampling mode 12-16bit wide)
+    ADC_FILTER_CON(VREF_ADC_FILTER).OVRSAM = ADC_FILTER_AVG_RATIO(EXT_REF_HW_AVG_LOG2); // Filter Averaging Ratio: 2^EXT_REF_HW_AVG_LOG2 (result in the ADFLxDAT)
+    ADC_FILTER_CON(VREF_ADC_FILTER).IE = 0; // Filter Common ADC Interrupt Enable: Common ADC interrupt will not be generated for the filter
+    ADC_FILTER_CON(VREF_ADC_FILTER).FLCHSEL = 6; // Oversampling Filter Input Channel Selection: 6=AN6
+    ADC_FILTER_CON(VREF_ADC_FILTER).FLEN = USE_ADC_HW_FILTERS; // Filter Enable: Filter is enabled if ADC digital filters are used
 
      // INITIALIZE AN6 INTERRUPTS (Potentiometer Voltage for manually setting reference)
     _ADCAN6IP = 2;   // Interrupt Priority Level 5
@@ -0,0 +1,60 @@
+/*
+ * File:   init_ccp.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 4:10 PM
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "init_ccp.h"   
+
+/*!init_ccp1_timer
+ * *************************************************************************************************
+ * Summary:
+ * Sets up SCCP1 as free-running 16-bit time base of the execution time profiler
+ * 
+ * Description:
+ * The timer is clocked by the peripheral clock (FCY = CPU_FREQUENCY) without prescaler, so one 
+ * timer tick equals one instruction cycle. The period register is set to its maximum to let the 
+ * counter roll over at 0xFFFF, which allows to measure time differences of up to 655 usec by a 
+ * simple 16-bit subtraction. No interrupts are generated by this module.
+ * *************************************************************************************************/
+
+volatile uint16_t init_ccp1_timer(void)
+{
+
+    CCP1CON1Lbits.CCPON = 0;    // CCP1 Module Enable: Module is disabled during configuration
+    CCP1CON1Lbits.CCPSIDL = 0;  // CCP1 Stop in Idle Mode: Continues module operation in Idle mode
+    CCP1CON1Lbits.CCPSLP = 0;   // CCP1 Sleep Mode Enable: Module does not operate in Sleep mode
+    CCP1CON1Lbits.TMRSYNC = 0;  // Time Base Clock Synchronization: Asynchronous module time base clock
+    CCP1CON1Lbits.CLKSEL = 0b000; // CCP1 Time Base Clock Select: Peripheral clock (FCY)
+    CCP1CON1Lbits.TMRPS = 0b00; // Time Base Prescale Select: 1:1
+    CCP1CON1Lbits.T32 = 0;      // 32-Bit Time Base Select: Uses 16-bit time base
+    CCP1CON1Lbits.CCSEL = 0;    // Capture/Compare Mode Select: Output Compare/PWM/Timer mode
+    CCP1CON1Lbits.MOD = 0b0000; // CCP1 Mode Select: 16-Bit/32-Bit Timer mode, output functions are disabled
+    
+    CCP1CON1H = 0x0000; // No synchronization or trigger source, no one-shot mode
+    CCP1CON2L = 0x0000; // No auxiliary output, no input capture source
+    CCP1CON2H = 0x0000; // No output pins are controlled by the module
+    CCP1CON3H = 0x0000; // No dead time, no output polarity inversion
+    
+    // Reset Timer Counter Register to Zero and set maximum period (free-running)
+    CCP1TMRL = 0x0000;
+    CCP1PRL = 0xFFFF;
+    
+    // Reset interrupt and interrupt flag bits
+    _CCP1IP = 0;  // Set interrupt priority to zero
+    _CCP1IF = 0;  // Reset interrupt flag bit
+    _CCP1IE = 0;  // Disable CCP1 interrupt
+    _CCT1IP = 0;  // Set timer interrupt priority to zero
+    _CCT1IF = 0;  // Reset timer interrupt flag bit
+    _CCT1IE = 0;  // Disable CCP1 timer interrupt
+    
+    CCP1CON1Lbits.CCPON = 1;    // CCP1 Module Enable: Start free-running time base
+    
+    return(1);
+}
@@ -0,0 +1,155 @@
+/*
+ * File:   init_dma.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 8:20 PM
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "init_dma.h"   
+
+/*!init_dma_module
+ * *************************************************************************************************
+ * Summary:
+ * Sets up the DMA controller
+ * 
+ * Description:
+ * The DMA controller is configured with fixed channel priorities. DMA transfers are limited to 
+ * the address range from 0x0000 (SFR space, source of the ADC buffers) up to the last address 
+ * of the RAM section holding the ring buffers (ram_end). The DMA channels are
+ * enabled by launch_dma().
+ * *************************************************************************************************/
+
+volatile uint16_t init_dma_module(volatile uint16_t* ram_end)
+{
+    // Make sure power to peripheral is enabled
+    PMD7bits.DMA0MD = 0; // DMA0 Module Disable: DMA0 module is enabled
+    PMD7bits.DMA1MD = 0; // DMA1 Module Disable: DMA1 module is enabled
+    
+    // DMACON: DMA ENGINE CONTROL REGISTER
+    DMACONbits.DMAEN = 0;   // DMA Module Enable: DMA module is disabled during configuration
+    DMACONbits.PRSSEL = 0;  // Channel Priority Scheme Selection: Fixed priority scheme
+    
+    // DMAL/DMAH: DMA LOW/HIGH ADDRESS LIMIT REGISTERS
+    DMAL = 0x0000;          // Lowest address accessible by DMA: start of SFR space (ADC buffers)
+    DMAH = (uint16_t)ram_end; // Highest address accessible by DMA: end of ring buffers
+    
+    return(1);
+}
+
+/*!init_dma_vin
+ * *************************************************************************************************
+ * Summary:
+ * Sets up DMA channel 0 to capture the input voltage samples of AN12 into a ring buffer
+ * 
+ * Description:
+ * Every conversion of AN12 triggers the transfer of one word from ADCBUF12 into the next 
+ * element of the ring buffer (repeated one-shot mode, destination address incremented). After 
+ * 'length' transfers, source address, destination address and transfer count are reloaded and 
+ * the buffer is filled again from its first element. The current write position can be read
+ * from DMADST0 at any time. No interrupts are generated by this channel.
+ * *************************************************************************************************/
+
+volatile uint16_t init_dma_vin(volatile uint16_t* buffer, uint16_t length)
+{
+    // DMACHx: DMA CHANNEL x CONTROL REGISTER
+    DMACH0bits.CHEN = 0;        // Channel Enable: Channel is disabled during configuration
+    DMACH0bits.SIZE = 0;        // Data Size Selection: Word (16-bit)
+    DMACH0bits.TRMODE = 0b01;   // Transfer Mode Selection: Repeated One-Shot
+    DMACH0bits.SAMODE = 0b00;   // Source Address Mode Selection: DMASRCx remains unchanged
+    DMACH0bits.DAMODE = 0b01;   // Destination Address Mode Selection: DMADSTx is incremented
+    DMACH0bits.RELOAD = 1;      // Address and Count Reload: DMASRCx, DMADSTx and DMACNTx are reloaded
+    DMACH0bits.NULLW = 0;       // Null Write Mode: No dummy write is initiated
+    DMACH0bits.CHREQ = 0;       // DMA Channel Software Request: No software request
+    
+    // DMAINTx: DMA CHANNEL x INTERRUPT CONTROL REGISTER
+    DMAINT0bits.CHSEL = DMA_TRIGGER_ADCAN12; // DMA Channel Trigger Selection: ADC1 Done AN12
+    DMAINT0bits.HALFEN = 0;     // Halfway Completion Watermark: Interrupt is invoked only at the completion
+    DMAINT0bits.DBUFWF = 0;     // DMA Buffered Data Write Flag: reset
+    DMAINT0bits.HIGHIF = 0;     // DMA High Address Limit Interrupt Flag: reset
+    DMAINT0bits.LOWIF = 0;      // DMA Low Address Limit Interrupt Flag: reset
+    DMAINT0bits.DONEIF = 0;     // DMA Complete Operation Interrupt Flag: reset
+    DMAINT0bits.HALFIF = 0;     // DMA 50% Watermark Level Interrupt Flag: reset
+    DMAINT0bits.OVRUNIF = 0;    // DMA Channel Overrun Flag: reset
+    
+    // DMASRCx/DMADSTx/DMACNTx: DMA CHANNEL x SOURCE/DESTINATION ADDRESS AND COUNT REGISTERS
+    DMASRC0 = (uint16_t)&REG_VIN_ADCBUF;
+    DMADST0 = (uint16_t)buffer;
+    DMACNT0 = length;
+    
+    _DMA0IP = 0;  // Set interrupt priority to zero
+    _DMA0IF = 0;  // Reset interrupt flag bit
+    _DMA0IE = 0;  // Disable DMA channel 0 interrupt
+    
+    return(1);
+}
+
+/*!init_dma_vref
+ * *************************************************************************************************
+ * Summary:
+ * Sets up DMA channel 1 to capture the external reference samples of AN6 into a ring buffer
+ * 
+ * Description:
+ * Every conversion of AN6 triggers the transfer of one word from ADCBUF6 into the next element 
+ * of the ring buffer (see init_dma_vin() for details). The current write position can be read
+ * from DMADST1 at any time. No interrupts are generated by this channel.
+ * *************************************************************************************************/
+
+volatile uint16_t init_dma_vref(volatile uint16_t* buffer, uint16_t length)
+{
+    // DMACHx: DMA CHANNEL x CONTROL REGISTER
+    DMACH1bits.CHEN = 0;        // Channel Enable: Channel is disabled during configuration
+    DMACH1bits.SIZE = 0;        // Data Size Selection: Word (16-bit)
+    DMACH1bits.TRMODE = 0b01;   // Transfer Mode Selection: Repeated One-Shot
+    DMACH1bits.SAMODE = 0b00;   // Source Address Mode Selection: DMASRCx remains unchanged
+    DMACH1bits.DAMODE = 0b01;   // Destination Address Mode Selection: DMADSTx is incremented
+    DMACH1bits.RELOAD = 1;      // Address and Count Reload: DMASRCx, DMADSTx and DMACNTx are reloaded
+    DMACH1bits.NULLW = 0;       // Null Write Mode: No dummy write is initiated
+    DMACH1bits.CHREQ = 0;       // DMA Channel Software Request: No software request
+    
+    // DMAINTx: DMA CHANNEL x INTERRUPT CONTROL REGISTER
+    DMAINT1bits.CHSEL = DMA_TRIGGER_ADCAN6; // DMA Channel Trigger Selection: ADC1 Done AN6
+    DMAINT1bits.HALFEN = 0;     // Halfway Completion Watermark: Interrupt is invoked only at the completion
+    DMAINT1bits.DBUFWF = 0;     // DMA Buffered Data Write Flag: reset
+    DMAINT1bits.HIGHIF = 0;     // DMA High Address Limit Interrupt Flag: reset
+    DMAINT1bits.LOWIF = 0;      // DMA Low Address Limit Interrupt Flag: reset
+    DMAINT1bits.DONEIF = 0;     // DMA Complete Operation Interrupt Flag: reset
+    DMAINT1bits.HALFIF = 0;     // DMA 50% Watermark Level Interrupt Flag: reset
+    DMAINT1bits.OVRUNIF = 0;    // DMA Channel Overrun Flag: reset
+    
+    // DMASRCx/DMADSTx/DMACNTx: DMA CHANNEL x SOURCE/DESTINATION ADDRESS AND COUNT REGISTERS
+    DMASRC1 = (uint16_t)&REG_VREF_ADCBUF;
+    DMADST1 = (uint16_t)buffer;
+    DMACNT1 = length;
+    
+    _DMA1IP = 0;  // Set interrupt priority to zero
+    _DMA1IF = 0;  // Reset interrupt flag bit
+    _DMA1IE = 0;  // Disable DMA channel 1 interrupt
+    
+    return(1);
+}
+
+/*!launch_dma
+ * *************************************************************************************************
+ * Summary:
+ * Enables the DMA controller and the ADC sample capture channels
+ * 
+ * Description:
+ * The external reference channel is only enabled when the reference is not averaged by the
+ * ADC digital filter (EXT_REF_FILTER_HARDWARE, see globals.h).
+ * *************************************************************************************************/
+
+volatile uint16_t launch_dma(void)
+{
+    DMACONbits.DMAEN = 1;   // DMA Module Enable: DMA module is enabled
+    DMACH0bits.CHEN = 1;    // Channel Enable: Input voltage capture channel is enabled
+    #if (EXT_REF_FILTER != EXT_REF_FILTER_HARDWARE)
+    DMACH1bits.CHEN = 1;    // Channel Enable: External reference capture channel is enabled
+    #endif
+    
+    return(1);
+}
@@ -131,7 +131,7 @@ volatile uint16_t init_pwm(void) {
     PG1IOCONLbits.OVRDAT = 0b01; // Data for PWMxH/PWMxL Pins if Override Event is Active: PWMxL=OVRDAT0, PWMxH=OVRDAR1
     PG1IOCONLbits.OSYNC = 0b00; // User Output Override Synchronization Control: User output overrides via the OVRENH/L and OVRDAT[1:0] bits are synchronized to the local PWM time base (next Start-of-Cycle)
     
-    PG1IOCONLbits.FLTDAT = 0b00; // Data for PWMxH/PWMxL Pins if Fault Event is Active: PWMxL=FLTDAT0, PWMxH=FLTDAR1
+    PG1IOCONLbits.FLTDAT = 0b00; // Data for PWMxH/PWMxL Pins if Fault Event is Active: PWMxL=FLTDAT0, PWMxH=FLTDAR1 (both off)
     PG1IOCONLbits.CLDAT = 0b00; // Data for PWMxH/PWMxL Pins if Current-Limit Event is Active: PWMxL=CLDAT0, PWMxH=CLDAR1
     PG1IOCONLbits.FFDAT = 0b00; // Data for PWMxH/PWMxL Pins if Feed-Forward Event is Active: PWMxL=CLDAT0, PWMxH=CLDAR1
     PG1IOCONLbits.DBDAT = 0b00; // Data for PWMxH/PWMxL Pins if Debug Mode Event is Active: PWMxL=DBDAT0, PWMxH=DBDAR1
@@ -188,9 +188,32 @@ volatile uint16_t init_pwm(void) {
     PG1CLPCILbits.PSS       = 0b11011;      // Selecting Comparator 1 output as PCI input
 //    PG1CLPCILbits.PSS       = 0b00000;      // PCI is DISABLED
     
-    // Reset further PCI control registers
+    #if (USE_FAULT_ENGINE == true)
+    // PGxFPCIH: PWM GENERATOR F PCI REGISTER HIGH
+    PG1FPCIHbits.BPEN       = 0b0;          // PCI function is not bypassed
+    PG1FPCIHbits.BPSEL      = 0b000;        // PCI control is sourced from PWM Generator 1 PCI logic when BPEN = 1
+    PG1FPCIHbits.ACP        = 0b011;        // PCI Acceptance Mode: Latched
+    PG1FPCIHbits.SWPCI      = 0b0;          // Drives a '0' to PCI logic assigned to by the SWPCIM<1:0> control bits (set by the fault interrupts)
+    PG1FPCIHbits.SWPCIM     = 0b00;         // SWPCI bit is assigned to PCI acceptance logic
+    PG1FPCIHbits.PCIGT      = 0b0;          // SR latch is Set-dominant in Latched Acceptance modes
+    PG1FPCIHbits.TQPS       = 0b0;          // Termination Qualifier not inverted
+    PG1FPCIHbits.TQSS       = 0b000;        // No termination qualifier
+    
+    // PGxFPCIL: PWM GENERATOR F PCI REGISTER LOW
+    PG1FPCILbits.TSYNCDIS   = 0;            // Termination of latched PCI occurs at PWM EOC
+    PG1FPCILbits.TERM       = 0b000;        // Termination Event: Manual termination by writing '1' to SWTERM (restart of the power controller)
+    PG1FPCILbits.AQPS       = 0b0;          // Acceptance Qualifier not inverted
+    PG1FPCILbits.AQSS       = 0b000;        // No acceptance qualifier
+    PG1FPCILbits.SWTERM     = 0b0;          // A write of '1' to this location will produce a termination event. This bit location always reads as '0'.
+    PG1FPCILbits.PSYNC      = 0;            // PCI source is not synchronized to PWM EOC (PWM output is turned off immediately)
+    PG1FPCILbits.PPS        = 0;            // Non-inverted PCI polarity
+    PG1FPCILbits.PSS        = 0b00000;      // PCI input tied to '0': the fault is driven by SWPCI only
+    #else
     PG1FPCIH        = 0x0000;          // PWM GENERATOR F PCI REGISTER HIGH
     PG1FPCIL        = 0x0000;          // PWM GENERATOR F PCI REGISTER LOW
+    #endif
+    
+    // Reset further PCI control registers
     PG1FFPCIH       = 0x0000;          // PWM GENERATOR FF PCI REGISTER HIGH
     PG1FFPCIL       = 0x0000;          // PWM GENERATOR FF PCI REGISTER LOW
     PG1SPCIH        = 0x0000;          // PWM GENERATOR S PCI REGISTER HIGH
@@ -11,25 +11,138 @@
 #include <stdbool.h>
 
 #include "main.h"
+#include "profiler.h"
+#include "task_monitor.h"
+#include "task_valley_control.h"
+#include "task_slope_control.h"
+#include "task_line_feedforward.h"
+#include "fault_handler.h"
+#include "data_recorder.h"
+#include "event_log.h"
+#include "scheduler.h"
+
+#define TGL_PERIOD      3000    // LED toggle interval of 3000 x 100usec = 300ms
+#define BTN_PERIOD      10      // SW1 polling interval of 10 x 100usec = 1ms
 
-volatile uint16_t tgl_cnt = 0;  // local counter of LED toggle loops
-#define TGL_INTERVAL    2999    // LED toggle interval of (2999 + 1) x 100usec = 100ms
-#define TMR_TIMEOUT     30000   // Timeout protection for Timer1 interrupt flag bit
+volatile bool btn_push = false;
 
-volatile uint32_t dac_cnt = 0;  // local counter of LED toggle loops
-#define DACMOD_COUNT    1999    // DAC increment interval of (1999 + 1) x 100usec = 200ms
+/*!task_pwr_control
+ * *************************************************************************************************
+ * Summary:
+ * Power controller state machine task (executed every scheduler tick)
+ * *************************************************************************************************/
 
-volatile bool btn_push = false;
+volatile uint16_t task_pwr_control(void) {
 
-int main(void) {
+    DBGPIN_1_TOGGLE; // Toggle DEBUG-PIN
+    
+    PROFILER_ENTER(PROF_PWR_CONTROL);
+    exec_pwr_control();
+    PROFILER_EXIT(PROF_PWR_CONTROL);
+    
+    return(1);
+}
+
+/*!task_led_toggle
+ * *************************************************************************************************
+ * Summary:
+ * Toggles the debugging LED as sign of life
+ * *************************************************************************************************/
+
+volatile uint16_t task_led_toggle(void) {
+
+    DBGLED_TOGGLE;
+    
+    return(1);
+}
+
+/*!task_button
+ * *************************************************************************************************
+ * Summary:
+ * Polls switch SW1 of the development board
+ * 
+ * Description:
+ * If SW1 on the development board is pressed, the slope compensation slew rate is incremented
+ * in steps of 100mV/usec (=8) starting at 100mV/usec up to 1.5V/usec and then resets to the 
+ * default value. With USE_ADAPTIVE_SLOPE enabled, SW1 toggles between the adaptive slope 
+ * compensation and the fixed rate DAC_SLOPE_RATE instead. The red LED is on while the button 
+ * is pressed.
+ * *************************************************************************************************/
+
+volatile uint16_t task_button(void) {
+
+    if((!_RC11) && (!btn_push)) {
+
+        btn_push = true; 
+        DBGLED_RD_SET;
+        DBGLED_GN_CLEAR;
+
+        #if (USE_ADAPTIVE_SLOPE == true)
+        slope_control.enabled = !slope_control.enabled; // Toggle adaptive/fixed slope compensation
+        #else
+        if(SLP1DAT < 120) {
+            SLP1DAT += 8;   // Increment slope slew rate by 100mV/usec up to 1.5V
+        }
+        else {
+            SLP1DAT = DAC_SLOPE_RATE;
+        }
+        #endif
+
+    }
+
+    if((_RC11) && (btn_push)) { 
+        btn_push = false; 
+        DBGLED_RD_CLEAR;
+        DBGLED_GN_SET;
+    }
+    
+    return(1);
+}
 
-    volatile uint16_t timeout = 0;
-     
+/*!Task Table
+ * *************************************************************************************************
+ * Summary:
+ * Tasks executed by the scheduler
+ * 
+ * Description:
+ * Each task is called every 'period' scheduler ticks of 100 usec. Tasks due at the same tick are
+ * executed in order of their priority (0 = highest). See scheduler.h for details.
+ * *************************************************************************************************/
+
+volatile SCHEDULER_TASK_t task_table[] = {
+    
+    //              function                period      offset  priority
+    SCHEDULER_TASK( &task_pwr_control,      1,          0,      0 ),
+    #if (USE_DMA_MONITORING == true)
+    SCHEDULER_TASK( &monitor_exec,          1,          0,      1 ),
+    #endif
+    #if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
+    SCHEDULER_TASK( &ext_reference_exec,    1,          0,      2 ),
+    #endif
+    #if (USE_GAIN_SCHEDULING == true)
+    SCHEDULER_TASK( &gain_scheduler_exec,   1,          0,      3 ),
+    #endif
+    #if (USE_VALLEY_SWITCHING == true)
+    SCHEDULER_TASK( &valley_control_exec,   1,          0,      4 ),
+    #endif
+    #if (USE_ADAPTIVE_SLOPE == true)
+    SCHEDULER_TASK( &slope_control_exec,    1,          0,      5 ),
+    #endif
+    #if (USE_LINE_FEEDFORWARD == true)
+    SCHEDULER_TASK( &line_feedforward_exec, 1,          0,      6 ),
+    #endif
+    SCHEDULER_TASK( &task_button,           BTN_PERIOD, 3,      7 ),
+    SCHEDULER_TASK( &task_led_toggle,       TGL_PERIOD, 7,      8 )
     
+};
+
+int main(void) {
+
     init_fosc();        // Set up system oscillator for 100 MIPS operation
     init_aclk();        // Set up Auxiliary PLL for 500 MHz (source clock to PWM module)
     init_timer1();      // Set up Timer1 as scheduler time base
     init_gpio();        // Initialize common device GPIOs
+    profiler_init();    // Set up execution time profiler
     
     // Basic setup of common power controller peripheral modules
     init_pwm_module();  // Set up PWM module (basic module configuration)
@@ -38,6 +151,16 @@ int main(void) {
     init_vin_adc();     // Initialize ADC Channel to measure input voltage
     
     ext_reference_init();   // initialize external reference input
+    #if (USE_DMA_MONITORING == true)
+    monitor_init();         // start DMA capture of input voltage and external reference
+    #endif
+    gain_scheduler_init();  // initialize gain scheduler of the voltage loop compensator
+    valley_control_init();  // initialize valley switching control
+    slope_control_init();   // initialize adaptive slope compensation
+    line_feedforward_init(); // initialize input voltage feed-forward
+    fault_handler_init();   // initialize hardware fault shutdown and restart back-off
+    data_recorder_init();   // initialize and arm the triggered data recorder
+    event_log_init();       // clear the event log of the power controller
     
     // Reset Soft-Start Phase to Initialization
     converter.soft_start.phase = SS_INIT;   
@@ -55,53 +178,11 @@ int main(void) {
 
 // ===========================================
     
-    // Enable Timer1
-    T1CONbits.TON = 1; 
+    // Start scheduler tick (Timer1) and execute tasks
+    scheduler_init(task_table, (sizeof(task_table)/sizeof(task_table[0])));
     
     while (1) {
-
-        // wait for timer1 to overrun
-        while ((!_T1IF) && (timeout++ < TMR_TIMEOUT));
-        timeout = 0;    // Reset timeout counter
-        _T1IF = 0; // reset Timer1 interrupt flag bit
-        DBGPIN_1_TOGGLE; // Toggle DEBUG-PIN
-
-        exec_pwr_control();
-               
-        if (tgl_cnt++ > TGL_INTERVAL) // Count 100 usec loops until LED toggle interval is exceeded
-        {
-            DBGLED_TOGGLE;
-            tgl_cnt = 0;
-        } // Toggle LED and reset toggle counter
-        Nop();
-        
-        
-        if((!_RC11) && (!btn_push)) {
-        // If SW1 on the development board is pressed...
-        // Starting at a slope of 100mV/usec (=8), the slew rate is incremented in single steps
-        // up to 1V/usec (=80) and then resets to 100mV/usec (=8)
-
-            btn_push = true; 
-            DBGLED_RD_SET;
-            DBGLED_GN_CLEAR;
-
-            if(SLP1DAT < 120) {
-                SLP1DAT += 8;   // Increment slope slew rate by 100mV/usec up to 1.5V
-            }
-            else {
-                SLP1DAT = DAC_SLOPE_RATE;
-            }
-
-        }
-
-        if((_RC11) && (btn_push)) { 
-            btn_push = false; 
-            DBGLED_RD_CLEAR;
-            DBGLED_GN_SET;
-        }
-        
-
-        
+        scheduler_run(); // Idle until next scheduler tick and execute all tasks due
     }
 
 
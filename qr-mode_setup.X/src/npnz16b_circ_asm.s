@@ -0,0 +1,260 @@
+;LICENSE / DISCLAIMER
+; **********************************************************************************
+;  Author:      M91406
+;  Date/Time:   10/16/26 11:20:00 AM
+; **********************************************************************************
+;  nPnZ Control Library File (Single Coefficient Factor Scaling Mode)
+;  Circular delay line variant for compensation filters of order 2 and above
+; **********************************************************************************
+;
+;  Control and error histories are held in mirrored circular buffers. Each new sample
+;  is written twice (at the head index and one buffer period above it), so the most
+;  recent N samples are always available as one contiguous window starting at the head.
+;  The MAC operand prefetch runs over this window without any modulo or wrap-around
+;  handling. Instead of moving every history entry one tick down the delay line, only
+;  the head index is decremented once per call.
+;
+;  Memory layout requirements (see npnz16b_circ.h):
+;    - ErrorHistoryArraySize = N+1 (buffer period P, number of B-coefficients)
+;    - ControlHistoryArraySize = N (number of A-coefficients)
+;    - both history arrays hold 2*P entries in Y-space (NPNZ16B_CIRC_HISTORY_SIZE)
+;    - HistoryHead holds the byte offset of the most recent entry (0 ... 2*P-2)
+;
+;  Estimated instruction cycles spent on history maintenance and delay line addressing,
+;  counted by hand from the instruction sequences (MOV/ADD/SUB/SL = 1 cycle, BTSC = 2 cycles
+;  when skipping, REPEAT = 1 cycle), not measured:
+;
+;    Order    shift-copy (npnz16b.inc)    circular (this file)    circular incl. REPEAT setup
+;    2P2Z              8                          15                          21
+;    3P3Z             12                          15                          21
+;    4P4Z             16                          15                          21
+;    5P5Z             20                          15                          21
+;    6P6Z             24                          15                          21
+;
+;  The shift-copy delay line costs 4*N cycles (2*N+1 for the error history, 2*N-1 for
+;  the control history). The circular delay line costs 7 cycles for the head update,
+;  2 cycles for the A-term window and 3 cycles per history write, independent of N.
+;  The order-generic MAC loops add 6 cycles of REPEAT setup which an order-specific,
+;  unrolled build would not need. By this estimate, this file would only save cycles
+;  at 6P6Z (an unrolled circular build from 4P4Z), and the fully unrolled 2P2Z in 
+;  c2p2z_asm.s is kept for the current power supply. The estimate has to be confirmed
+;  with the MPLAB X simulator stopwatch or the profiler on the device before a higher 
+;  order compensator is deployed with this variant.
+; **********************************************************************************
+	
+;------------------------------------------------------------------------------
+;file start
+	.nolist
+	.include "npnz16b.inc"    ; generic nPnZ control library template (status bits and data structure offsets)
+	.list
+	
+;------------------------------------------------------------------------------
+;local inclusions.
+	.section .text    ; place code in the code section
+	
+;------------------------------------------------------------------------------
+; Global function declaration
+; This function calls the z-domain controller processing the latest data point input
+;------------------------------------------------------------------------------
+	
+	.global _npnz16b_circ_Update
+_npnz16b_circ_Update:    ; provide global scope to routine
+	push w12    ; save working register used for status flag tracking
+	
+;------------------------------------------------------------------------------
+; Check status word for Enable/Disable flag and bypass computation, if disabled
+	mov [w0 + #offStatus], w12
+	btss w12, #NPMZ16_STATUS_ENABLE
+	bra NPNZ16B_CIRC_BYPASS_LOOP
+	
+;------------------------------------------------------------------------------
+; Configure DSP for fractional operation with normal saturation (Q1.31 format)
+	mov #0x00E4, w4
+	mov w4, _CORCON
+	
+;------------------------------------------------------------------------------
+; Advance the history head by one entry (shared by control and error delay line)
+; w2 and w3 are held until the end of the routine
+	mov [w0 + #offErrHistArraySize], w2    ; load buffer period P
+	sl w2, #1, w2    ; convert buffer period into mirror offset in bytes
+	mov [w0 + #offHistoryHead], w3    ; load current head byte offset
+	sub w3, #2, w3    ; move head one entry back
+	btsc w3, #15    ; skip wrap-around if head is still within the buffer
+	add w3, w2, w3    ; wrap head around to the upper end of the buffer
+	mov w3, [w0 + #offHistoryHead]    ; store new head byte offset
+	
+;------------------------------------------------------------------------------
+; Setup pointers to A-Term data arrays
+; The control history window of the previous call starts one entry above the new head
+	mov [w0 + #offACoefficients], w8    ; load pointer to first index of A coefficients array
+	mov [w0 + #offControlHistory], w10    ; load pointer to control history buffer
+	add w10, w3, w10    ; add head offset
+	inc2 w10, w10    ; point to entry (n-1)
+	
+;------------------------------------------------------------------------------
+; Compute compensation filter term
+	mov [w0 + #offACoeffArraySize], w5    ; load number of A coefficients
+	sub w5, #2, w5    ; repeat counter = N-2 (N-1 MACs with prefetch)
+	clr a, [w8]+=2, w4, [w10]+=2, w6    ; clear accumulator A and prefetch first operands
+	repeat w5    ; run through the control history window
+	mac w4*w6, a, [w8]+=2, w4, [w10]+=2, w6    ; multiply & accumulate control output (n-k) with coefficient Ak and prefetch next operands
+	mac w4*w6, a    ; multiply & accumulate last control output with coefficient of the delay line (no more prefetch)
+	
+;------------------------------------------------------------------------------
+; Read data from input source and calculate error input to transfer function
+	mov [w0 + #offSourceRegister], w5    ; load pointer to input source register
+	mov [w5], w1    ; move value from input source into working register
+	mov [w0 + #offControlReference], w5    ; move pointer to control reference into working register
+	subr w1, [w5], w1    ; calculate error (= reference - input)
+	mov [w0 + #offPreShift], w5    ; move error input scaler into working register
+	sl w1, w5, w1    ; normalize error result to fractional number format
+	
+;------------------------------------------------------------------------------
+; Update error history (write error to head entry and its mirror)
+	mov [w0 + #offErrorHistory], w10    ; load pointer to error history buffer
+	add w10, w3, w10    ; add head offset
+	mov w1, [w10]    ; add most recent error input to history array
+	mov w1, [w10 + w2]    ; add most recent error input to mirror of history array
+	
+;------------------------------------------------------------------------------
+; Compute compensation filter term
+	mov [w0 + #offBCoefficients], w8    ; load pointer to first index of B coefficients array
+	mov [w0 + #offBCoeffArraySize], w5    ; load number of B coefficients
+	sub w5, #2, w5    ; repeat counter = N-1 (N MACs with prefetch)
+	movsac a, [w8]+=2, w4, [w10]+=2, w6    ; leave contents accumulator A untouched and prefetch first operands
+	repeat w5    ; run through the error history window
+	mac w4*w6, a, [w8]+=2, w4, [w10]+=2, w6    ; multiply & accumulate error input (n-k) with coefficient Bk and prefetch next operands
+	mac w4*w6, a    ; multiply & accumulate last error input with coefficient of the delay line (no more prefetch)
+	
+;------------------------------------------------------------------------------
+; Backward normalization of recent result
+	mov [w0 + #offPostShiftA], w6
+	sftac a, w6
+	sac.r a, w4    ; store most recent accumulator result in working register
+	
+;------------------------------------------------------------------------------
+; Initialize Scale-factor and multiply
+	mov [w0 + #offPostScaler],  w6
+	mpy w4*w6, a
+	sac.r a, w4    ; store most recent accumulator result in working register
+	
+;------------------------------------------------------------------------------
+; Non-linear transient boost (assemble-time option, see npnz16b.inc)
+	.if USE_TRANSIENT_BOOST
+	NPNZ16B_BOOST NPNZ16B_CIRC, w1
+	.endif
+	
+;------------------------------------------------------------------------------
+; Controller Anti-Windup (control output value clamping, see npnz16b.inc)
+	NPNZ16B_CLAMP NPNZ16B_CIRC, circ=1, backcalc=USE_SOFT_DESATURATION
+	
+;------------------------------------------------------------------------------
+; Write control output value to target
+	mov [w0 + #offTargetRegister], w8    ; move pointer to target in to working register
+	mov w4, [w8]    ; move control output into target address
+	
+;------------------------------------------------------------------------------
+; Update ADC trigger position
+	asr w4, #1, w6
+	mov [w0 + #offADCTriggerOffset], w8
+	add w6, w8, w6
+	mov [w0 + #offADCTriggerRegister], w8
+	mov w6, [w8]
+	
+;------------------------------------------------------------------------------
+; Update control output history (write output to head entry and its mirror)
+	mov [w0 + #offControlHistory], w10    ; load pointer to control history buffer
+	add w10, w3, w10    ; add head offset
+	mov w4, [w10]    ; add most recent control output to history array
+	mov w4, [w10 + w2]    ; add most recent control output to mirror of history array
+	
+;------------------------------------------------------------------------------
+; Update status flag bitfield
+	mov w12, [w0 + #offStatus]
+	
+;------------------------------------------------------------------------------
+; Enable/Disable bypass branch target
+	NPNZ16B_CIRC_BYPASS_LOOP:
+	pop w12    ; restore working register used for status flag tracking
+	
+;------------------------------------------------------------------------------
+; End of routine
+	return
+;------------------------------------------------------------------------------
+	
+;------------------------------------------------------------------------------
+; Global function declaration _npnz16b_circ_Reset
+; This function clears control and error history buffers and resets the head index
+;------------------------------------------------------------------------------
+	
+	.global _npnz16b_circ_Reset
+_npnz16b_circ_Reset:
+	
+;------------------------------------------------------------------------------
+; Load number of buffer entries (2 x buffer period)
+	mov [w0 + #offErrHistArraySize], w2
+	sl w2, #1, w2    ; buffer size = 2*P entries
+	dec w2, w2    ; repeat counter = buffer size - 1
+	
+;------------------------------------------------------------------------------
+; Clear control history buffer
+	mov [w0 + #offControlHistory], w1
+	repeat w2
+	clr [w1++]    ; Clear next address of control history buffer
+	
+;------------------------------------------------------------------------------
+; Clear error history buffer
+	mov [w0 + #offErrorHistory], w1
+	repeat w2
+	clr [w1++]    ; Clear next address of error history buffer
+	
+;------------------------------------------------------------------------------
+; Reset head index
+	clr w1
+	mov w1, [w0 + #offHistoryHead]
+	
+;------------------------------------------------------------------------------
+; End of routine
+	return
+;------------------------------------------------------------------------------
+	
+;------------------------------------------------------------------------------
+; Global function declaration _npnz16b_circ_Precharge
+; This function loads user-defined default values into control and error history buffers
+;------------------------------------------------------------------------------
+	
+	.global _npnz16b_circ_Precharge
+_npnz16b_circ_Precharge:
+	
+;------------------------------------------------------------------------------
+; Load number of buffer entries (2 x buffer period)
+	mov [w0 + #offErrHistArraySize], w3
+	sl w3, #1, w3    ; buffer size = 2*P entries
+	dec w3, w3    ; repeat counter = buffer size - 1
+	
+;------------------------------------------------------------------------------
+; Charge error history buffer with defined value
+	mov [w0 + #offErrorHistory], w4
+	repeat w3
+	mov w1, [w4++]    ; Load user value into next address of error history buffer
+	
+;------------------------------------------------------------------------------
+; Charge control history buffer with defined value
+	mov [w0 + #offControlHistory], w4
+	repeat w3
+	mov w2, [w4++]    ; Load user value into next address of control history buffer
+	
+;------------------------------------------------------------------------------
+; Reset head index
+	clr w4
+	mov w4, [w0 + #offHistoryHead]
+	
+;------------------------------------------------------------------------------
+; End of routine
+	return
+;------------------------------------------------------------------------------
+	
+;------------------------------------------------------------------------------
+; End of file
+	.end
+;------------------------------------------------------------------------------
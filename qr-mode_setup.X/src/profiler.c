@@ -0,0 +1,65 @@
+/*
+ * File:   profiler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 4:10 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "profiler.h"
+
+volatile PROFILER_STATS_t profiler[PROF_CHANNEL_COUNT]; // execution time statistics of all profiler channels
+
+/*!profiler_init
+ * *************************************************************************************************
+ * Summary:
+ * Starts the profiler time base and clears all statistics
+ * *************************************************************************************************/
+
+volatile uint16_t profiler_init(void) {
+
+    #if (USE_PROFILER == true)
+    init_ccp1_timer();  // Set up SCCP1 as free-running time base
+    #endif
+    
+    profiler_reset();   // Clear all statistics
+    
+    return(1);
+}
+
+/*!profiler_reset
+ * *************************************************************************************************
+ * Summary:
+ * Clears the statistics of all profiler channels
+ * 
+ * Description:
+ * Statistics may be reset at any time, e.g. after startup or when the operating point has been 
+ * changed. Channels currently updated by an interrupt service routine may contain one mixed
+ * measurement after the reset.
+ * *************************************************************************************************/
+
+volatile uint16_t profiler_reset(void) {
+
+    volatile uint16_t i=0, j=0;
+    
+    for (i=0; i<PROF_CHANNEL_COUNT; i++) {
+        
+        profiler[i].last = 0;
+        profiler[i].min = 0xFFFF;
+        profiler[i].max = 0;
+        profiler[i].mean = 0;
+        profiler[i].sum = 0;
+        profiler[i].count = 0;
+        profiler[i].calls = 0;
+        
+        for (j=0; j<PROFILER_HIST_BINS; j++)
+            profiler[i].histogram[j] = 0;
+    }
+    
+    return(1);
+}
@@ -11,38 +11,100 @@
 #include <stdbool.h>
 
 #include "globals.h"
+#include "profiler.h"
+#include "task_slope_control.h"
+#include "task_line_feedforward.h"
+#include "fault_handler.h"
+#include "data_recorder.h"
+#include "event_log.h"
+
+#if ((USE_ALT_WREG_ISR == true) && (USE_CLOSED_LOOP_CONTROL == false))
+    #error USE_ALT_WREG_ISR requires USE_CLOSED_LOOP_CONTROL
+#endif
+
+/* Soft-start timing range checks: the tick counts of the soft-start (see globals.h) are 16-bit
+ * values. As the preprocessor cannot evaluate floating point expressions, a setting out of 
+ * range declares a bit-field of negative width. */
+#define SOFT_START_TICKS_CHECK(name, period, minimum) \
+    struct name { unsigned int check : (((uint32_t)(((period) / MAIN_EXECUTION_PERIOD) + 0.5) >= (minimum)) && \
+                                        ((uint32_t)(((period) / MAIN_EXECUTION_PERIOD) + 0.5) <= 65535UL)) ? 1 : -1; }
+
+SOFT_START_TICKS_CHECK(power_on_delay_out_of_range, POWER_ON_DELAY, 0UL);
+SOFT_START_TICKS_CHECK(ramp_period_out_of_range, RAMP_PERIOD, 1UL);
+SOFT_START_TICKS_CHECK(power_good_delay_out_of_range, POWER_GOOD_DELAY, 0UL);
+
+/* Soft-start ramp slope range check: the Q16 reference increment per tick needs to be at least 
+ * 1 LSB and must not exceed the nominal reference (ramp shorter than one tick). */
+struct ramp_slope_out_of_range {
+    unsigned int check : ((RAMP_STEP >= 1.0) && (RAMP_STEP <= ((double)V_OUT_REF * 65536.0))) ? 1 : -1;
+};
 
 volatile POWER_CONTROLLER_t converter;
 
+/* The compensator output is the peak current reference written to the DAC, not a duty cycle. 
+ * The ADC trigger position update of the compensator is therefore redirected into this 
+ * variable, leaving the output voltage sampling point at the fixed position VOUT_ADCTRIG. */
+static volatile uint16_t vout_adctrig_dummy = 0;
+
+#if (USE_BURST_MODE == true)
+static void pwr_burst_reset(void);
+static void pwr_burst_control(void);
+#endif
+
+#if (USE_FAULT_ENGINE == true)
+static void pwr_fault_shutdown(void);
+#endif
+
+#if (USE_PREBIAS_STARTUP == true)
+static void pwr_prebias_launch(void);
+#endif
+
 volatile uint16_t init_pwr_control(void) {
     
     init_trig_pwm();   // Set up auxiliary PWM for power converter
     init_pwm();        // Set up power converter PWM
     init_acmp();       // Set up power converter peak current comparator/DAC
     init_adc();        // Set up power converter ADC (voltage feedback only)
-    init_pot_adc();    // Set up ADC for sampling reference provided by external voltage divider        
     
     converter.soft_start.counter = 0;                             // Reset Soft-Start Counter
-    converter.soft_start.pwr_on_delay = POWER_ON_DELAY;     // Soft-Start Power-On Delay = 500 ms
-    converter.soft_start.ramp_period = RAMP_PERIOD;         // Soft-Start Ramp Period = 50 ms
-    converter.soft_start.pwr_good_delay = POWER_GOOD_DELAY; // Soft-Start Power Good Delay = 200 ms
-    converter.soft_start.reference = V_OUT_REF;             // Soft-Start Target Reference = 12V
-    converter.soft_start.ramp_ref_increment = REF_STEP;     // Soft-Start Single Step Increment of Reference
+    converter.soft_start.pwr_on_delay = POD;                // Soft-Start Power-On Delay = 500 ms
+    converter.soft_start.ramp_period = RPER;                // Soft-Start Ramp Period = 50 ms (RAMP_SLOPE = 300 V/s)
+    converter.soft_start.pwr_good_delay = PGD;              // Soft-Start Power Good Delay = 100 ms
+    converter.soft_start.reference = V_OUT_REF;             // Soft-Start Target Reference = 15V
+    converter.soft_start.fraction = 0;                      // Soft-Start Fractional Reference
+    converter.soft_start.ramp_ref_increment = REF_STEP;     // Soft-Start Single Step Increment of Reference (Q16)
     
     c2p2z_Init();
     
     c2p2z.ADCTriggerOffset = VOUT_ADCTRIG;
-    c2p2z.ptrADCTriggerRegister = &REG_VOUT_ADCTRIG;
+    c2p2z.ptrADCTriggerRegister = &vout_adctrig_dummy;
     c2p2z.InputOffset = VOUT_FEEDBACK_OFFSET;
     c2p2z.ptrControlReference = &converter.data.v_ref;
     c2p2z.ptrSource = &REG_VOUT_ADCBUF;
+    #if (USE_LINE_FEEDFORWARD == true)
+    c2p2z.ptrTarget = &line_feedforward.ctrl_out; // DAC is written after the feed-forward gain
+    #else
     c2p2z.ptrTarget = &DAC_VREF_REGISTER;
+    #endif
     c2p2z.MaxOutput = DAC_MAX;
     c2p2z.MinOutput = DAC_MIN;
+    #if (USE_TRANSIENT_BOOST == true)
+    c2p2z.BoostBand = (BOOST_BAND << c2p2z.normPreShift); // error band of the normalized error
+    c2p2z.BoostGain = (fractional)(BOOST_GAIN >> c2p2z.normPreShift); // step per normalized error
+    #endif
+    #if (USE_SOFT_DESATURATION == true)
+    c2p2z.BackCalcGain = npnz16b_BackCalcGain(&c2p2z, SOFT_DESAT_GAIN); // error history correction of a clamped output
+    #endif
     c2p2z.status.bits.enable = 0;
     
     converter.data.v_ref    = 0; // Reset power reference value (will be set via external potentiometer)
     
+    #if (USE_BURST_MODE == true)
+    pwr_burst_reset();
+    converter.burst.packets = 0;
+    converter.burst.exits = 0;
+    #endif
+    
     return(1);
 }
 
@@ -59,7 +121,29 @@ volatile uint16_t launch_pwr_control(void) {
 }
 
 volatile uint16_t exec_pwr_control(void) {
+    
+    uint32_t ramp;
         
+    // Update monitoring values (not copied by the voltage loop interrupt service routine)
+    #if (USE_ADC_HW_FILTERS == true)
+    #if (USE_DMA_MONITORING == false)
+    converter.data.v_in = REG_VIN_ADFLDAT; // (block average published by monitor_exec() otherwise)
+    #endif
+    converter.data.v_out = REG_VOUT_ADFLDAT;
+    #else
+    #if (USE_DMA_MONITORING == false)
+    converter.data.v_in = REG_VIN_ADCBUF; // (block average published by monitor_exec() otherwise)
+    #endif
+    converter.data.v_out = REG_VOUT_ADCBUF;
+    #endif
+    
+    #if (USE_FAULT_ENGINE == true)
+    // The PWM output has already been turned off by the fault PCI: take the converter down
+    if ((fault_handler.tripped) && (converter.soft_start.phase >= SS_STANDBY) && 
+        (converter.soft_start.phase != SS_FAULT))
+        pwr_fault_shutdown();
+    #endif
+    
     switch (converter.soft_start.phase) {
         
         /*!SS_INIT
@@ -111,6 +195,9 @@ volatile uint16_t exec_pwr_control(void) {
             PG1IOCONLbits.OVRENH = 1;           // Disable PWMxH output
             c2p2z.status.bits.enable = 0; // Disable the control loop
             converter.status.flags.pwm_active = false;   // Clear PWM_ACTIVE flag bit
+            #if (USE_BURST_MODE == true)
+            pwr_burst_reset();                  // Leave burst mode
+            #endif
 
             // wait for fault to be cleared, adc to run and the GO bit to be set
             if( (converter.status.flags.enabled == 1) && 
@@ -126,14 +213,20 @@ volatile uint16_t exec_pwr_control(void) {
         /*!SS_PWR_ON_DELAY
          * In this step the soft-start procedure is counting up call intervals until
          * the defined power-on delay period has expired. PWM and control loop are disabled.
-         * At the end of this phase, the state automatically switches to RAMP_UP mode */     
+         * At the end of this phase, the state automatically switches to RAMP_UP mode. With 
+         * USE_PREBIAS_STARTUP enabled, the ramp starts at the measured output voltage. */     
         case SS_PWR_ON_DELAY:  
 
             converter.status.flags.op_status = STAT_START; // Set converter status to START-UP
             
-            if(converter.soft_start.counter++ > converter.soft_start.pwr_on_delay)
+            if(++converter.soft_start.counter >= converter.soft_start.pwr_on_delay)
             {
+                converter.soft_start.fraction = 0;   // Ramp starts at an integer reference
+                #if (USE_PREBIAS_STARTUP == true)
+                pwr_prebias_launch();                // Start the ramp at the pre-biased output voltage
+                #else
                 converter.soft_start.reference = 0;  // Reset soft-start reference to minimum
+                #endif
                 c2p2z.ptrControlReference = &converter.soft_start.reference; // Hijack controller reference
 
                 converter.soft_start.counter = 0;                   // Reset soft-start counter
@@ -145,8 +238,9 @@ volatile uint16_t exec_pwr_control(void) {
          * During ramp up, the PWM and control loop are forced ON while the control reference is 
          * incremented. Once the 'private' reference of the soft-start data structure equals the
          * reference level set in converter.data.v_ref, the ramp-up period ends and the state machine 
-         * automatically switches to POWER GOOD DELAY mode */     
-        case SS_RAMP_UP: // Increasing reference by 4 every scheduler cycle
+         * automatically switches to POWER GOOD DELAY mode. The increment is a Q16 number, the 
+         * fractional part of the reference is accumulated in converter.soft_start.fraction. */     
+        case SS_RAMP_UP: // Increasing reference by REF_STEP every scheduler cycle
             
             converter.status.flags.op_status = STAT_START; // Set converter status to START-UP
 
@@ -154,25 +248,38 @@ volatile uint16_t exec_pwr_control(void) {
             PG1IOCONLbits.OVRENH = 0;           // User override disabled for PWMxH Pin =< PWM signal output starts
             c2p2z.status.bits.enable = 1; // Start the control loop 
 
-            converter.soft_start.reference += 4;  // increment reference
+            ramp = (((uint32_t)converter.soft_start.reference << 16) | converter.soft_start.fraction) + 
+                   converter.soft_start.ramp_ref_increment; // increment reference
             
             // check if ramp is complete
-            if (converter.soft_start.reference >= converter.data.v_ref)
+            if (ramp >= ((uint32_t)converter.data.v_ref << 16))
             {
+                converter.soft_start.reference = converter.data.v_ref;  // End the ramp at the reference
+                converter.soft_start.fraction = 0;
                 converter.soft_start.counter = 0;                       // Reset soft-start counter
                 converter.soft_start.phase   = SS_PWR_GOOD_DELAY; // switch to Power Good Delay mode
             }
+            else
+            {
+                converter.soft_start.reference = (uint16_t)(ramp >> 16);
+                converter.soft_start.fraction = (uint16_t)ramp;
+            }
             break; 
             
         /*!SS_PWR_GOOD_DELAY
          * POWER GOOD DELAY is just like POWER ON DELAY a state in which the soft-start counter
          * is counting call intervals until the user defined period has expired. Then the state 
-         * machine automatically switches to COMPLETE mode */     
+         * machine automatically switches to COMPLETE mode. The output is regulated at its 
+         * reference, light-load burst mode is therefore already permitted. */     
         case SS_PWR_GOOD_DELAY:
             
             converter.status.flags.op_status = STAT_START; // Set converter status to START-UP
             
-            if(converter.soft_start.counter++ > converter.soft_start.pwr_good_delay)
+            #if (USE_BURST_MODE == true)
+            pwr_burst_control(); // Enter/leave burst mode and gate PWM packets at light load
+            #endif
+            
+            if(++converter.soft_start.counter >= converter.soft_start.pwr_good_delay)
             {
                 converter.soft_start.counter = 0;                 // Reset soft-start counter
                 converter.soft_start.phase   = SS_COMPLETE; // switch to SOFT-START COMPLETE mode
@@ -186,23 +293,63 @@ volatile uint16_t exec_pwr_control(void) {
             
             converter.status.flags.op_status = STAT_ON; // Set converter status to ON mode
             c2p2z.ptrControlReference = &converter.data.v_ref; // hand reference control back
+            
+            #if (USE_BURST_MODE == true)
+            pwr_burst_control(); // Enter/leave burst mode and gate PWM packets at light load
+            #endif
+            #if (USE_FAULT_ENGINE == true)
+            fault_handler_monitor(); // Arm output under-voltage protection, reset restart back-off
+            #endif
             break;
 
-        /*!SS_FAULT or undefined state
-         * If any controller state is set, different from the previous ones (e.g. FAULT),
-         * the power controller sets the FAULT flag bit, enforces detection of the ADC activity 
-         * by clearing the adc_active bit and switches the state machine into STANDBY, from
-         * which the power controller may recover as soon as all startup conditions are met again. */
+        #if (USE_FAULT_ENGINE == true)
+        /*!SS_FAULT
+         * The PWM output has been turned off by the fault PCI and the controller is disabled. 
+         * Once the restart back-off has expired and the input and output voltage are within
+         * their release levels, the fault is released, the control loop histories are reset 
+         * and the state machine falls back into STANDBY, from which the converter restarts. */
+        case SS_FAULT:
+            
+            converter.status.flags.op_status = STAT_FAULT; // Set converter status to FAULT mode
+            
+            if (fault_handler_release()) {
+                c2p2z_Reset(&c2p2z);                        // Discard the histories of the shutdown
+                converter.status.flags.fault_active = false; // Clear FAULT flag bit
+                converter.soft_start.phase = SS_STANDBY;
+            }
+            break;
+        #endif
+
+        /*!Undefined state
+         * If any controller state is set, different from the previous ones, the power 
+         * controller sets the FAULT flag bit, enforces detection of the ADC activity by clearing
+         * the adc_active bit and switches the state machine into STANDBY, from which the power
+         * controller may recover as soon as all startup conditions are met again. With 
+         * USE_FAULT_ENGINE enabled, the PWM output is shut down by the fault PCI and the 
+         * restart is sequenced by SS_FAULT instead. */
         default: // If something is going wrong, reset PWR controller to STANDBY
 
+            #if (USE_EVENT_LOG == true)
+            event_log_write(EVT_STATE_ERROR, converter.soft_start.phase);
+            #endif
+            converter.status.flags.adc_active = false;     // Clear ADC_READY flag bit
+            
+            #if (USE_FAULT_ENGINE == true)
+            fault_handler_trip(FAULT_SRC_STATE);           // Turn off the PWM output
+            pwr_fault_shutdown();                          // Set FAULT flag bit and switch to SS_FAULT
+            #else
             converter.status.flags.op_status = STAT_FAULT; // Set converter status to FAULT mode
             converter.status.flags.fault_active = true;    // Set FAULT flag bit
-            converter.status.flags.adc_active = false;     // Clear ADC_READY flag bit
 
             converter.soft_start.phase = SS_STANDBY;
+            #endif
             break;
             
     }
+    
+    #if (USE_EVENT_LOG == true)
+    event_log_monitor(); // Log phase transitions and status changes of this tick
+    #endif
         
     /*!Power Converter Auto-Start Function
      * When the control bit converter.status.flags.auto_start is set, the status bits 'enabled' 
@@ -220,26 +367,297 @@ volatile uint16_t exec_pwr_control(void) {
     return(1);
 }
 
-/*!Power Converter Auto-Start Function
- * **************************************************************************************************
+#if (USE_FAULT_ENGINE == true)
+
+/*!pwr_fault_shutdown
+ * *************************************************************************************************
+ * Summary:
+ * Takes the power controller down after a hardware fault shutdown
  * 
- * **************************************************************************************************/
+ * Description:
+ * Called by the state machine at the first scheduler tick after the fault PCI has turned off 
+ * the PWM output (see fault_handler.h). The PWM output override and the disabled control loop
+ * keep the converter off once the fault PCI has been released. The restart is sequenced by 
+ * SS_FAULT.
+ * *************************************************************************************************/
+
+static void pwr_fault_shutdown(void) {
+
+    PG1IOCONLbits.OVRENH = 1;                       // Disable PWMxH output
+    c2p2z.status.bits.enable = 0;                   // Disable the control loop
+    c2p2z.ptrControlReference = &converter.data.v_ref; // Hand reference control back
+    converter.status.flags.pwm_active = false;      // Clear PWM_ACTIVE flag bit
+    #if (USE_BURST_MODE == true)
+    pwr_burst_reset();                              // Leave burst mode
+    #endif
+    
+    converter.status.flags.op_status = STAT_FAULT;  // Set converter status to FAULT mode
+    converter.status.flags.fault_active = true;     // Set FAULT flag bit
+    converter.soft_start.counter = 0;
+    converter.soft_start.phase = SS_FAULT;
+    
+    return;
+}
+
+#endif
+
+#if (USE_PREBIAS_STARTUP == true)
+
+/*!pwr_prebias_launch
+ * *************************************************************************************************
+ * Summary:
+ * Sets the start of the soft-start ramp and the compensator histories from the output voltage
+ * 
+ * Description:
+ * Called at the end of the power-on delay while PWM output and control loop are still off. 
+ * When the output is pre-biased, the soft-start reference starts at the measured output 
+ * voltage (at most converter.data.v_ref) and the compensator histories are pre-charged with
+ * the estimated steady-state output PREBIAS_DAC x v_out / v_ref (see globals.h), so the 
+ * control loop neither discharges the output nor has to build up its output from the minimum.
+ * Otherwise, and when the reference itself is below the pre-bias detection level, the ramp 
+ * starts at zero.
+ * *************************************************************************************************/
+
+static void pwr_prebias_launch(void) {
+
+    uint16_t v_out = converter.data.v_out;
+    uint16_t v_ref = converter.data.v_ref;
+    uint16_t estimate;
+    
+    // No pre-bias, or a reference too low to scale the estimate (v_ref = 0 with the 
+    // potentiometer at V_REF_MINIMUM would divide by zero)
+    if ((v_out < PREBIAS_VOUT_MIN) || (v_ref < PREBIAS_VOUT_MIN) || (v_ref == 0)) {
+        converter.soft_start.reference = 0;  // Reset soft-start reference to minimum
+        return;
+    }
+    
+    if (v_out > v_ref) v_out = v_ref;
+    
+    estimate = __builtin_divud(__builtin_muluu(PREBIAS_DAC, v_out), v_ref);
+    if (estimate > c2p2z.MaxOutput) estimate = c2p2z.MaxOutput;
+    else if (estimate < c2p2z.MinOutput) estimate = c2p2z.MinOutput;
+    
+    c2p2z_Precharge(&c2p2z, 0, estimate);    // Steady-state output at the pre-biased voltage
+    converter.soft_start.reference = v_out;  // Start the ramp at the pre-biased output voltage
+    
+    return;
+}
+
+#endif
+
+#if (USE_BURST_MODE == true)
+
+/*!pwr_burst_reset
+ * *************************************************************************************************
+ * Summary:
+ * Resets the burst mode status without changing PWM output and control loop
+ * *************************************************************************************************/
+
+static void pwr_burst_reset(void) {
+
+    converter.burst.active = false;
+    converter.burst.packet = false;
+    converter.burst.counter = 0;
+
+    return;
+}
+
+/*!pwr_burst_control
+ * *************************************************************************************************
+ * Summary:
+ * Light-load burst mode of the power controller
+ * 
+ * Description:
+ * Called by the state machine every scheduler tick in normal operation (SS_COMPLETE). 
+ * In continuous operation, the ticks with the compensator output clamped at MinOutput (LSAT) 
+ * are counted. After BURST_ENTRY_DELAY consecutive ticks, the control loop is disabled, the 
+ * peak current reference is set to BURST_DAC and the PWM output is gated by the output voltage:
+ * a packet starts BURST_VOUT_LOW below the reference and ends BURST_VOUT_HIGH above it.
+ * 
+ * Continuous operation is resumed when the output voltage drops BURST_VOUT_EXIT below the 
+ * reference or a packet lasts for more than BURST_PACKET_MAX ticks. The compensator histories
+ * are pre-charged with BURST_DAC to hand the peak current reference back to the control loop
+ * without a step.
+ * 
+ * The compensator is disabled before the DAC register is written, as the voltage loop 
+ * interrupt leaves DAC_VREF_REGISTER untouched while the controller is disabled.
+ * *************************************************************************************************/
+
+static void pwr_burst_control(void) {
+
+    uint16_t v_out = converter.data.v_out;
+    uint16_t v_ref = converter.data.v_ref;
+    
+    // Continuous operation: qualify burst mode entry
+    if (!converter.burst.active) {
+        
+        if (c2p2z.status.bits.flt_clamp_min) {
+            if (++converter.burst.counter >= BURST_ENTRY_DELAY) {
+                c2p2z.status.bits.enable = 0;       // Freeze the control loop
+                DAC_VREF_REGISTER = BURST_DAC;      // Fixed peak current reference of burst packets
+                PG1IOCONLbits.OVRENH = 1;           // Stop switching at the next start of cycle
+                converter.burst.active = true;
+                converter.burst.packet = false;
+                converter.burst.counter = 0;
+            }
+        }
+        else {
+            converter.burst.counter = 0;
+        }
+        
+        return;
+    }
+    
+    // Burst mode: resume continuous operation when the load exceeds the burst capability
+    if (((v_out + BURST_VOUT_EXIT) < v_ref) || 
+        ((converter.burst.packet) && (converter.burst.counter >= BURST_PACKET_MAX)))
+    {
+        #if (USE_LINE_FEEDFORWARD == true)
+        c2p2z_Precharge(&c2p2z, 0, line_feedforward_revert(BURST_DAC)); // Bumpless hand-over of the peak current reference
+        #else
+        c2p2z_Precharge(&c2p2z, 0, BURST_DAC);  // Bumpless hand-over of the peak current reference
+        #endif
+        c2p2z.status.bits.flt_clamp_min = 0;
+        c2p2z.status.bits.enable = 1;           // Start the control loop 
+        PG1IOCONLbits.OVRENH = 0;               // Switch continuously
+        converter.burst.exits++;
+        pwr_burst_reset();
+        return;
+    }
+    
+    // Burst mode: gate PWM packets within the ripple limits
+    converter.burst.counter++;
+    
+    if (converter.burst.packet) {
+        if (v_out > (v_ref + BURST_VOUT_HIGH)) {
+            PG1IOCONLbits.OVRENH = 1;           // End of packet
+            converter.burst.packet = false;
+            converter.burst.counter = 0;
+        }
+    }
+    else if ((v_out + BURST_VOUT_LOW) < v_ref) {
+        PG1IOCONLbits.OVRENH = 0;               // Start of packet
+        converter.burst.packet = true;
+        converter.burst.counter = 0;
+        converter.burst.packets++;
+    }
+
+    return;
+}
+
+#endif
+
+/*!_VOUT_ADCInterrupt
+ * *************************************************************************************************
+ * Summary:
+ * Voltage loop interrupt service routine
+ * 
+ * Description:
+ * This interrupt is triggered by the conversion of the output voltage sample. With 
+ * USE_CLOSED_LOOP_CONTROL enabled, the compensator is called first: c2p2z_Update() reads the
+ * sample from REG_VOUT_ADCBUF and writes the new peak current reference into DAC_VREF_REGISTER
+ * through the pointers ptrSource/ptrTarget of the controller object without intermediate copies.
+ * With USE_LINE_FEEDFORWARD enabled, the compensator output is written into 
+ * line_feedforward.ctrl_out instead and multiplied by the feed-forward gain before it is 
+ * written into DAC_VREF_REGISTER (see task_line_feedforward.h). Monitoring values are copied by
+ * exec_pwr_control() every scheduler tick. With USE_ADAPTIVE_SLOPE enabled, a pending slope 
+ * compensation rate is written into SLP1DAT after the DAC update (see task_slope_control.h).
+ * With USE_DATA_RECORDER enabled, the signals of the switching cycle are recorded after the DAC
+ * update (see data_recorder.h), the execution time is recorded in profiler channel PROF_RECORDER.
+ * With USE_EVENT_LOG enabled, saturation episodes of the compensator are logged (see event_log.h).
+ * 
+ * The time from entry of this routine to the DAC update is recorded in profiler 
+ * channel PROF_VOUT_LATENCY in instruction cycles. The ADC-to-DAC latency is this value plus 
+ * the interrupt entry latency and the context switch of the routine prologue.
+ * 
+ * When USE_ALT_WREG_ISR is enabled, this routine is replaced by the alternate working register
+ * set variant in vout_isr_asm.s, which completes through vout_isr_complete().
+ * *************************************************************************************************/
+
+#if (USE_ALT_WREG_ISR == false)
 
 void __attribute__((__interrupt__, auto_psv, context))_VOUT_ADCInterrupt(void)
 {
-    DGBPIN_2_SET;
+    PROFILER_ENTER(PROF_VOUT_ISR);
+    
+    #if (USE_CLOSED_LOOP_CONTROL == true)
+    
+    npnz16b_CommitCoefficients(&c2p2z); // Activate pending coefficient bank at sample boundary
+    c2p2z_Update(&c2p2z);   // Read ADC buffer, compute and write DAC register
+    
+    #if (USE_LINE_FEEDFORWARD == true)
+    if (c2p2z.status.bits.enable)
+        DAC_VREF_REGISTER = line_feedforward_apply(line_feedforward.ctrl_out); // Apply input voltage feed-forward
+    #endif
+    
+    PROFILER_SPLIT(PROF_VOUT_ISR, PROF_VOUT_LATENCY);
+    
+    #else
+    
+    DAC_VREF_REGISTER = converter.data.v_ref;  // Open loop: copy external reference into DAC
+    
+    #endif
+    
+    #if (USE_DATA_RECORDER == true)
+    PROFILER_ENTER(PROF_RECORDER);
+    data_recorder_capture();    // Record the voltage loop signals of this switching cycle
+    PROFILER_EXIT(PROF_RECORDER);
+    #endif
+    
+    #if (USE_EVENT_LOG == true)
+    event_log_saturation();     // Log begin and end of compensator saturation
+    #endif
+    
+    #if (USE_ADAPTIVE_SLOPE == true)
+    slope_control_commit(); // Apply pending slope compensation rate once per switching cycle
+    #endif
     
     converter.status.flags.adc_active = true;
-    converter.data.v_in = REG_VIN_ADCBUF;
-    converter.data.v_out = REG_VOUT_ADCBUF;
-
-    // here the control loop would be called
-    //    c2p2z_Update(&c2p2z); // Control loop has been disabled
-    DAC1DATH = converter.data.v_ref;  // Copy averaged value into reference value
-
     _ADCAN16IF = 0;  // Clear the ADCANx interrupt flag 
 
-    DGBPIN_2_CLEAR;
+    PROFILER_EXIT(PROF_VOUT_ISR);
     
 }
+#endif
 
+/*!vout_isr_complete
+ * *************************************************************************************************
+ * Summary:
+ * Completes the alternate working register set variant of _VOUT_ADCInterrupt
+ * 
+ * Description:
+ * Called by the assembly routine in vout_isr_asm.s after the DAC has been updated. Records the
+ * signals of the data recorder, logs compensator saturation episodes, applies a pending slope
+ * compensation rate, sets the ADC activity flag and records the time stamps captured by the 
+ * assembly routine in profiler channels PROF_VOUT_LATENCY and PROF_VOUT_ISR.
+ * 
+ * The assembly routine saves DSRPAG and RCOUNT of the interrupted context and loads DSRPAG with
+ * the page of the const section before the call, so this function runs under the same 
+ * conditions as the completion part of the C-ISR (auto_psv).
+ * *************************************************************************************************/
+
+volatile uint16_t vout_isr_complete(uint16_t t_entry, uint16_t t_dac) {
+
+    #if (USE_DATA_RECORDER == true)
+    PROFILER_ENTER(PROF_RECORDER);
+    data_recorder_capture();    // Record the voltage loop signals of this switching cycle
+    PROFILER_EXIT(PROF_RECORDER);
+    #endif
+    
+    #if (USE_EVENT_LOG == true)
+    event_log_saturation();     // Log begin and end of compensator saturation
+    #endif
+    
+    #if (USE_ADAPTIVE_SLOPE == true)
+    slope_control_commit(); // Apply pending slope compensation rate once per switching cycle
+    #endif
+    
+    converter.status.flags.adc_active = true;
+
+    #if (USE_PROFILER == true)
+    profiler_record(&profiler[PROF_VOUT_LATENCY], (uint16_t)(t_dac - t_entry));
+    profiler_record(&profiler[PROF_VOUT_ISR], (uint16_t)(PROFILER_TIMER - t_entry));
+    #endif
+    
+    return(1);
+}
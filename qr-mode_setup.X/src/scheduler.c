@@ -0,0 +1,202 @@
+/*
+ * File:   scheduler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 5:20 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "scheduler.h"
+
+#define SCHEDULER_TICK_CYCLES   ((uint32_t)MAIN_EXEC_PER + 1UL)   // scheduler tick period in [cycles]
+
+volatile SCHEDULER_t scheduler; // scheduler status and statistics
+
+/*!scheduler_time
+ * *************************************************************************************************
+ * Summary:
+ * Returns the number of instruction cycles passed since the scheduler has been started
+ * 
+ * Description:
+ * The time is composed of the number of scheduler ticks and the recent Timer1 counter value
+ * (see scheduler_timestamp()).
+ * *************************************************************************************************/
+
+static inline uint32_t scheduler_time(void)
+{
+    uint32_t ticks;
+    uint16_t timer;
+    
+    ticks = scheduler_timestamp(&timer);
+    
+    return((ticks * SCHEDULER_TICK_CYCLES) + timer);
+}
+
+/* Limits a cycle count to the 16-bit range of the statistics */
+static inline uint16_t scheduler_cycles(uint32_t cycles)
+{
+    return((cycles > 0xFFFF) ? 0xFFFF : (uint16_t)cycles);
+}
+
+/*!scheduler_reset_statistics
+ * *************************************************************************************************
+ * Summary:
+ * Clears timing statistics of the scheduler and all tasks
+ * *************************************************************************************************/
+
+volatile uint16_t scheduler_reset_statistics(void) {
+
+    volatile uint16_t i=0;
+    
+    for (i=0; i<scheduler.task_count; i++) {
+        scheduler.tasks[i].calls = 0;
+        scheduler.tasks[i].overruns = 0;
+        scheduler.tasks[i].latency_min = 0xFFFF;
+        scheduler.tasks[i].latency_max = 0;
+        scheduler.tasks[i].wcet = 0;
+    }
+    
+    scheduler.missed_ticks = 0;
+    scheduler.busy_max = 0;
+    
+    return(1);
+}
+
+/*!scheduler_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the task table and starts the scheduler tick
+ * 
+ * Description:
+ * The task table is sorted by task priority (tasks of equal priority keep their order) and
+ * the task counters are preset by the task offsets. Timer1 needs to be configured by 
+ * init_timer1() before the scheduler is initialized.
+ * *************************************************************************************************/
+
+volatile uint16_t scheduler_init(volatile SCHEDULER_TASK_t* tasks, uint16_t task_count) {
+
+    volatile uint16_t i=0, j=0;
+    SCHEDULER_TASK_t task;
+    
+    scheduler.tasks = tasks;
+    scheduler.task_count = task_count;
+    scheduler.pending = 0;
+    scheduler.ticks = 0;
+    
+    // Sort task table by priority (insertion sort)
+    for (i=1; i<task_count; i++) {
+        task = tasks[i];
+        j = i;
+        while ((j > 0) && (tasks[j-1].priority > task.priority)) {
+            tasks[j] = tasks[j-1];
+            j--;
+        }
+        tasks[j] = task;
+    }
+    
+    // Preset task counters: a task is called first at tick 'offset'
+    for (i=0; i<task_count; i++) {
+        if (tasks[i].period == 0) tasks[i].period = 1;
+        tasks[i].offset %= tasks[i].period;
+        tasks[i].counter = (tasks[i].period - 1 - tasks[i].offset);
+    }
+    
+    scheduler_reset_statistics();
+    
+    // Enable scheduler tick interrupt and start Timer1
+    _T1IP = SCHEDULER_ISR_PRIORITY;  // Set interrupt priority
+    _T1IF = 0;  // Reset interrupt flag bit
+    _T1IE = 1;  // Enable Timer1 interrupt
+    T1CONbits.TON = 1; // Start Timer1
+    
+    return(1);
+}
+
+/*!scheduler_run
+ * *************************************************************************************************
+ * Summary:
+ * Puts the CPU into Idle mode until the next scheduler tick and executes all tasks due
+ * 
+ * Description:
+ * This function is called continuously by the main loop. The CPU IPL is raised to the tick 
+ * interrupt priority before the pending tick counter is checked, so the tick cannot slip in 
+ * between the check and the Idle instruction. An enabled interrupt source wakes the CPU even 
+ * when its priority is masked. Once the IPL is restored, the tick interrupt is serviced. 
+ * Wake-ups by other interrupt sources return without executing any task.
+ * *************************************************************************************************/
+
+volatile uint16_t scheduler_run(void) {
+
+    volatile SCHEDULER_TASK_t* task;
+    uint16_t ipl, ticks, i;
+    uint32_t tick_time, t0, t1;
+    
+    // Sleep until the next interrupt, if no tick is pending
+    SET_AND_SAVE_CPU_IPL(ipl, SCHEDULER_ISR_PRIORITY);
+    if (scheduler.pending == 0)
+        Idle();
+    RESTORE_CPU_IPL(ipl);
+    
+    // Capture and clear pending ticks
+    SET_AND_SAVE_CPU_IPL(ipl, SCHEDULER_ISR_PRIORITY);
+    ticks = scheduler.pending;
+    scheduler.pending = 0;
+    tick_time = (scheduler.ticks * SCHEDULER_TICK_CYCLES);
+    RESTORE_CPU_IPL(ipl);
+    
+    if (ticks == 0)
+        return(1);  // wake-up by other interrupt source
+    
+    if (ticks > 1)
+        scheduler.missed_ticks += (ticks - 1);
+    
+    // Execute all tasks due in order of priority
+    for (i=0; i<scheduler.task_count; i++) {
+        
+        task = &scheduler.tasks[i];
+        
+        task->counter += ticks;
+        if (task->counter < task->period)
+            continue;
+        
+        task->counter -= task->period;
+        if (task->counter >= task->period) // calls have been missed; realign with task period
+            task->counter %= task->period;
+        
+        t0 = scheduler_time();
+        task->function();
+        t1 = scheduler_time();
+        
+        // Update task timing statistics
+        if ((t0 - tick_time) < task->latency_min) task->latency_min = scheduler_cycles(t0 - tick_time);
+        if ((t0 - tick_time) > task->latency_max) task->latency_max = scheduler_cycles(t0 - tick_time);
+        if ((t1 - t0) > task->wcet) task->wcet = scheduler_cycles(t1 - t0);
+        if ((t1 - tick_time) >= SCHEDULER_TICK_CYCLES) task->overruns++;
+        task->calls++;
+    }
+    
+    t1 = scheduler_time();
+    if ((t1 - tick_time) > scheduler.busy_max)
+        scheduler.busy_max = scheduler_cycles(t1 - tick_time);
+    
+    return(1);
+}
+
+/*!_T1Interrupt
+ * *************************************************************************************************
+ * Summary:
+ * Scheduler tick interrupt service routine
+ * *************************************************************************************************/
+
+void __attribute__((__interrupt__, auto_psv)) _T1Interrupt(void)
+{
+    scheduler.ticks++;
+    scheduler.pending++;
+    
+    _T1IF = 0;  // Clear the Timer1 interrupt flag 
+}
@@ -12,54 +12,162 @@
 
 #include "globals.h"
 #include "task_external_reference.h"
+#include "profiler.h"
 
-volatile uint32_t vref_avg=0;   // local buffer variable of the oversampling filter of the external reference voltage signal
-volatile uint16_t avg_cnt = 0;  // local buffer variable for the averaging filter counter steps
+#define EXT_REF_MA_LENGTH   (1 << EXT_REF_MA_LENGTH_LOG2)    // moving average window length
+
+#if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
+#if (USE_ADC_HW_FILTERS == false)
+#error EXT_REF_FILTER_HARDWARE requires the ADC digital filters (USE_ADC_HW_FILTERS)
+#endif
+#elif (EXT_REF_FILTER == EXT_REF_FILTER_MOVING_AVERAGE)
+static volatile uint16_t vref_buffer[EXT_REF_MA_LENGTH]; // ring buffer of the most recent samples
+static volatile uint16_t vref_index = 0;   // ring buffer index of the oldest sample
+static volatile uint32_t vref_sum = 0;     // running sum of all samples in the ring buffer
+#elif (EXT_REF_FILTER == EXT_REF_FILTER_IIR)
+static volatile uint32_t vref_state = 0;   // IIR filter state (filter output x 2^EXT_REF_IIR_SHIFT)
+#else
+#error selected external reference filter EXT_REF_FILTER is not supported
+#endif
 
 volatile uint16_t ext_reference_init(void) {
 
     converter.data.v_ref = 0;   // Reset power converter reference
+    
+    // Reset reference filter
+    #if (EXT_REF_FILTER == EXT_REF_FILTER_MOVING_AVERAGE)
+    volatile uint16_t i=0;
+    
+    for (i=0; i<EXT_REF_MA_LENGTH; i++)
+        vref_buffer[i] = 0;
+    vref_index = 0;
+    vref_sum = 0;
+    #elif (EXT_REF_FILTER == EXT_REF_FILTER_IIR)
+    vref_state = 0;
+    #endif
+    
     init_pot_adc();             // Initialize ADC input and interrupt
+    
+    #if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
+    _ADCAN6IE = 0;              // Samples are averaged by the ADC digital filter (see ext_reference_exec())
+    #elif (USE_DMA_MONITORING == true)
+    _ADCAN6IE = 0;              // Samples are captured by DMA (see task_monitor.c)
+    #endif
  
     return(1);
 }
 
-/*! _ADCAN6Interrupt
+/*!ext_reference_update
  * *************************************************************************************************
  * Summary:
- * ADC input interrupt service routine
+ * Filters a block of external reference samples and publishes the reference
  * 
  * Description:
- * Here the external reference voltage signal is sampled. The conversion of this ADC input is 
- * triggered by the PWM module. 
- * The reference voltage signal is oversampled 256 times before updating the controller reference
- * in the 'sepic' data structure. This reference is set to set the output voltage of the SEPIC.
+ * The raw ADC samples of the external reference input are filtered by the filter selected by 
+ * EXT_REF_FILTER (see globals.h) before the filter output is scaled into the adjustable reference 
+ * range and published in converter.data.v_ref:
+ * 
+ *    - Hardware averaging publishes the most recent result of the ADC digital filter passed 
+ *      by ext_reference_exec().
+ *    - Moving average and IIR filter are updated with every sample and publish their output 
+ *      once per call. The output is scaled by a single 16x16-bit multiply per call.
  * 
+ * The function is called by the ADC interrupt service routine with a single sample or by the 
+ * monitoring task (see task_monitor.c) with all samples captured by DMA since its last call.
  * *************************************************************************************************/
 
-void __attribute__((__interrupt__, auto_psv, context)) _ADCAN6Interrupt(void)
-{
+volatile uint16_t ext_reference_update(volatile uint16_t* samples, uint16_t count) {
+
     volatile uint16_t samp=0;   // local buffer variable for the most recent ADC result
-    volatile uint32_t res=0;    // local buffer variable for the scaling range
 
-DGBPIN_3_SET;
+    if (count == 0) return(0);
     
-    samp = ADCBUF6; // read latest sample
-    samp <<= 3;     // normalize to Q15
-    res = (volatile uint32_t)samp * V_REF_DIFF; // Scale adjustable range by using Q15 number
-    res >>= 15;     // normalize back into 16-bit
+    #if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
     
-    vref_avg += (V_REF_MIN + (volatile uint16_t)res);   // Add most recent value to averaging buffer
+    samp = samples[count - 1];  // most recent filter result (already averaged by the ADC)
     
-    if(!(++avg_cnt & 0x00FF)) {     // After 256 samples, calculate average value
-        converter.data.v_ref = (vref_avg >> 8);  // Copy averaged value into reference value
-        vref_avg = 0;                       // Reset averaging buffer
+    #else
+    
+    while (count--) {
+        samp = *samples++;  // read next sample
+        #if (EXT_REF_FILTER == EXT_REF_FILTER_MOVING_AVERAGE)
+        vref_sum += samp;                       // Add most recent sample to running sum
+        vref_sum -= vref_buffer[vref_index];    // Remove oldest sample from running sum
+        vref_buffer[vref_index] = samp;         // Replace oldest sample by most recent sample
+        vref_index = ((vref_index + 1) & (EXT_REF_MA_LENGTH - 1));
+        #elif (EXT_REF_FILTER == EXT_REF_FILTER_IIR)
+        vref_state -= (vref_state >> EXT_REF_IIR_SHIFT);    // y += (x - y) / 2^N
+        vref_state += samp;                                 //   with state = y * 2^N
+        #endif
     }
     
-    _ADCAN6IF = 0;  // Clear the ADCANx interrupt flag 
+    #if (EXT_REF_FILTER == EXT_REF_FILTER_MOVING_AVERAGE)
+    samp = (uint16_t)(vref_sum >> EXT_REF_MA_LENGTH_LOG2); // filter output
+    #elif (EXT_REF_FILTER == EXT_REF_FILTER_IIR)
+    samp = (uint16_t)(vref_state >> EXT_REF_IIR_SHIFT); // filter output
+    #endif
+    
+    #endif
+    
+    samp <<= 3;     // normalize to Q15
+    converter.data.v_ref = (V_REF_MIN + (volatile uint16_t)(__builtin_muluu(samp, V_REF_DIFF) >> 15)); // Scale into adjustable range
+    
+    return(1);
+}
+
+/*!ext_reference_exec
+ * *************************************************************************************************
+ * Summary:
+ * Publishes the external reference averaged by the ADC digital filter
+ * 
+ * Description:
+ * When EXT_REF_FILTER_HARDWARE is selected, the samples of the external reference input are 
+ * averaged by the ADC digital filter VREF_ADC_FILTER. This task is called by the scheduler and 
+ * passes the most recent filter result to ext_reference_update(), which scales and publishes it.
+ * No interrupt service routine or DMA transfer is executed per sample.
+ * *************************************************************************************************/
+
+#if (EXT_REF_FILTER == EXT_REF_FILTER_HARDWARE)
+
+volatile uint16_t ext_reference_exec(void) {
+    
+    return(ext_reference_update(&REG_VREF_ADFLDAT, 1));
     
-DGBPIN_3_CLEAR;
+}
+
+#endif
+
+/*! _ADCAN6Interrupt
+ * *************************************************************************************************
+ * Summary:
+ * ADC input interrupt service routine
+ * 
+ * Description:
+ * Here the external reference voltage signal is sampled. The conversion of this ADC input is 
+ * triggered by the PWM module. Every sample is passed to ext_reference_update().
+ * 
+ * The routine runs in alternate working register set #1 (CTXT1 = IPL2, see config_bits.c), 
+ * hence no working registers are saved. It does not access constants in program memory, 
+ * which allows to skip the save/restore of DSRPAG (no_auto_psv).
+ * 
+ * When USE_DMA_MONITORING is enabled, the samples are captured by DMA and filtered in blocks 
+ * by the monitoring task instead. When EXT_REF_FILTER_HARDWARE is selected, the samples are 
+ * averaged by the ADC (see ext_reference_exec()). In both cases the interrupt is disabled and 
+ * this routine is not built.
+ * *************************************************************************************************/
 
+#if ((USE_DMA_MONITORING == false) && (EXT_REF_FILTER != EXT_REF_FILTER_HARDWARE))
+
+void __attribute__((__interrupt__, no_auto_psv, context)) _ADCAN6Interrupt(void)
+{
+    PROFILER_ENTER(PROF_VREF_ISR);
+    
+    ext_reference_update(&REG_VREF_ADCBUF, 1); // filter and publish latest sample
+    
+    _ADCAN6IF = 0;  // Clear the ADCANx interrupt flag 
+    
+    PROFILER_EXIT(PROF_VREF_ISR);
 
 }
 
+#endif
@@ -0,0 +1,150 @@
+/*
+ * File:   task_gain_scheduler.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 3:30 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "task_gain_scheduler.h"
+
+/* ***************************************************************************************
+ * Gain Schedule:
+ * ***************************************************************************************
+ * 2P2Z coefficient sets of the voltage loop compensator c2p2z, designed at the operating
+ * points given by GS_VIN_POINTS input voltage levels (first index, equally spaced from
+ * GS_VIN_MINIMUM to GS_VIN_MAXIMUM) and GS_LOAD_POINTS load levels (second index, equally 
+ * spaced from GS_LOAD_MINIMUM to GS_LOAD_MAXIMUM).
+ * 
+ * All coefficient sets need to be derived with the input gain, scaling mode and scalers 
+ * of c2p2z.c (pre_scaler, post_shift_A/B and post_scaler), which are not scheduled.
+ * 
+ * Please note:
+ * Until operating point specific designs are available, all table entries hold the default 
+ * coefficients of c2p2z.c (350 kHz design) and the scheduled loop behaves like the fixed one.
+ * USE_GAIN_SCHEDULING is therefore disabled in globals.h.
+ * With GS_TABLE_EXTERNAL = true these tables are omitted and have to be provided by another
+ * source file (e.g. the distinct designs of the host test bench_gain_scheduler).
+ * ***************************************************************************************/
+
+#if (GS_TABLE_EXTERNAL == false)
+
+	const fractional gs_ACoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][2] = 
+	{
+		{ { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 } },	//  9.0 V: light, medium, full load
+		{ { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 } },	// 13.5 V: light, medium, full load
+		{ { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 }, { 0x4629, 0xEFD1 } }	// 18.0 V: light, medium, full load
+	};
+
+	const fractional gs_BCoefficients[GS_VIN_POINTS][GS_LOAD_POINTS][3] = 
+	{
+		{ { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 } },	//  9.0 V: light, medium, full load
+		{ { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 } },	// 13.5 V: light, medium, full load
+		{ { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 }, { 0x7FFF, 0x00B0, 0x80B1 } }	// 18.0 V: light, medium, full load
+	};
+
+#endif
+
+/* ***************************************************************************************/
+
+volatile GAIN_SCHEDULER_t gain_scheduler;
+
+/*!gain_scheduler_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the gain scheduler data structure
+ * 
+ * Description:
+ * The operating point filters are preset to the lower table borders and will settle within
+ * a few scheduler calls once the converter is running.
+ * *************************************************************************************************/
+
+volatile uint16_t gain_scheduler_init(void) {
+
+    gain_scheduler.counter = 0;
+    gain_scheduler.vin = GS_VIN_MIN;
+    gain_scheduler.load = GS_LOAD_MIN;
+    gain_scheduler.vin_filter = ((uint32_t)GS_VIN_MIN << GS_FILTER_SHIFT);
+    gain_scheduler.load_filter = ((uint32_t)GS_LOAD_MIN << GS_FILTER_SHIFT);
+    gain_scheduler.swaps = 0;
+    
+    return(1);
+}
+
+/*!gain_scheduler_exec
+ * *************************************************************************************************
+ * Summary:
+ * Adapts the coefficients of the voltage loop compensator to the recent operating point
+ * 
+ * Description:
+ * This task is called by the main loop every MAIN_EXECUTION_PERIOD. Input voltage (AN12) and 
+ * compensator output (target of c2p2z) are low-pass filtered on every call. With 
+ * USE_LINE_FEEDFORWARD enabled, the compensator output is read before the feed-forward gain 
+ * is applied, so the load axis of the table does not shift with the input voltage. Every GS_EXEC_INTERVAL calls, a new coefficient set is interpolated from the 
+ * four table entries surrounding the operating point and written into the inactive coefficient 
+ * bank of c2p2z. The bank is only published when the coefficients differ from the active set. 
+ * The control loop interrupt service routine activates it at the next sample boundary, so no 
+ * additional cycles are spent in the fast loop.
+ * 
+ * If a previously published bank has not been activated yet (e.g. while the control loop is 
+ * disabled), the update is postponed to the next interval.
+ * *************************************************************************************************/
+
+volatile uint16_t gain_scheduler_exec(void) {
+
+    volatile c2p2z_CONTROL_LOOP_COEFFICIENTS_t* bank;
+    uint16_t i_vin, i_load, f_vin, f_load, i;
+    bool changed = false;
+    
+    // Skip while the controller has not been initialized
+    if (converter.status.flags.op_status == STAT_OFF)
+        return(1);
+    
+    // Low-pass filter operating point
+    gain_scheduler.vin_filter += ((uint32_t)REG_VIN_ADCBUF - gain_scheduler.vin);
+    gain_scheduler.vin = (uint16_t)(gain_scheduler.vin_filter >> GS_FILTER_SHIFT);
+    gain_scheduler.load_filter += ((uint32_t)*c2p2z.ptrTarget - gain_scheduler.load);
+    gain_scheduler.load = (uint16_t)(gain_scheduler.load_filter >> GS_FILTER_SHIFT);
+    
+    if (gain_scheduler.counter++ < GS_EXEC_INTERVAL)
+        return(1);
+    
+    bank = c2p2z_GetCoefficientBank();
+    if (bank == NULL)
+        return(1); // previous coefficient set is still pending, try again next call
+    
+    gain_scheduler.counter = 0;
+    
+    // Locate operating point in the coefficient table
+    i_vin = gs_table_position(gain_scheduler.vin, GS_VIN_MIN, GS_VIN_MAX, GS_VIN_POINTS, &f_vin);
+    i_load = gs_table_position(gain_scheduler.load, GS_LOAD_MIN, GS_LOAD_MAX, GS_LOAD_POINTS, &f_load);
+    
+    // Interpolate coefficients into the inactive bank and compare them against the active set
+    for (i = 0; i < 2; i++) {
+        bank->ACoefficients[i] = gs_interpolate(
+            gs_ACoefficients[i_vin][i_load][i], gs_ACoefficients[i_vin][i_load + 1][i],
+            gs_ACoefficients[i_vin + 1][i_load][i], gs_ACoefficients[i_vin + 1][i_load + 1][i],
+            f_vin, f_load);
+        changed |= (bank->ACoefficients[i] != c2p2z.ptrACoefficients[i]);
+    }
+    for (i = 0; i < 3; i++) {
+        bank->BCoefficients[i] = gs_interpolate(
+            gs_BCoefficients[i_vin][i_load][i], gs_BCoefficients[i_vin][i_load + 1][i],
+            gs_BCoefficients[i_vin + 1][i_load][i], gs_BCoefficients[i_vin + 1][i_load + 1][i],
+            f_vin, f_load);
+        changed |= (bank->BCoefficients[i] != c2p2z.ptrBCoefficients[i]);
+    }
+    
+    // Publish new coefficient set to be activated at the next control loop sample
+    if (changed) {
+        c2p2z_SwapCoefficientBank(bank);
+        gain_scheduler.swaps++;
+    }
+    
+    return(1);
+}
@@ -0,0 +1,141 @@
+/*
+ * File:   task_line_feedforward.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 11:50 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "task_line_feedforward.h"
+
+volatile LINE_FEEDFORWARD_t line_feedforward;
+
+/*!line_ff_divide
+ * *************************************************************************************************
+ * Summary:
+ * Unsigned 32/16-bit division saturating at 0xFFFF
+ * *************************************************************************************************/
+
+static inline uint16_t line_ff_divide(uint32_t numerator, uint16_t denominator)
+{
+    if ((uint16_t)(numerator >> 16) >= denominator)
+        return(0xFFFF);
+
+    return(__builtin_divud(numerator, denominator));
+}
+
+/*!line_ff_sqrt
+ * *************************************************************************************************
+ * Summary:
+ * Integer square root of a 32-bit number (bit-by-bit, 16 iterations)
+ * *************************************************************************************************/
+
+static uint16_t line_ff_sqrt(uint32_t x)
+{
+    uint32_t bit = (1UL << 30), result = 0;
+
+    while (bit > x)
+        bit >>= 2;
+
+    while (bit != 0) {
+        if (x >= (result + bit)) {
+            x -= (result + bit);
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return((uint16_t)result);
+}
+
+/*!line_feedforward_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the input voltage feed-forward data structure
+ *
+ * Description:
+ * The feed-forward gain starts at unity. The clamping limits of the compensator are set by
+ * init_pwr_control() and scaled by line_feedforward_exec() as soon as the input voltage is
+ * available.
+ * *************************************************************************************************/
+
+volatile uint16_t line_feedforward_init(void) {
+
+    line_feedforward.gain = LINE_FF_GAIN_UNITY;
+    line_feedforward.ctrl_out = 0;
+    line_feedforward.period_gain = LINE_FF_GAIN_UNITY;
+    line_feedforward.slope_gain = LINE_FF_GAIN_UNITY;
+
+    return(1);
+}
+
+/*!line_feedforward_exec
+ * *************************************************************************************************
+ * Summary:
+ * Computes the feed-forward gain from input voltage, switching period and compensation ramp
+ *
+ * Description:
+ * This task is called by the main loop every MAIN_EXECUTION_PERIOD after the valley control
+ * and the slope compensation task have updated MPER and SLP1DAT. Both shares of the gain are
+ * calculated in Q12 format:
+ *
+ *    period_gain = sqrt((MPER << 24) / LINE_FF_PERIOD_REF)
+ *    slope_gain  = 4096 + SLP1DAT x LINE_FF_K_SLOPE / vin
+ *    gain        = (period_gain x slope_gain) >> 12
+ *
+ * The clamping limits of the compensator are set to DAC_MAX / gain and DAC_MIN / gain. When the
+ * gain increases, the limits are written before the gain, otherwise after it. As this task
+ * cannot interrupt the voltage loop, the DAC value never exceeds DAC_MAX.
+ * *************************************************************************************************/
+
+volatile uint16_t line_feedforward_exec(void) {
+
+    uint32_t product;
+    uint16_t vin, period, ratio, gain, max_output, min_output;
+
+    vin = converter.data.v_in;
+    period = MPER;
+
+    line_feedforward.period_gain = LINE_FF_GAIN_UNITY;
+    line_feedforward.slope_gain = LINE_FF_GAIN_UNITY;
+
+    if ((vin >= LINE_FF_VIN_MIN) && (period > 0)) {
+
+        // Switching period relative to the period of unity gain in Q14, square root in Q12
+        ratio = line_ff_divide(((uint32_t)period << 14), LINE_FF_PERIOD_REF);
+        line_feedforward.period_gain = line_ff_sqrt((uint32_t)ratio << 10);
+
+        // Peak current reduction by the compensation ramp at the end of the on-time
+        product = (uint32_t)LINE_FF_GAIN_UNITY +
+                  (uint32_t)line_ff_divide(__builtin_muluu(SLP1DAT, LINE_FF_K_SLOPE), vin);
+        line_feedforward.slope_gain = (product > 0xFFFF) ? 0xFFFF : (uint16_t)product;
+    }
+
+    product = (__builtin_muluu(line_feedforward.period_gain, line_feedforward.slope_gain) >> 12);
+    gain = (product > 0xFFFF) ? 0xFFFF : (uint16_t)product;
+
+    max_output = line_ff_divide(((uint32_t)DAC_MAX << 12), gain);
+    min_output = line_ff_divide(((uint32_t)DAC_MIN << 12), gain);
+
+    // Hand over to the voltage loop keeping the DAC value within [DAC_MIN, DAC_MAX]
+    if (gain > line_feedforward.gain) {
+        c2p2z.MaxOutput = max_output;
+        c2p2z.MinOutput = min_output;
+        line_feedforward.gain = gain;
+    }
+    else {
+        line_feedforward.gain = gain;
+        c2p2z.MaxOutput = max_output;
+        c2p2z.MinOutput = min_output;
+    }
+
+    return(1);
+}
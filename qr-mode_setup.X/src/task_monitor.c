@@ -0,0 +1,157 @@
+/*
+ * File:   task_monitor.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 8:20 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "task_monitor.h"
+
+volatile MONITOR_RING_t monitor_ring;
+volatile MONITOR_t monitor;
+
+/*!monitor_ring_head
+ * *************************************************************************************************
+ * Summary:
+ * Returns the ring index the DMA channel will write next
+ * 
+ * Description:
+ * The destination address register of a DMA channel points to the next element of the ring 
+ * buffer to be written. It is converted into a ring index relative to the start of the buffer.
+ * *************************************************************************************************/
+
+static inline uint16_t monitor_ring_head(uint16_t dma_destination, volatile uint16_t* buffer)
+{
+    return(((uint16_t)(dma_destination - (uint16_t)(uintptr_t)buffer) >> 1) & (MON_RING_LENGTH - 1));
+}
+
+/*!monitor_init
+ * *************************************************************************************************
+ * Summary:
+ * Sets up the DMA capture of the monitoring ADC channels
+ * 
+ * Description:
+ * Clears the ring buffers and starts DMA channel 0 (AN12 input voltage) and DMA channel 1 (AN6 
+ * external reference, unless averaged by the ADC digital filter). The ADC channels need to be 
+ * initialized before (see init_vin_adc() and ext_reference_init()).
+ * *************************************************************************************************/
+
+volatile uint16_t monitor_init(void) {
+
+    volatile uint16_t i=0;
+    
+    for (i=0; i<MON_RING_LENGTH; i++) {
+        monitor_ring.vin[i] = 0;
+        #if (MON_CAPTURE_VREF)
+        monitor_ring.vref[i] = 0;
+        #endif
+    }
+    
+    monitor.vin_tail = 0;
+    monitor.vref_tail = 0;
+    monitor.vin_min = 0;
+    monitor.vin_max = 0;
+    monitor.block = 0;
+    monitor.block_max = 0;
+    monitor.vin_stall = 0;
+    monitor.vref_stall = 0;
+    monitor.dma_fault = MON_DMA_FAULT_NONE;
+    
+    #if (MON_CAPTURE_VREF)
+    init_dma_module(&monitor_ring.vref[MON_RING_LENGTH - 1]); // Limit DMA access to SFRs and ring buffers
+    init_dma_vin(&monitor_ring.vin[0], MON_RING_LENGTH);     // Capture AN12 into input voltage ring
+    init_dma_vref(&monitor_ring.vref[0], MON_RING_LENGTH);   // Capture AN6 into external reference ring
+    #else
+    init_dma_module(&monitor_ring.vin[MON_RING_LENGTH - 1]); // Limit DMA access to SFRs and ring buffer
+    init_dma_vin(&monitor_ring.vin[0], MON_RING_LENGTH);     // Capture AN12 into input voltage ring
+    #endif
+    launch_dma();
+    
+    return(1);
+}
+
+/*!monitor_exec
+ * *************************************************************************************************
+ * Summary:
+ * Processes all monitoring samples captured since the previous call
+ * 
+ * Description:
+ * This task is executed every scheduler tick. The samples of each ring buffer between the 
+ * index of the previous call (tail) and the current DMA write position (head) are processed as 
+ * one block. External reference samples are passed to ext_reference_update() in up to two 
+ * contiguous segments (before and after the ring wrap-around).
+ * 
+ * The trigger source codes of the DMA channels (init_dma.h) have not been verified on the 
+ * device yet. If the write position of a channel does not advance for more than 
+ * MON_STALL_TICKS calls, the channel is flagged in monitor.dma_fault and the most recent 
+ * conversion result is read from the ADC buffer instead, until the channel advances again.
+ * *************************************************************************************************/
+
+volatile uint16_t monitor_exec(void) {
+
+    volatile uint16_t head=0, tail=0, count=0;
+    volatile uint16_t samp=0, vmin=0xFFFF, vmax=0;
+    volatile uint32_t sum=0;
+    
+    // Input voltage: block average and limits
+    head = monitor_ring_head(DMADST0, &monitor_ring.vin[0]);
+    tail = monitor.vin_tail;
+    count = ((head - tail) & (MON_RING_LENGTH - 1));
+    
+    while (tail != head) {
+        samp = monitor_ring.vin[tail];
+        sum += samp;
+        if (samp < vmin) vmin = samp;
+        if (samp > vmax) vmax = samp;
+        tail = ((tail + 1) & (MON_RING_LENGTH - 1));
+    }
+    monitor.vin_tail = head;
+    
+    if (count > 0) {
+        converter.data.v_in = __builtin_divud(sum, count); // Publish block average
+        monitor.vin_min = vmin;
+        monitor.vin_max = vmax;
+        monitor.block = count;
+        if (count > monitor.block_max) monitor.block_max = count;
+        monitor.vin_stall = 0;
+    }
+    else if (monitor.vin_stall < MON_STALL_TICKS) {
+        monitor.vin_stall++;
+    }
+    else { // DMA channel 0 is not triggered: read input voltage directly
+        monitor.dma_fault |= MON_DMA_FAULT_VIN;
+        converter.data.v_in = REG_VIN_ADCBUF;
+    }
+    
+    // External reference: filter block and publish reference
+    #if (MON_CAPTURE_VREF)
+    head = monitor_ring_head(DMADST1, &monitor_ring.vref[0]);
+    tail = monitor.vref_tail;
+    
+    if (head < tail) { // Ring wrapped around: process samples up to the end of the buffer first
+        ext_reference_update(&monitor_ring.vref[tail], (MON_RING_LENGTH - tail));
+        tail = 0;
+    }
+    ext_reference_update(&monitor_ring.vref[tail], (head - tail));
+    
+    if (head != monitor.vref_tail) {
+        monitor.vref_stall = 0;
+    }
+    else if (monitor.vref_stall < MON_STALL_TICKS) {
+        monitor.vref_stall++;
+    }
+    else { // DMA channel 1 is not triggered: pass the most recent conversion result
+        monitor.dma_fault |= MON_DMA_FAULT_VREF;
+        ext_reference_update(&REG_VREF_ADCBUF, 1);
+    }
+    monitor.vref_tail = head;
+    #endif
+    
+    return(1);
+}
@@ -0,0 +1,109 @@
+/*
+ * File:   task_slope_control.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 11:10 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "task_slope_control.h"
+#include "task_valley_control.h"
+
+volatile SLOPE_CONTROL_t slope_control;
+
+/*!slope_control_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the slope compensation data structure
+ *
+ * Description:
+ * The adaptive slope compensation starts enabled at the minimum rate. The first update is 
+ * handed over to the voltage loop as soon as the ADC is running.
+ * *************************************************************************************************/
+
+volatile uint16_t slope_control_init(void) {
+
+    slope_control.enabled = true;
+    slope_control.rate = SLOPE_RATE_MIN;
+    slope_control.pending = 0;
+    slope_control.updates = 0;
+
+    return(1);
+}
+
+/*!slope_control_exec
+ * *************************************************************************************************
+ * Summary:
+ * Computes the required slope compensation rate from input and output voltage
+ *
+ * Description:
+ * This task is called by the main loop every MAIN_EXECUTION_PERIOD. Down-slope and up-slope of 
+ * the sensed current are calculated from the averaged output and input voltage in [ADC ticks] 
+ * using the constants SLOPE_K_VOUT and SLOPE_K_VIN (see globals.h), which already include 
+ * SLOPE_MARGIN / 2 and are scaled by 2^16:
+ * 
+ *    ccm_rate = ((vout + SLOPE_VF) x SLOPE_K_VOUT - vin x SLOPE_K_VIN) >> 16
+ * 
+ * In discontinuous conduction mode every cycle starts at zero current and no compensation 
+ * ramp is required. The conduction time t_on + t_demag at the present peak current reference
+ * is therefore predicted by valley_predict() of the valley control (see task_valley_control.h)
+ * from the peak current reduced by the active ramp and related to the switching period. Below
+ * SLOPE_CCM_RATIO the minimum rate is applied, towards continuous conduction (ratio = 1) the 
+ * rate is blended linearly into ccm_rate. The result is clamped to [SLOPE_RATE_MIN, SLOPE_RATE_MAX]. A new value is 
+ * only published when it differs by more than SLOPE_HYST from the rate in SLP1DAT.
+ * *************************************************************************************************/
+
+volatile uint16_t slope_control_exec(void) {
+
+    int32_t m_diff;
+    uint32_t t_on, t_demag, t_cond;
+    uint16_t dac, vin, vout, rate, ratio, active;
+
+    dac = DAC_VREF_REGISTER;
+    vin = converter.data.v_in;
+    vout = converter.data.v_out + SLOPE_VF;
+    rate = SLOPE_RATE_MIN;
+    
+    if (!slope_control.enabled) {
+        rate = DAC_SLOPE_RATE;
+    }
+    else if ((vin > 0) && (MPER > 0)) {
+        
+        // Rate required in continuous conduction mode
+        m_diff = (int32_t)__builtin_muluu(vout, SLOPE_K_VOUT) - (int32_t)__builtin_muluu(vin, SLOPE_K_VIN);
+
+        if (m_diff >= ((int32_t)SLOPE_RATE_MAX << 16))
+            rate = SLOPE_RATE_MAX;
+        else if (m_diff > ((int32_t)SLOPE_RATE_MIN << 16))
+            rate = (uint16_t)(m_diff >> 16);
+
+        // Conduction time relative to the switching period in [1/256]
+        valley_predict(dac, vin, vout, &t_on, &t_demag);
+        t_cond = t_on + t_demag;
+        ratio = valley_divide((t_cond << 4), MPER);
+        
+        if (ratio <= SLOPE_CCM_LIMIT)
+            rate = SLOPE_RATE_MIN;
+        else if (ratio < 256)
+            rate = SLOPE_RATE_MIN + (uint16_t)__builtin_divud(
+                __builtin_muluu((rate - SLOPE_RATE_MIN), (ratio - SLOPE_CCM_LIMIT)), (256 - SLOPE_CCM_LIMIT));
+    }
+
+    slope_control.rate = rate;
+    
+    // Hand over to the voltage loop if the difference exceeds the hysteresis
+    active = SLP1DAT;
+    if ((rate > (active + SLOPE_HYST)) || ((rate + SLOPE_HYST) < active) || 
+        ((rate != active) && ((rate == SLOPE_RATE_MIN) || (!slope_control.enabled)))) 
+    {
+        if (slope_control.pending == 0) slope_control.updates++;
+        slope_control.pending = rate;
+    }
+
+    return(1);
+}
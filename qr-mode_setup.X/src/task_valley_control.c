@@ -0,0 +1,188 @@
+/*
+ * File:   task_valley_control.c
+ * Author: M91406
+ *
+ * Created on October 16, 2026, 9:40 PM
+ */
+
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "globals.h"
+#include "task_valley_control.h"
+
+volatile VALLEY_CONTROL_t valley_control;
+
+/*!valley_first
+ * *************************************************************************************************
+ * Summary:
+ * Returns the first valley with a switching period at or above the given limit
+ *
+ * Description:
+ * 'offset' is the period of the first valley in [PWM ticks << 4], 'limit' is given in [PWM ticks].
+ * *************************************************************************************************/
+
+static inline uint16_t valley_first(uint32_t offset, uint16_t limit)
+{
+    uint32_t target = ((uint32_t)limit << 4);
+
+    if (offset >= target)
+        return(1);
+
+    return(1 + valley_divide((target - offset + (VALLEY_T_RING - 1)), VALLEY_T_RING));
+}
+
+/*!valley_set_period
+ * *************************************************************************************************
+ * Summary:
+ * Writes a new switching period into the master period register
+ * *************************************************************************************************/
+
+static inline void valley_set_period(uint16_t period)
+{
+    valley_control.period = period;
+
+    if (MPER != period) {
+        MPER = period;
+        PG1STATbits.UPDREQ = 1; // Update PWM generators running from the master period
+        PG2STATbits.UPDREQ = 1;
+    }
+}
+
+/*!valley_control_init
+ * *************************************************************************************************
+ * Summary:
+ * Initializes the valley control data structure
+ *
+ * Description:
+ * The valley control starts inactive at the fixed switching frequency. The load filter is
+ * preset to full load and will settle within a few scheduler calls once the converter is running.
+ * *************************************************************************************************/
+
+volatile uint16_t valley_control_init(void) {
+
+    valley_control.active = false;
+    valley_control.valley = 0;
+    valley_control.period = PWM_PERIOD;
+    valley_control.limit = VALLEY_PERIOD_MIN;
+    valley_control.dwell = 0;
+    valley_control.t_on = 0;
+    valley_control.t_demag = 0;
+    valley_control.load = VALLEY_PWR_HIGH;
+    valley_control.load_filter = ((uint32_t)VALLEY_PWR_HIGH << VALLEY_FILTER_SHIFT);
+    valley_control.changes = 0;
+
+    return(1);
+}
+
+/*!valley_control_exec
+ * *************************************************************************************************
+ * Summary:
+ * Selects the turn-on valley and sets the switching period accordingly
+ *
+ * Description:
+ * This task is called by the main loop every MAIN_EXECUTION_PERIOD. On-time and demagnetization
+ * time are predicted from the recent peak current reference (DAC_VREF_REGISTER), the input
+ * voltage and the output voltage (see task_valley_control.h). The transferred power per cycle
+ * (dac^2 / period) is low-pass filtered and determines the minimum period permitted at the
+ * present load (VALLEY_PERIOD_MIN above VALLEY_PWR_HIGH, VALLEY_PERIOD_FOLDBACK below
+ * VALLEY_PWR_LOW, interpolated in between).
+ *
+ * The converter moves to a higher valley immediately when the period of the selected valley
+ * drops below this limit. It moves down by one valley when the period of the next lower valley
+ * has exceeded the limit by more than VALLEY_HYST for VALLEY_DWELL consecutive calls. The 
+ * resulting period is clamped to VALLEY_PERIOD_MAX.
+ * 
+ * At constant power the peak current scales with the square root of the switching period. The
+ * period of the next lower valley is therefore predicted with the conduction time reduced by
+ * (t_on + t_demag) x T_ring / (2 x period), the first order approximation of this change. 
+ * Without this correction, the shorter period of the lower valley would be followed by a lower
+ * peak current reference (immediately with USE_LINE_FEEDFORWARD) and may violate the limit, 
+ * moving the converter back and forth between two valleys.
+ *
+ * Outside regulated operation (ramp-up not complete) or at input/output voltages below
+ * VALLEY_VIN_MIN/VALLEY_VOUT_MIN, the fixed period PWM_PERIOD is restored.
+ * *************************************************************************************************/
+
+volatile uint16_t valley_control_exec(void) {
+
+    uint16_t dac, vin, vout, limit, k_up, k_down, t_cond;
+    uint32_t t_on, t_demag, offset, offset_down, period;
+
+    dac = DAC_VREF_REGISTER;
+    vin = converter.data.v_in;
+    vout = converter.data.v_out;
+
+    // Fixed frequency operation during startup, at low input or output voltage
+    if (((converter.soft_start.phase != SS_PWR_GOOD_DELAY) && (converter.soft_start.phase != SS_COMPLETE)) || 
+        (vin < VALLEY_VIN_MIN) || (vout < VALLEY_VOUT_MIN)) {
+        valley_control.active = false;
+        valley_control.valley = 0;
+        valley_control.dwell = 0;
+        valley_set_period(PWM_PERIOD);
+        return(1);
+    }
+
+    // On-time at the DAC threshold, corrected by the slope compensation ramp
+    dac = valley_predict(dac, vin, (vout + VALLEY_VF), &t_on, &t_demag);
+
+    valley_control.t_on = (uint16_t)(t_on >> 4);
+    valley_control.t_demag = (uint16_t)(t_demag >> 4);
+
+    // Low-pass filter transferred power (independent of the selected valley)
+    valley_control.load_filter += ((uint32_t)valley_divide(__builtin_muluu(dac, dac), MPER) - valley_control.load);
+    valley_control.load = (uint16_t)(valley_control.load_filter >> VALLEY_FILTER_SHIFT);
+
+    // Minimum period at the present load
+    if (valley_control.load >= VALLEY_PWR_HIGH)
+        limit = VALLEY_PERIOD_MIN;
+    else if (valley_control.load <= VALLEY_PWR_LOW)
+        limit = VALLEY_PERIOD_FOLDBACK;
+    else
+        limit = VALLEY_PERIOD_FOLDBACK - __builtin_divud(
+            __builtin_muluu((VALLEY_PERIOD_FOLDBACK - VALLEY_PERIOD_MIN), (valley_control.load - VALLEY_PWR_LOW)),
+            (VALLEY_PWR_HIGH - VALLEY_PWR_LOW));
+    valley_control.limit = limit;
+
+    // Valley selection with hysteresis
+    offset = t_on + t_demag + (VALLEY_T_RING >> 1);
+    offset = (offset > ((uint32_t)VALLEY_DELAY << 4)) ? (offset - ((uint32_t)VALLEY_DELAY << 4)) : 0;
+
+    k_up = valley_first(offset, limit);
+
+    // Conduction time of the next lower valley at constant power
+    offset_down = offset;
+    if (valley_control.valley > 1) {
+        period = offset + __builtin_muluu((valley_control.valley - 1), VALLEY_T_RING);
+        t_cond = ((t_on + t_demag) > 0xFFFF) ? 0xFFFF : (uint16_t)(t_on + t_demag);
+        t_cond = valley_divide((__builtin_muluu(t_cond, VALLEY_T_RING) >> 1), ((period > 0xFFFF) ? 0xFFFF : (uint16_t)period));
+        offset_down = (offset > t_cond) ? (offset - t_cond) : 0;
+    }
+    k_down = valley_first(offset_down, (limit + VALLEY_HYST));
+
+    if (valley_control.valley < k_up) {
+        valley_control.valley = k_up;
+        valley_control.dwell = 0;
+        valley_control.changes++;
+    }
+    else if (valley_control.valley > k_down) {
+        if (++valley_control.dwell >= VALLEY_DWELL) {
+            valley_control.valley--;
+            valley_control.dwell = 0;
+            valley_control.changes++;
+        }
+    }
+    else {
+        valley_control.dwell = 0;
+    }
+
+    period = ((offset + __builtin_muluu((valley_control.valley - 1), VALLEY_T_RING)) >> 4);
+    if (period > VALLEY_PERIOD_MAX) period = VALLEY_PERIOD_MAX;
+
+    valley_control.active = true;
+    valley_set_period((uint16_t)period);
+
+    return(1);
+}
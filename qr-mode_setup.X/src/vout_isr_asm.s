@@ -0,0 +1,139 @@
+;LICENSE / DISCLAIMER
+; **********************************************************************************
+;  Author:      M91406
+;  Date/Time:   10/16/26 7:30:00 PM
+; **********************************************************************************
+;  Voltage Loop Interrupt Service Routine (Alternate Working Register Set)
+; **********************************************************************************
+;
+;  Assembly variant of _VOUT_ADCInterrupt (pwr_control.c) used when USE_ALT_WREG_ISR
+;  is enabled in globals.h. Interrupt priority level 5 of the voltage loop ADC interrupt
+;  is assigned to alternate working register set #2 (CTXT2 = IPL5, see config_bits.c).
+;  The CPU switches W0...W14, the accumulators and the DSP status flags on interrupt
+;  entry and switches back on RETFIE. As no other code runs in this register set, the
+;  routine overwrites all working registers without saving them and executes the
+;  coefficient bank commit and the 2P2Z compensator (c2p2z) inline:
+;
+;    - no save/restore of DSRPAG and no stack frame before the DAC update
+;    - no call/return and no save/restore of w12 of _c2p2z_Update
+;    - no call/return of npnz16b_CommitCoefficients()
+;    - controller object address loaded once for commit and update
+;
+;  After the DAC update, the routine calls the C function vout_isr_complete() (pwr_control.c),
+;  which executes the same completion work as the C-ISR: data recorder, event log, slope 
+;  compensation update, ADC activity flag and profiler statistics. The C function may read
+;  const data through the PSV window, so DSRPAG is loaded with the page of the const section 
+;  before the call, as the auto_psv prologue of the C-ISR does. DSRPAG and RCOUNT (REPEAT 
+;  loops of the C function) of the interrupted context are saved on the stack around the call.
+;
+;  Instructions from interrupt entry to the DAC register write (2P2Z, enabled, no
+;  coefficient swap pending), counted from the instruction listings:
+;
+;                                          C-ISR + _c2p2z_Update    this file
+;    ISR prologue (DSRPAG, stack frame)             4                   0
+;    profiler time stamp                            2                   1
+;    coefficient commit incl. call/return         >= 6                  3
+;    call/return/push of _c2p2z_Update              4                   0
+;    controller object address                      2                   1
+;    compensator (NPNZ16B_UPDATE_CORE)             44                  44
+;    transient boost, error within band (**)     7-8                 7-8
+;    compensator epilogue (*)                     ~14                  10
+;    input voltage feed-forward (*)               ~ 8                   6
+;
+;  (*) the C-ISR with USE_LINE_FEEDFORWARD enabled and this file write the DAC register
+;      after the compensator has completed (ADC trigger, histories and status flags)
+;  (**) only assembled with USE_TRANSIENT_BOOST (see npnz16b.inc)
+;
+;  Instructions after the DAC register write, excluding the completion work itself:
+;
+;                                          C-ISR + _c2p2z_Update    this file
+;    DAC time stamp, interrupt flag                 2                   2
+;    DSRPAG/RCOUNT save, const page, argument       -                   5
+;    call/return of vout_isr_complete()             -                   2
+;    DSRPAG/RCOUNT restore                          -                   2
+;    ISR epilogue (DSRPAG, stack frame)             4                   0
+;
+;  All figures are estimates. They have not been measured on the device yet; the profiler
+;  channels below provide the measurement.
+;
+;  The compensator writes its output into line_feedforward.ctrl_out or DAC_VREF_REGISTER,
+;  depending on USE_LINE_FEEDFORWARD (see pwr_control.c). This routine writes the DAC register
+;  after the compensator with the output multiplied by the feed-forward gain, which is read
+;  from the first word of line_feedforward (Q12). When USE_LINE_FEEDFORWARD is disabled, the
+;  gain remains at unity and the DAC register is written twice with the same value.
+;
+;  The prologue of the C-ISR depends on the compiler optimization level. Both variants
+;  record the time from ISR entry to the DAC update in profiler channel PROF_VOUT_LATENCY
+;  and the complete ISR execution time in PROF_VOUT_ISR (in instruction cycles), which
+;  allows a direct on-target comparison by toggling USE_ALT_WREG_ISR.
+;
+;  The vector symbol is declared weak: when USE_ALT_WREG_ISR is disabled, the C-ISR of
+;  pwr_control.c overrides this routine without any assembler build option. The ADC
+;  channel (AN16) and the controller object (c2p2z) have to match the signal mapping
+;  of globals.h.
+; **********************************************************************************
+
+;------------------------------------------------------------------------------
+;file start
+	.nolist
+	.include "xc.inc"    ; device SFR and bit declarations
+	.include "npnz16b.inc"    ; generic nPnZ control library template
+	.list
+
+;------------------------------------------------------------------------------
+;local inclusions.
+	.section .text    ; place code in the code section
+
+;------------------------------------------------------------------------------
+; Interrupt service routine of ADC input AN16 (output voltage feedback)
+;------------------------------------------------------------------------------
+
+	.weak __ADCAN16Interrupt
+	.global __ADCAN16Interrupt
+__ADCAN16Interrupt:
+	mov CCP1TMRL, w13    ; capture ISR entry time stamp (profiler time base)
+	mov #_c2p2z, w0    ; load address of controller object
+
+;------------------------------------------------------------------------------
+; Activate pending coefficient bank at sample boundary
+	NPNZ16B_COMMIT_COEFFICIENTS VOUT_ISR
+
+;------------------------------------------------------------------------------
+; Read ADC buffer and compute control output (w4)
+	NPNZ16B_UPDATE_CORE VOUT_ISR, 2, boost=USE_TRANSIENT_BOOST, backcalc=USE_SOFT_DESATURATION
+
+;------------------------------------------------------------------------------
+; Input voltage feed-forward: DAC = (control output x gain) >> 12
+	mov _line_feedforward, w5    ; load feed-forward gain (Q12, first word of line_feedforward)
+	mul.uu w4, w5, w2    ; w3:w2 = control output x gain
+	sl w3, #4, w3    ; move upper result bits into place
+	lsr w2, #12, w2    ; move lower result bits into place
+	ior w2, w3, w4    ; combine 16-bit result
+	mov w4, DAC1DATH    ; write peak current reference into DAC register
+
+;------------------------------------------------------------------------------
+; Enable/Disable bypass branch target
+	VOUT_ISR_BYPASS_LOOP:
+	mov CCP1TMRL, w1    ; capture DAC update time stamp
+	bclr IFS6, #ADCAN16IF    ; clear the ADCAN16 interrupt flag
+
+;------------------------------------------------------------------------------
+; Update status and profiler statistics (vout_isr_complete(t_entry, t_dac))
+	push DSRPAG    ; save data space read page of the interrupted context
+	push RCOUNT    ; save REPEAT loop counter of the interrupted context
+	mov #__const_psvpage, w2    ; load page of the const section (auto_psv)
+	mov w2, DSRPAG    ; map const section into the PSV window
+	mov w13, w0    ; pass ISR entry time stamp (t_dac is passed in w1)
+	call _vout_isr_complete
+	pop RCOUNT    ; restore REPEAT loop counter of the interrupted context
+	pop DSRPAG    ; restore data space read page of the interrupted context
+
+;------------------------------------------------------------------------------
+; End of routine (switch back to the interrupted register set)
+	retfie
+
+;------------------------------------------------------------------------------
+; End of file
+	.end
+;------------------------------------------------------------------------------
+